@@ -0,0 +1,592 @@
+// DimacsReader.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "DimacsReader.hpp"
+#include "LineFields.hpp"
+#include "MappedFile.hpp"
+
+
+namespace
+{
+    // how many bytes of a file each task parses, give or take a line
+    const std::size_t bytesPerChunk = 1 << 22;
+
+    // how many arcs or vertices each task converts once everything's
+    // been parsed
+    const int itemsPerBlock = 1 << 16;
+
+
+    // one "a" line: vertex numbers as they appear in the file, and the
+    // arc's weight in the file's units
+    struct DimacsArc
+    {
+        int from;
+        int to;
+        double weight;
+    };
+
+
+    // one "v" line
+    struct DimacsVertex
+    {
+        int vertex;
+        double longitude;
+        double latitude;
+    };
+
+
+    // a whole .gr file
+    struct DimacsGraph
+    {
+        int vertexCount;
+        std::vector<DimacsArc> arcs;
+    };
+
+
+    // runChunks() calls task(chunk) for every chunk from 0 to chunkCount
+    // - 1, on the pool if there is one.
+    template <typename Task>
+    void runChunks(WorkerPool* pool, int chunkCount, Task task)
+    {
+        if (pool != nullptr && chunkCount > 1)
+        {
+            pool->run(
+                chunkCount,
+                [&task](int chunk, int)
+                {
+                    task(chunk);
+                });
+        }
+        else
+        {
+            for (int chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                task(chunk);
+            }
+        }
+    }
+
+
+    int blockCount(std::size_t itemCount)
+    {
+        return (itemCount + itemsPerBlock - 1) / itemsPerBlock;
+    }
+
+
+    // splitIntoChunks() cuts a file into pieces of about bytesPerChunk
+    // bytes, each of which ends at the end of a line.
+    std::vector<std::string_view> splitIntoChunks(const MappedFile& file)
+    {
+        std::vector<std::string_view> chunks;
+
+        const char* begin = file.data();
+        const char* end = begin + file.size();
+
+        while (begin < end)
+        {
+            const char* cut = static_cast<std::size_t>(end - begin) > bytesPerChunk ? begin + bytesPerChunk : end;
+            cut = std::find(cut, end, '\n');
+
+            if (cut != end)
+            {
+                ++cut;
+            }
+
+            chunks.emplace_back(begin, cut - begin);
+            begin = cut;
+        }
+
+        return chunks;
+    }
+
+
+    // nextLine() takes the first line off the front of text, returning
+    // false if there are none left.
+    bool nextLine(std::string_view& text, std::string_view& line)
+    {
+        if (text.empty())
+        {
+            return false;
+        }
+
+        std::string_view::size_type newline = text.find('\n');
+
+        if (newline == std::string_view::npos)
+        {
+            line = text;
+            text = std::string_view{};
+        }
+        else
+        {
+            line = text.substr(0, newline);
+            text.remove_prefix(newline + 1);
+        }
+
+        return true;
+    }
+
+
+    [[noreturn]] void badLine(const std::string& path, std::string_view line)
+    {
+        throw DigraphException{"Not a valid DIMACS line in " + path + ": " + std::string{line}};
+    }
+
+
+    // parseChunks() parses every line of a file, in parallel, returning the
+    // items parsed from each chunk, in order.  parseItem(kind, fields,
+    // item) parses the rest of a line that starts with the given kind,
+    // other than a comment or problem line, into item, returning false if
+    // the line isn't valid.
+    // The file's one problem line is handed back through problemLine.
+    template <typename Item, typename ParseItem>
+    std::vector<std::vector<Item>> parseChunks(
+        WorkerPool* pool, const MappedFile& file, const std::string& path,
+        std::string_view& problemLine, ParseItem parseItem)
+    {
+        std::vector<std::string_view> chunks = splitIntoChunks(file);
+        std::vector<std::vector<Item>> items(chunks.size());
+        std::vector<std::vector<std::string_view>> problemLines(chunks.size());
+
+        runChunks(
+            pool, chunks.size(),
+            [&](int chunk)
+            {
+                std::string_view text = chunks[chunk];
+                std::string_view line;
+
+                while (nextLine(text, line))
+                {
+                    LineFields fields{line};
+                    std::string_view kind;
+
+                    // blank lines and comments
+                    if (!fields.read(kind) || kind.front() == 'c')
+                    {
+                        continue;
+                    }
+
+                    if (kind == "p")
+                    {
+                        problemLines[chunk].push_back(line);
+                        continue;
+                    }
+
+                    Item item;
+
+                    if (!parseItem(kind, fields, item) || !fields.atEnd())
+                    {
+                        badLine(path, line);
+                    }
+
+                    items[chunk].push_back(item);
+                }
+            });
+
+        int problemLineCount = 0;
+
+        for (const std::vector<std::string_view>& lines : problemLines)
+        {
+            for (std::string_view line : lines)
+            {
+                problemLine = line;
+                ++problemLineCount;
+            }
+        }
+
+        if (problemLineCount != 1)
+        {
+            throw DigraphException{"A DIMACS file needs exactly one problem line: " + path};
+        }
+
+        return items;
+    }
+
+
+    // readGraph() reads a .gr file, checking that its arcs agree with its
+    // problem line.
+    DimacsGraph readGraph(WorkerPool* pool, const std::string& path)
+    {
+        MappedFile file{path};
+        std::string_view problemLine;
+
+        std::vector<std::vector<DimacsArc>> chunkArcs = parseChunks<DimacsArc>(
+            pool, file, path, problemLine,
+            [](std::string_view kind, LineFields& fields, DimacsArc& arc)
+            {
+                return kind == "a"
+                    && fields.read(arc.from) && fields.read(arc.to) && fields.read(arc.weight)
+                    && arc.weight >= 0.0;
+            });
+
+        LineFields problem{problemLine};
+        std::string_view p;
+        std::string_view sp;
+        int vertexCount;
+        int arcCount;
+
+        if (!problem.read(p) || !problem.read(sp) || sp != "sp"
+            || !problem.read(vertexCount) || !problem.read(arcCount) || !problem.atEnd()
+            || vertexCount < 0 || arcCount < 0)
+        {
+            badLine(path, problemLine);
+        }
+
+        // each chunk's arcs go where they belong in one big list
+        std::vector<std::size_t> starts(chunkArcs.size() + 1, 0);
+
+        for (std::size_t chunk = 0; chunk < chunkArcs.size(); ++chunk)
+        {
+            starts[chunk + 1] = starts[chunk] + chunkArcs[chunk].size();
+        }
+
+        if (starts.back() != static_cast<std::size_t>(arcCount))
+        {
+            throw DigraphException{"The number of arcs doesn't match the problem line: " + path};
+        }
+
+        DimacsGraph graph{vertexCount, std::vector<DimacsArc>(arcCount)};
+
+        runChunks(
+            pool, chunkArcs.size(),
+            [&](int chunk)
+            {
+                std::size_t next = starts[chunk];
+
+                for (const DimacsArc& arc : chunkArcs[chunk])
+                {
+                    if (arc.from < 1 || arc.from > vertexCount || arc.to < 1 || arc.to > vertexCount)
+                    {
+                        throw DigraphException{
+                            "Arc " + std::to_string(arc.from) + " -> " + std::to_string(arc.to)
+                            + " has a vertex that doesn't exist: " + path};
+                    }
+
+                    graph.arcs[next++] = arc;
+                }
+
+                chunkArcs[chunk] = std::vector<DimacsArc>{};
+            });
+
+        return graph;
+    }
+
+
+    // readCoordinates() reads a .co file, returning each vertex's
+    // coordinates in the file's units, where vertex v is at v - 1.
+    std::vector<DimacsVertex> readCoordinates(WorkerPool* pool, const std::string& path, int vertexCount)
+    {
+        MappedFile file{path};
+        std::string_view problemLine;
+
+        std::vector<std::vector<DimacsVertex>> chunkVertices = parseChunks<DimacsVertex>(
+            pool, file, path, problemLine,
+            [](std::string_view kind, LineFields& fields, DimacsVertex& vertex)
+            {
+                return kind == "v"
+                    && fields.read(vertex.vertex) && fields.read(vertex.longitude) && fields.read(vertex.latitude);
+            });
+
+        LineFields problem{problemLine};
+        std::string_view words[4];
+        int count;
+
+        if (!problem.read(words[0]) || !problem.read(words[1]) || !problem.read(words[2]) || !problem.read(words[3])
+            || words[1] != "aux" || words[2] != "sp" || words[3] != "co"
+            || !problem.read(count) || !problem.atEnd())
+        {
+            badLine(path, problemLine);
+        }
+
+        if (count != vertexCount)
+        {
+            throw DigraphException{"The coordinates are for a different graph: " + path};
+        }
+
+        std::vector<DimacsVertex> vertices(vertexCount, DimacsVertex{0, 0.0, 0.0});
+        int listed = 0;
+
+        for (const std::vector<DimacsVertex>& chunk : chunkVertices)
+        {
+            for (const DimacsVertex& vertex : chunk)
+            {
+                if (vertex.vertex < 1 || vertex.vertex > vertexCount || vertices[vertex.vertex - 1].vertex != 0)
+                {
+                    throw DigraphException{
+                        "Vertex " + std::to_string(vertex.vertex) + " is out of range or listed twice: " + path};
+                }
+
+                vertices[vertex.vertex - 1] = vertex;
+                ++listed;
+            }
+        }
+
+        if (listed != vertexCount)
+        {
+            throw DigraphException{"Some vertices have no coordinates: " + path};
+        }
+
+        return vertices;
+    }
+}
+
+
+DimacsReader::DimacsReader()
+    : pool_{nullptr}, units_{}
+{
+}
+
+
+DimacsReader::DimacsReader(WorkerPool& pool, DimacsUnits units)
+    : pool_{&pool}, units_{units}
+{
+}
+
+
+CompactRoadMap DimacsReader::readRoadMap(
+    const std::string& distancePath,
+    const std::string& timePath,
+    const std::string& coordinatePath)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    DimacsGraph graph = readGraph(pool_, distancePath);
+    int vertexCount = graph.vertexCount;
+    int arcCount = graph.arcs.size();
+    int arcBlocks = blockCount(arcCount);
+
+    // lengths and speeds, arc by arc in the order they were listed
+    std::vector<RoadSegment> segments(arcCount);
+
+    if (timePath.empty())
+    {
+        runChunks(
+            pool_, arcBlocks,
+            [&](int block)
+            {
+                int last = std::min(arcCount, (block + 1) * itemsPerBlock);
+
+                for (int a = block * itemsPerBlock; a < last; ++a)
+                {
+                    segments[a] = RoadSegment{graph.arcs[a].weight / units_.lengthUnitsPerMile, units_.milesPerHour};
+                }
+            });
+    }
+    else
+    {
+        DimacsGraph times = readGraph(pool_, timePath);
+
+        if (times.vertexCount != vertexCount || static_cast<int>(times.arcs.size()) != arcCount)
+        {
+            throw DigraphException{"The travel times are for a different graph: " + timePath};
+        }
+
+        runChunks(
+            pool_, arcBlocks,
+            [&](int block)
+            {
+                int last = std::min(arcCount, (block + 1) * itemsPerBlock);
+
+                for (int a = block * itemsPerBlock; a < last; ++a)
+                {
+                    const DimacsArc& arc = graph.arcs[a];
+                    const DimacsArc& time = times.arcs[a];
+
+                    if (arc.from != time.from || arc.to != time.to)
+                    {
+                        throw DigraphException{"The travel times are for a different graph: " + timePath};
+                    }
+
+                    double miles = arc.weight / units_.lengthUnitsPerMile;
+                    double hours = time.weight / units_.timeUnitsPerHour;
+
+                    // with no length there's no way to take any time, so
+                    // such roads are driven instantly
+                    segments[a] = RoadSegment{miles, miles > 0.0 && hours > 0.0 ? miles / hours : infinity};
+                }
+            });
+    }
+
+    int vertexBlocks = blockCount(vertexCount);
+    std::vector<Location> locations(vertexCount);
+
+    runChunks(
+        pool_, vertexBlocks,
+        [&](int block)
+        {
+            int last = std::min(vertexCount, (block + 1) * itemsPerBlock);
+
+            for (int i = block * itemsPerBlock; i < last; ++i)
+            {
+                locations[i].name = std::to_string(i + 1);
+            }
+        });
+
+    if (!coordinatePath.empty())
+    {
+        std::vector<DimacsVertex> vertices = readCoordinates(pool_, coordinatePath, vertexCount);
+
+        runChunks(
+            pool_, vertexBlocks,
+            [&](int block)
+            {
+                int last = std::min(vertexCount, (block + 1) * itemsPerBlock);
+
+                for (int i = block * itemsPerBlock; i < last; ++i)
+                {
+                    locations[i].hasCoordinates = true;
+                    locations[i].longitude = vertices[i].longitude / units_.coordinateUnitsPerDegree;
+                    locations[i].latitude = vertices[i].latitude / units_.coordinateUnitsPerDegree;
+                }
+            });
+
+        // a road shorter than the straight line between its ends by more
+        // than rounding would make A* miss shorter routes
+        double rounding = 1.0 / units_.lengthUnitsPerMile;
+        std::atomic<bool> consistent{true};
+
+        runChunks(
+            pool_, arcBlocks,
+            [&](int block)
+            {
+                int last = std::min(arcCount, (block + 1) * itemsPerBlock);
+
+                for (int a = block * itemsPerBlock; a < last; ++a)
+                {
+                    RoadSegment& segment = segments[a];
+                    double straight = greatCircleMiles(
+                        locations[graph.arcs[a].from - 1], locations[graph.arcs[a].to - 1]);
+
+                    if (segment.miles >= straight)
+                    {
+                        continue;
+                    }
+                    else if (straight - segment.miles > rounding)
+                    {
+                        consistent = false;
+                    }
+                    else
+                    {
+                        // the same time, over the longer distance
+                        double hours = segment.miles / segment.milesPerHour;
+                        segment.milesPerHour = hours > 0.0 ? straight / hours : infinity;
+                        segment.miles = straight;
+                    }
+                }
+            });
+
+        if (!consistent)
+        {
+            for (Location& location : locations)
+            {
+                location.hasCoordinates = false;
+                location.latitude = 0.0;
+                location.longitude = 0.0;
+            }
+        }
+    }
+
+    // counting sort by the vertex each arc leaves
+    std::vector<int> offsets(vertexCount + 1, 0);
+
+    for (const DimacsArc& arc : graph.arcs)
+    {
+        ++offsets[arc.from];
+    }
+
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<int> order(arcCount);
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+
+    for (int a = 0; a < arcCount; ++a)
+    {
+        order[next[graph.arcs[a].from - 1]++] = a;
+    }
+
+    // then each vertex's arcs by where they lead, keeping only the
+    // shortest (and, among those, the first listed) of any that lead to
+    // the same place; they're packed at the front of the vertex's range
+    std::vector<int> kept(vertexCount);
+
+    runChunks(
+        pool_, vertexBlocks,
+        [&](int block)
+        {
+            int last = std::min(vertexCount, (block + 1) * itemsPerBlock);
+
+            for (int i = block * itemsPerBlock; i < last; ++i)
+            {
+                std::vector<int>::iterator begin = order.begin() + offsets[i];
+                std::vector<int>::iterator end = order.begin() + offsets[i + 1];
+
+                std::sort(
+                    begin, end,
+                    [&](int a, int b)
+                    {
+                        return std::make_tuple(graph.arcs[a].to, segments[a].miles, a)
+                            < std::make_tuple(graph.arcs[b].to, segments[b].miles, b);
+                    });
+
+                end = std::unique(
+                    begin, end,
+                    [&](int a, int b)
+                    {
+                        return graph.arcs[a].to == graph.arcs[b].to;
+                    });
+
+                kept[i] = end - begin;
+            }
+        });
+
+    std::vector<int> keptOffsets(vertexCount + 1, 0);
+
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        keptOffsets[i + 1] = keptOffsets[i] + kept[i];
+    }
+
+    std::vector<int> targets(keptOffsets.back());
+    std::vector<RoadSegment> edgeInfos(keptOffsets.back());
+
+    runChunks(
+        pool_, vertexBlocks,
+        [&](int block)
+        {
+            int last = std::min(vertexCount, (block + 1) * itemsPerBlock);
+
+            for (int i = block * itemsPerBlock; i < last; ++i)
+            {
+                for (int k = 0; k < kept[i]; ++k)
+                {
+                    int a = order[offsets[i] + k];
+                    targets[keptOffsets[i] + k] = graph.arcs[a].to - 1;
+                    edgeInfos[keptOffsets[i] + k] = segments[a];
+                }
+            }
+        });
+
+    std::vector<int> vertexNumbers(vertexCount);
+
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        vertexNumbers[i] = i + 1;
+    }
+
+    return CompactRoadMap::fromArrays(
+        std::move(vertexNumbers), std::move(locations),
+        std::move(keptOffsets), std::move(targets), std::move(edgeInfos));
+}
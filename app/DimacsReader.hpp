@@ -0,0 +1,98 @@
+// DimacsReader.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// The DimacsReader class imports the road networks published for the 9th
+// DIMACS Implementation Challenge (such as USA-road-d.NY.gr), so that
+// routes can be found on real road networks of up to tens of millions of
+// locations.  A network comes in as many as three files:
+//
+// * a distance graph (.gr), whose arcs are weighed by length:
+//
+//       c comments, which are ignored
+//       p sp <vertex count> <arc count>
+//       a <from> <to> <length>
+//
+// * optionally, a travel time graph (.gr) with exactly the same arcs, in
+//   the same order, weighed by how long each one takes to drive;
+// * optionally, a coordinate file (.co), giving each vertex's longitude
+//   and latitude in millionths of a degree:
+//
+//       p aux sp co <vertex count>
+//       v <vertex> <longitude> <latitude>
+//
+// Each DIMACS vertex becomes a location with the same vertex number
+// (they start at 1), named by its number.  Each arc's length becomes its
+// RoadSegment's miles, and its travel time becomes the milesPerHour that
+// covers that distance in that time; with no travel time graph, every
+// road is given DimacsUnits::milesPerHour.  An arc with no length takes no
+// time.  The files list some roads more than once, in which case the
+// shortest is kept.
+//
+// Coordinates are kept only if they agree with the distances, since A*
+// relies on no road being shorter than the straight line between its
+// ends.  Arcs that fall short of it by less than one unit of length,
+// which is only rounding, are lengthened to match; if any falls short by
+// more than that, the coordinates are dropped.
+//
+// The files are mapped into memory, not read, and are parsed on all of a
+// WorkerPool's workers at once.  The result is a CompactRoadMap, built
+// directly from its arrays, because a RoadMap on that scale would take
+// far more memory and far longer to build than the snapshot of it that's
+// then actually used.
+
+#ifndef DIMACSREADER_HPP
+#define DIMACSREADER_HPP
+
+#include <string>
+#include "RoadMap.hpp"
+#include "WorkerPool.hpp"
+
+
+
+// DimacsUnits says how the numbers in DIMACS files are converted to the
+// units a RoadMap uses.  The defaults suit files whose lengths are in
+// meters and whose travel times are in tenths of a second.
+
+struct DimacsUnits
+{
+    double lengthUnitsPerMile = 1609.344;
+    double timeUnitsPerHour = 36000.0;
+    double coordinateUnitsPerDegree = 1000000.0;
+
+    // the speed of every road when there's no travel time graph
+    double milesPerHour = 30.0;
+};
+
+
+
+class DimacsReader
+{
+public:
+    // Initializes a DimacsReader that parses everything on the calling
+    // thread, using the default units.
+    DimacsReader();
+
+    // Initializes a DimacsReader that parses using the given pool, which
+    // must outlive it, and the given units.
+    explicit DimacsReader(WorkerPool& pool, DimacsUnits units = DimacsUnits{});
+
+    // readRoadMap() imports the network in the given files.  The travel
+    // time and coordinate paths may be empty, in which case there is no
+    // such file.  If a file can't be mapped, a MappedFileException is
+    // thrown; if the files aren't well-formed or don't agree with one
+    // another, a DigraphException is thrown.
+    CompactRoadMap readRoadMap(
+        const std::string& distancePath,
+        const std::string& timePath = "",
+        const std::string& coordinatePath = "");
+
+private:
+    WorkerPool* pool_;
+    DimacsUnits units_;
+};
+
+
+
+#endif // DIMACSREADER_HPP
@@ -3,44 +3,88 @@
 // ICS 46 Winter 2019
 // Project #4: Rock and Roll Stops the Traffic
 
+#include <algorithm>
+#include <cstring>
+#include <streambuf>
+#include <string>
+#include <utility>
 #include "InputReader.hpp"
 
 
 namespace
 {
-    void trimRight(std::string& s)
-    {
-        if (s.size() == 0)
-        {
-            return;
-        }
+    // how much of the stream is read at once
+    const std::size_t blockSize = 1 << 20;
 
-        std::string::iterator i = s.end() - 1;
-
-        while (i >= s.begin() && std::isspace(*i))
-        {
-            --i;
-        }
 
-        s.erase(i + 1, s.end());
+    // the same characters std::isspace() treats as whitespace
+    bool isSpace(char c)
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
     }
 }
 
 
+InputReader::InputReader(std::istream& in)
+    : in_{in}, begin_{0}, end_{0}, mark_{0}, exhausted_{false}
+{
+}
+
+
 std::string InputReader::readLine()
 {
-    std::string line;
+    return std::string{readLineView()};
+}
 
-    while (true)
+
+std::string_view InputReader::readLineView()
+{
+    mark_ = begin_;
+
+    std::size_t start;
+    std::size_t length;
+
+    if (!nextLine(start, length))
     {
-        std::getline(in_, line);
-        trimRight(line);
+        return std::string_view{};
+    }
+
+    return std::string_view{buffer_.data() + mark_ + start, length};
+}
 
-        if (line.length() > 0 && line[0] != '#')
+
+std::vector<std::string_view> InputReader::readLineViews(int count)
+{
+    mark_ = begin_;
+
+    // the lines are found first and turned into views afterward, since
+    // the buffer may move while they're being found
+    std::vector<std::pair<std::size_t, std::size_t>> lines;
+    lines.reserve(count);
+
+    std::size_t start;
+    std::size_t length;
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (!nextLine(start, length))
         {
-            return line;
+            start = 0;
+            length = 0;
         }
+
+        lines.emplace_back(start, length);
+    }
+
+    std::vector<std::string_view> views;
+    views.reserve(count);
+
+    for (const auto& line : lines)
+    {
+        views.emplace_back(buffer_.data() + mark_ + line.first, line.second);
     }
+
+    return views;
 }
 
 
@@ -51,3 +95,109 @@ int InputReader::readIntLine()
 }
 
 
+bool InputReader::nextLine(std::size_t& start, std::size_t& length)
+{
+    while (true)
+    {
+        const char* data = buffer_.data();
+        const void* newline = begin_ < end_ ? std::memchr(data + begin_, '\n', end_ - begin_) : nullptr;
+
+        std::size_t lineBegin = begin_;
+        std::size_t lineEnd;
+
+        if (newline != nullptr)
+        {
+            lineEnd = static_cast<const char*>(newline) - data;
+            begin_ = lineEnd + 1;
+        }
+        else if (!exhausted_)
+        {
+            refill();
+            continue;
+        }
+        else if (begin_ < end_)
+        {
+            // the last line doesn't have to end with a newline
+            lineEnd = end_;
+            begin_ = end_;
+        }
+        else
+        {
+            return false;
+        }
+
+        while (lineEnd > lineBegin && isSpace(data[lineEnd - 1]))
+        {
+            --lineEnd;
+        }
+
+        if (lineEnd > lineBegin && data[lineBegin] != '#')
+        {
+            start = lineBegin - mark_;
+            length = lineEnd - lineBegin;
+            return true;
+        }
+    }
+}
+
+
+bool InputReader::refill()
+{
+    std::size_t kept = end_ - mark_;
+
+    if (mark_ > 0)
+    {
+        std::memmove(buffer_.data(), buffer_.data() + mark_, kept);
+        begin_ -= mark_;
+        end_ = kept;
+        mark_ = 0;
+    }
+
+    if (buffer_.size() - end_ < blockSize)
+    {
+        buffer_.resize(end_ + blockSize);
+    }
+
+    // whatever is already waiting is taken all at once, but nothing more
+    // is waited for than the rest of one line, so that lines arriving
+    // through a pipe are seen as soon as they're complete
+    std::streambuf* source = in_.rdbuf();
+    char* space = buffer_.data() + end_;
+    std::size_t room = buffer_.size() - end_;
+    std::size_t got = 0;
+
+    if (source->sgetc() != std::char_traits<char>::eof())
+    {
+        std::streamsize waiting = source->in_avail();
+
+        if (waiting > 0)
+        {
+            got = source->sgetn(space, std::min<std::size_t>(waiting, room));
+        }
+        else
+        {
+            // the stream can't say how much is waiting, so it's read the
+            // way std::getline() would read it
+            int c;
+
+            while (got < room && (c = source->sbumpc()) != std::char_traits<char>::eof())
+            {
+                space[got++] = c;
+
+                if (c == '\n')
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    end_ += got;
+
+    if (got == 0)
+    {
+        exhausted_ = true;
+    }
+
+    return got > 0;
+}
@@ -7,12 +7,22 @@
 // lines of text from it, skipping lines that are not a meaningful part of
 // the input.  In this project, that means blank lines, lines containing
 // only spaces, and lines that begin with a '#' character.
+//
+// The stream is read in large blocks, which are split into lines in place,
+// so reading a line costs little more than finding where it ends.  Only
+// what the stream already has waiting is read ahead, so lines arriving
+// through a pipe can be read as soon as they arrive.  Since an InputReader
+// does read ahead, nothing else should read from its stream once it's been
+// used.
 
 #ifndef INPUTREADER_HPP
 #define INPUTREADER_HPP
 
+#include <cstddef>
 #include <istream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 
 
@@ -22,12 +32,23 @@ public:
     // Initializes an InputReader so that it reads from the given input
     // stream.  For example, pass std::cin as a parameter to the constructor
     // if you want to read input from std::cin.
-    InputReader(std::istream& in): in_{in} { }
+    InputReader(std::istream& in);
 
     // readLine() reads a line of input from the input stream associated
-    // with this InputReader, skipping non-meaningful lines.
+    // with this InputReader, skipping non-meaningful lines.  Trailing
+    // whitespace is dropped.  Once the input runs out, an empty line is
+    // returned.
     std::string readLine();
 
+    // readLineView() is the same as readLine(), except that it returns a
+    // view of the line where it sits in the InputReader's buffer, which is
+    // only good until the next line is read.
+    std::string_view readLineView();
+
+    // readLineViews() reads the next count meaningful lines all at once.
+    // All of the views are good until the next line is read.
+    std::vector<std::string_view> readLineViews(int count);
+
     // readLineInt() reads a line of input from the input stream associated
     // with this InputReader, assuming that the line of input contains an
     // integer value (e.g., "7").
@@ -35,9 +56,28 @@ public:
 
 private:
     std::istream& in_;
+
+    // buffer_[begin_] .. buffer_[end_ - 1] has been read from the stream
+    // but not yet split into lines; everything from buffer_[mark_] on has
+    // to be kept when the buffer is refilled
+    std::vector<char> buffer_;
+    std::size_t begin_;
+    std::size_t end_;
+    std::size_t mark_;
+    bool exhausted_;
+
+    // nextLine() finds the next meaningful line, setting start and length
+    // to where it lies relative to buffer_[mark_].  It returns false once
+    // the input has run out.
+    bool nextLine(std::size_t& start, std::size_t& length);
+
+    // refill() moves what has to be kept to the front of the buffer,
+    // growing it if that doesn't leave room, then reads at least one more
+    // byte, unless the stream has ended.  It returns false if nothing more
+    // could be read.
+    bool refill();
 };
 
 
 
 #endif // INPUTREADER_HPP
-
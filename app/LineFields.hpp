@@ -0,0 +1,157 @@
+// LineFields.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// LineFields reads whitespace-separated fields from one line of input,
+// the way a std::istringstream and its operator>> would, but without
+// copying the line, without consulting a locale, and without any of a
+// stream's other overhead.  Numbers are parsed with std::from_chars.
+
+#ifndef LINEFIELDS_HPP
+#define LINEFIELDS_HPP
+
+#include <charconv>
+#include <string_view>
+#include <system_error>
+
+
+
+class LineFields
+{
+public:
+    // Initializes a LineFields that reads from the given line, which must
+    // outlive it.
+    explicit LineFields(std::string_view line);
+
+    // Each read() skips any whitespace and then reads one field into
+    // value, returning true if it did.  If the field is missing or isn't
+    // the right kind of field, the numeric versions set value to 0 and
+    // return false, and from then on every read() fails, just as with a
+    // stream.  A word is everything up to the next whitespace.
+    bool read(int& value);
+    bool read(double& value);
+    bool read(std::string_view& word);
+
+    // atEnd() returns true if nothing but whitespace is left.
+    bool atEnd();
+
+private:
+    std::string_view rest_;
+    bool failed_;
+
+    // isSpace() returns true for the same characters std::isspace() does
+    // in the "C" locale.
+    static bool isSpace(char c) noexcept;
+
+    // skipSpace() drops whitespace from the front of rest_, then returns
+    // false if there's nothing left to read.
+    bool skipSpace();
+
+    template <typename T>
+    bool readNumber(T& value);
+};
+
+
+
+inline LineFields::LineFields(std::string_view line)
+    : rest_{line}, failed_{false}
+{
+}
+
+
+inline bool LineFields::read(int& value)
+{
+    return readNumber(value);
+}
+
+
+inline bool LineFields::read(double& value)
+{
+    return readNumber(value);
+}
+
+
+inline bool LineFields::read(std::string_view& word)
+{
+    if (failed_ || !skipSpace())
+    {
+        failed_ = true;
+        return false;
+    }
+
+    std::size_t length = 0;
+
+    while (length < rest_.size() && !isSpace(rest_[length]))
+    {
+        ++length;
+    }
+
+    word = rest_.substr(0, length);
+    rest_.remove_prefix(length);
+    return true;
+}
+
+
+inline bool LineFields::atEnd()
+{
+    return !skipSpace();
+}
+
+
+inline bool LineFields::isSpace(char c) noexcept
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+inline bool LineFields::skipSpace()
+{
+    std::size_t skipped = 0;
+
+    while (skipped < rest_.size() && isSpace(rest_[skipped]))
+    {
+        ++skipped;
+    }
+
+    rest_.remove_prefix(skipped);
+    return !rest_.empty();
+}
+
+
+template <typename T>
+bool LineFields::readNumber(T& value)
+{
+    value = 0;
+
+    if (failed_ || !skipSpace())
+    {
+        failed_ = true;
+        return false;
+    }
+
+    // operator>> allows a leading '+', where std::from_chars doesn't
+    const char* first = rest_.data();
+    const char* last = rest_.data() + rest_.size();
+
+    if (*first == '+' && last - first > 1 && *(first + 1) != '-' && *(first + 1) != '+')
+    {
+        ++first;
+    }
+
+    std::from_chars_result result = std::from_chars(first, last, value);
+
+    if (result.ec != std::errc{})
+    {
+        value = 0;
+        failed_ = true;
+        return false;
+    }
+
+    rest_.remove_prefix(result.ptr - rest_.data());
+    return true;
+}
+
+
+
+#endif // LINEFIELDS_HPP
@@ -0,0 +1,29 @@
+// Location.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include <cmath>
+#include "Location.hpp"
+
+
+namespace
+{
+    const double earthRadiusMiles = 3958.8;
+    const double radiansPerDegree = 3.14159265358979323846 / 180.0;
+}
+
+
+double greatCircleMiles(const Location& a, const Location& b)
+{
+    // the haversine formula, which stays accurate for short distances
+    double lat1 = a.latitude * radiansPerDegree;
+    double lat2 = b.latitude * radiansPerDegree;
+    double dLat = lat2 - lat1;
+    double dLon = (b.longitude - a.longitude) * radiansPerDegree;
+
+    double h = std::sin(dLat / 2) * std::sin(dLat / 2)
+        + std::cos(lat1) * std::cos(lat2) * std::sin(dLon / 2) * std::sin(dLon / 2);
+
+    return 2.0 * earthRadiusMiles * std::asin(std::sqrt(std::fmin(1.0, h)));
+}
@@ -0,0 +1,45 @@
+// Location.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// A Location structure describes the information we know about a location
+// on a RoadMap: its name and, optionally, where it is on the globe (its
+// latitude and longitude, in degrees).  Writing a Location to an output
+// stream writes only its name, since that's how locations are shown to
+// users.
+
+#ifndef LOCATION_HPP
+#define LOCATION_HPP
+
+#include <ostream>
+#include <string>
+
+
+
+struct Location
+{
+    std::string name;
+    bool hasCoordinates = false;
+    double latitude = 0.0;
+    double longitude = 0.0;
+};
+
+
+
+inline std::ostream& operator<<(std::ostream& out, const Location& location)
+{
+    return out << location.name;
+}
+
+
+
+// greatCircleMiles() returns the distance, in miles, between two locations
+// along the surface of the Earth.  Both locations must have coordinates.
+// No road between two locations can be shorter than this.
+
+double greatCircleMiles(const Location& a, const Location& b);
+
+
+
+#endif // LOCATION_HPP
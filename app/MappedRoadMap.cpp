@@ -0,0 +1,224 @@
+// MappedRoadMap.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "MappedRoadMap.hpp"
+#include "TripWeights.hpp"
+
+
+MappedRoadMap::MappedRoadMap(const std::string& path)
+    : file_{path}
+{
+    header_ = reinterpret_cast<const RoadMapImageHeader*>(file_.data());
+
+    if (file_.size() < sizeof(RoadMapImageHeader)
+        || !std::equal(
+            std::begin(RoadMapImageFormat::magic), std::end(RoadMapImageFormat::magic), header_->magic)
+        || header_->version != RoadMapImageFormat::version
+        || header_->byteOrder != RoadMapImageFormat::byteOrder)
+    {
+        throw DigraphException("Not a road map image");
+    }
+
+    const std::uint64_t limit = std::numeric_limits<std::int32_t>::max();
+
+    if (header_->fileSize != file_.size()
+        || header_->vertexCount >= limit || header_->edgeCount > limit)
+    {
+        throw DigraphException("Road map image is truncated");
+    }
+
+    std::uint64_t n = header_->vertexCount;
+    std::uint64_t m = header_->edgeCount;
+
+    vertexNumbers_ = section<std::int32_t>(header_->vertexNumbers, n);
+    vertices_ = section<RoadMapImageVertex>(header_->vertices, n);
+    offsets_ = section<std::int32_t>(header_->offsets, n + 1);
+    targets_ = section<std::int32_t>(header_->targets, m);
+    segments_ = section<RoadSegment>(header_->segments, m);
+    reverseOffsets_ = section<std::int32_t>(header_->reverseOffsets, n + 1);
+    reverseSources_ = section<std::int32_t>(header_->reverseSources, m);
+    reverseEdges_ = section<std::int32_t>(header_->reverseEdges, m);
+    names_ = section<char>(header_->names, header_->nameBytes);
+
+    // the rest is trusted to be as the writer left it, since checking
+    // every entry would mean reading the whole file
+    if (offsets_[0] != 0 || static_cast<std::uint64_t>(offsets_[n]) != m
+        || reverseOffsets_[0] != 0 || static_cast<std::uint64_t>(reverseOffsets_[n]) != m)
+    {
+        throw DigraphException("Road map image is truncated");
+    }
+}
+
+
+int MappedRoadMap::vertexCount() const noexcept
+{
+    return header_->vertexCount;
+}
+
+
+int MappedRoadMap::edgeCount() const noexcept
+{
+    return header_->edgeCount;
+}
+
+
+int MappedRoadMap::indexOf(int vertex) const
+{
+    const std::int32_t* end = vertexNumbers_ + vertexCount();
+    const std::int32_t* found = std::lower_bound(vertexNumbers_, end, vertex);
+
+    if (found == end || *found != vertex)
+    {
+        throw DigraphException("No vertex with that number exists");
+    }
+
+    return found - vertexNumbers_;
+}
+
+
+int MappedRoadMap::vertexNumber(int index) const noexcept
+{
+    return vertexNumbers_[index];
+}
+
+
+std::string_view MappedRoadMap::nameAt(int index) const noexcept
+{
+    const RoadMapImageVertex& vertex = vertices_[index];
+    return std::string_view{names_ + vertex.nameOffset, vertex.nameLength};
+}
+
+
+Location MappedRoadMap::locationAt(int index) const
+{
+    const RoadMapImageVertex& vertex = vertices_[index];
+
+    return Location{
+        std::string{nameAt(index)},
+        vertex.hasCoordinates != 0,
+        vertex.latitude,
+        vertex.longitude};
+}
+
+
+int MappedRoadMap::edgeBegin(int index) const noexcept
+{
+    return offsets_[index];
+}
+
+
+int MappedRoadMap::edgeEnd(int index) const noexcept
+{
+    return offsets_[index + 1];
+}
+
+
+int MappedRoadMap::edgeTarget(int edge) const noexcept
+{
+    return targets_[edge];
+}
+
+
+const RoadSegment& MappedRoadMap::segmentAt(int edge) const noexcept
+{
+    return segments_[edge];
+}
+
+
+ShortestPath MappedRoadMap::findShortestPath(
+    int startVertex, int endVertex, TripMetric metric,
+    BidirectionalSearchSpace& space) const
+{
+    int start = indexOf(startVertex);
+    int end = indexOf(endVertex);
+
+    return withTripWeight(
+        metric,
+        [this, &space, start, end](auto weight)
+        {
+            int meeting = searchShortestPathBidirectional(
+                space, vertexCount(), start, end,
+                [this, weight](int v, auto relax)
+                {
+                    for (int e = offsets_[v]; e < offsets_[v + 1]; ++e)
+                    {
+                        relax(targets_[e], weight(segments_[e]));
+                    }
+                },
+                [this, weight](int w, auto relax)
+                {
+                    for (int slot = reverseOffsets_[w]; slot < reverseOffsets_[w + 1]; ++slot)
+                    {
+                        relax(reverseSources_[slot], weight(segments_[reverseEdges_[slot]]));
+                    }
+                });
+
+            return traceBidirectionalPath(
+                space, meeting,
+                [this, weight](int v, int w)
+                {
+                    return weight(segments_[findEdge(v, w)]);
+                },
+                [this](int index)
+                {
+                    return vertexNumbers_[index];
+                });
+        });
+}
+
+
+CompactRoadMap MappedRoadMap::toCompactRoadMap() const
+{
+    int n = vertexCount();
+    int m = edgeCount();
+
+    std::vector<Location> locations;
+    locations.reserve(n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        locations.push_back(locationAt(i));
+    }
+
+    return CompactRoadMap::fromArrays(
+        std::vector<int>(vertexNumbers_, vertexNumbers_ + n),
+        std::move(locations),
+        std::vector<int>(offsets_, offsets_ + n + 1),
+        std::vector<int>(targets_, targets_ + m),
+        std::vector<RoadSegment>(segments_, segments_ + m));
+}
+
+
+template <typename T>
+const T* MappedRoadMap::section(std::uint64_t position, std::uint64_t count) const
+{
+    if (position % RoadMapImageFormat::alignment != 0
+        || position > file_.size()
+        || count > (file_.size() - position) / sizeof(T))
+    {
+        throw DigraphException("Road map image is truncated");
+    }
+
+    return reinterpret_cast<const T*>(file_.data() + position);
+}
+
+
+int MappedRoadMap::findEdge(int fromIndex, int toIndex) const noexcept
+{
+    const std::int32_t* begin = targets_ + offsets_[fromIndex];
+    const std::int32_t* end = targets_ + offsets_[fromIndex + 1];
+    const std::int32_t* found = std::lower_bound(begin, end, toIndex);
+
+    if (found == end || *found != toIndex)
+    {
+        return -1;
+    }
+
+    return found - targets_;
+}
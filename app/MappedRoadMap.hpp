@@ -0,0 +1,105 @@
+// MappedRoadMap.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// A MappedRoadMap maps a road map image (see RoadMapImage.hpp) into memory
+// and answers questions about it right where it is: nothing is parsed and
+// nothing is copied, so opening even a very large map costs about as much
+// as checking its header, and only the pages a query actually touches are
+// ever read from the file.
+//
+// Location names are handed out as std::string_views into the mapped file,
+// and road segments as references into it, so they're only good for as
+// long as the MappedRoadMap is.
+//
+// Everything else in the program works on a CompactRoadMap, which
+// toCompactRoadMap() builds from the image; that still skips all of the
+// parsing that reading the text format would take.
+
+#ifndef MAPPEDROADMAP_HPP
+#define MAPPEDROADMAP_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "BidirectionalSearch.hpp"
+#include "MappedFile.hpp"
+#include "RoadMap.hpp"
+#include "RoadMapImage.hpp"
+#include "ShortestPathTree.hpp"
+#include "TripMetric.hpp"
+
+
+
+class MappedRoadMap
+{
+public:
+    // Maps the image with the given path.  A MappedFileException is thrown
+    // if it can't be opened, and a DigraphException if it isn't a road map
+    // image that this program can read.
+    explicit MappedRoadMap(const std::string& path);
+
+    // vertexCount() and edgeCount() return the number of locations and
+    // road segments on the map.
+    int vertexCount() const noexcept;
+    int edgeCount() const noexcept;
+
+    // indexOf() returns the dense index of the given vertex number.  If
+    // there's no such vertex, a DigraphException is thrown.
+    int indexOf(int vertex) const;
+
+    // vertexNumber() returns the vertex number belonging to a dense index.
+    int vertexNumber(int index) const noexcept;
+
+    // nameAt() returns the name of the location at a dense index, and
+    // locationAt() returns a copy of the whole Location.
+    std::string_view nameAt(int index) const noexcept;
+    Location locationAt(int index) const;
+
+    // edgeBegin() and edgeEnd() return the half-open range of edge
+    // positions that belong to the vertex at a dense index; edgeTarget()
+    // and segmentAt() describe the edge at a position.
+    int edgeBegin(int index) const noexcept;
+    int edgeEnd(int index) const noexcept;
+    int edgeTarget(int edge) const noexcept;
+    const RoadSegment& segmentAt(int edge) const noexcept;
+
+    // findShortestPath() finds a shortest path between two vertex numbers
+    // under the given metric, searching bidirectionally in the mapped
+    // arrays using the given space.  If either vertex doesn't exist, a
+    // DigraphException is thrown.
+    ShortestPath findShortestPath(
+        int startVertex, int endVertex, TripMetric metric,
+        BidirectionalSearchSpace& space) const;
+
+    // toCompactRoadMap() copies the whole map into a CompactRoadMap.
+    CompactRoadMap toCompactRoadMap() const;
+
+private:
+    MappedFile file_;
+    const RoadMapImageHeader* header_;
+
+    const std::int32_t* vertexNumbers_;
+    const RoadMapImageVertex* vertices_;
+    const std::int32_t* offsets_;
+    const std::int32_t* targets_;
+    const RoadSegment* segments_;
+    const std::int32_t* reverseOffsets_;
+    const std::int32_t* reverseSources_;
+    const std::int32_t* reverseEdges_;
+    const char* names_;
+
+    // section() returns where a section of count items of type T starts,
+    // after checking that it lies entirely within the file.
+    template <typename T>
+    const T* section(std::uint64_t position, std::uint64_t count) const;
+
+    // findEdge() returns the position of the edge between two dense
+    // indices, or -1 if there isn't one.
+    int findEdge(int fromIndex, int toIndex) const noexcept;
+};
+
+
+
+#endif // MAPPEDROADMAP_HPP
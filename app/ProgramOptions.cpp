@@ -0,0 +1,197 @@
+// ProgramOptions.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include "ProgramOptions.hpp"
+#include "SearchStats.hpp"
+
+
+// the default number of landmarks used by --write-landmarks when
+// --landmarks isn't given too
+namespace
+{
+    const int defaultLandmarkCount = 16;
+}
+
+
+// the cell sizes, smallest level first, that --overlay partitions with
+const std::vector<int> ProgramOptions::overlayCellSizes{64, 1024, 16384};
+
+
+// enough to keep every thread busy while a slow trip holds up the output
+const int ProgramOptions::streamWindow = 256;
+
+
+// big enough that writing costs next to nothing per trip
+const std::size_t ProgramOptions::outputBlockSize = 1 << 16;
+
+
+ProgramOptionsException::ProgramOptionsException(const std::string& reason)
+    : std::runtime_error{reason}
+{
+}
+
+
+namespace
+{
+    // reads the value of an option that has to be a positive integer
+    int readPositiveInt(const std::string& value, const std::string& what)
+    {
+        try
+        {
+            std::size_t used = 0;
+            int result = std::stoi(value, &used);
+
+            if (used != value.size() || result <= 0)
+            {
+                throw std::invalid_argument{value};
+            }
+
+            return result;
+        }
+        catch (std::logic_error&)
+        {
+            throw ProgramOptionsException{"Invalid " + what + ": " + value};
+        }
+    }
+
+
+    // reads the value of --output
+    RouteFormat readRouteFormat(const std::string& value)
+    {
+        if (value == "text")
+        {
+            return RouteFormat::Text;
+        }
+        else if (value == "json")
+        {
+            return RouteFormat::JsonLines;
+        }
+        else if (value == "binary")
+        {
+            return RouteFormat::Binary;
+        }
+        else
+        {
+            throw ProgramOptionsException{"Invalid output format: " + value};
+        }
+    }
+}
+
+
+ProgramOptions readProgramOptions(int argc, char** argv)
+{
+    ProgramOptions options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string option = argv[i];
+
+        // options that don't take a value
+        if (option == "--contract")
+        {
+            options.contract = true;
+            continue;
+        }
+        else if (option == "--overlay")
+        {
+            options.overlay = true;
+            continue;
+        }
+        else if (option == "--stream")
+        {
+            options.stream = true;
+            continue;
+        }
+        else if (option == "--stats")
+        {
+            options.stats = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            throw ProgramOptionsException{"Missing value for option: " + option};
+        }
+
+        std::string value = argv[++i];
+
+        if (option == "--landmarks")
+        {
+            options.landmarkCount = readPositiveInt(value, "landmark count");
+        }
+        else if (option == "--threads")
+        {
+            options.threadCount = readPositiveInt(value, "thread count");
+        }
+        else if (option == "--write-landmarks")
+        {
+            options.writeLandmarksPath = value;
+        }
+        else if (option == "--read-landmarks")
+        {
+            options.readLandmarksPath = value;
+        }
+        else if (option == "--write-image")
+        {
+            options.writeImagePath = value;
+        }
+        else if (option == "--read-image")
+        {
+            options.readImagePath = value;
+        }
+        else if (option == "--dimacs")
+        {
+            options.dimacsPath = value;
+        }
+        else if (option == "--dimacs-times")
+        {
+            options.dimacsTimesPath = value;
+        }
+        else if (option == "--dimacs-coordinates")
+        {
+            options.dimacsCoordinatesPath = value;
+        }
+        else if (option == "--output")
+        {
+            options.output = readRouteFormat(value);
+        }
+        else
+        {
+            throw ProgramOptionsException{"Unknown option: " + option};
+        }
+    }
+
+    if (!options.writeLandmarksPath.empty() && !options.readLandmarksPath.empty())
+    {
+        throw ProgramOptionsException{"Cannot both read and write landmarks"};
+    }
+
+    if (!options.writeImagePath.empty() && !options.readImagePath.empty())
+    {
+        throw ProgramOptionsException{"Cannot both read and write an image"};
+    }
+
+    if (!options.dimacsPath.empty() && !options.readImagePath.empty())
+    {
+        throw ProgramOptionsException{"Cannot read both a DIMACS graph and an image"};
+    }
+
+    if (options.dimacsPath.empty() && (!options.dimacsTimesPath.empty() || !options.dimacsCoordinatesPath.empty()))
+    {
+        throw ProgramOptionsException{"DIMACS travel times and coordinates need a DIMACS graph"};
+    }
+
+    if (options.stats && !SearchStats::enabled)
+    {
+        throw ProgramOptionsException{"Search statistics need a build with DIGRAPH_SEARCH_STATS defined"};
+    }
+
+    if (!options.writeLandmarksPath.empty() && options.landmarkCount == 0)
+    {
+        options.landmarkCount = defaultLandmarkCount;
+    }
+
+    return options;
+}
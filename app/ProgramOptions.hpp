@@ -0,0 +1,103 @@
+// ProgramOptions.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// ProgramOptions describes the command-line options the program accepts.
+// With no options at all, the program reads a map and trips from the
+// standard input and prints routes, just as it always has.
+//
+//     --landmarks N           build N landmarks per metric before routing
+//     --write-landmarks FILE  build landmarks, write them to FILE, and stop
+//                             without reading any trips
+//     --read-landmarks FILE   route using landmarks previously written
+//                             with --write-landmarks for the same map
+//     --threads N             route and print trips on N threads at once;
+//                             the output is the same, in the same order
+//     --contract              build contraction hierarchies before routing,
+//                             which takes precedence over landmarks
+//     --overlay               build a partition overlay before routing,
+//                             which takes precedence over landmarks
+//     --write-image FILE      write the map to FILE as a road map image,
+//                             and stop without reading any trips
+//     --read-image FILE       take the map from an image previously
+//                             written with --write-image, in which case
+//                             the standard input holds only the trips
+//     --dimacs FILE           take the map from a 9th DIMACS Challenge
+//                             distance graph (see DimacsReader.hpp), in
+//                             which case the standard input holds only
+//                             the trips
+//     --dimacs-times FILE     with --dimacs, take travel times from the
+//                             matching DIMACS travel time graph
+//     --dimacs-coordinates FILE
+//                             with --dimacs, take coordinates from the
+//                             matching DIMACS coordinate file
+//     --stream                answer each trip as soon as it's read,
+//                             holding only a bounded number of trips at
+//                             a time, for inputs that arrive gradually
+//     --stats                 print statistics about every trip's search
+//                             to the standard error once all the trips
+//                             are done, which needs a build with
+//                             DIGRAPH_SEARCH_STATS defined (see
+//                             SearchStats.hpp)
+//     --output FORMAT         write routes as text (the default), json
+//                             (one JSON object per line), or binary
+//                             (see RouteFormatter.hpp)
+
+#ifndef PROGRAMOPTIONS_HPP
+#define PROGRAMOPTIONS_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "RouteFormat.hpp"
+
+
+
+struct ProgramOptions
+{
+    int landmarkCount = 0;
+    int threadCount = 1;
+    std::string writeLandmarksPath;
+    std::string readLandmarksPath;
+    std::string writeImagePath;
+    std::string readImagePath;
+    std::string dimacsPath;
+    std::string dimacsTimesPath;
+    std::string dimacsCoordinatesPath;
+    bool contract = false;
+    bool overlay = false;
+    bool stream = false;
+    bool stats = false;
+    RouteFormat output = RouteFormat::Text;
+
+    // the most locations a cell can hold on each level of the overlay
+    static const std::vector<int> overlayCellSizes;
+
+    // the most trips --stream holds at once, per thread
+    static const int streamWindow;
+
+    // how many bytes of output are gathered up before they're written
+    static const std::size_t outputBlockSize;
+};
+
+
+
+// A ProgramOptionsException is thrown when the command line can't be
+// understood; its what() explains why.
+
+class ProgramOptionsException : public std::runtime_error
+{
+public:
+    ProgramOptionsException(const std::string& reason);
+};
+
+
+
+// readProgramOptions() interprets the arguments passed to main().
+ProgramOptions readProgramOptions(int argc, char** argv);
+
+
+
+#endif // PROGRAMOPTIONS_HPP
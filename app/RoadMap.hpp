@@ -4,19 +4,23 @@
 // Project #4: Rock and Roll Stops the Traffic
 //
 // This header defines a type RoadMap, which is simply a typedef to a particular
-// instantiation of the Digraph template, where each vertex has a string for its
-// information and each edge has a RoadSegment for its information.
+// instantiation of the Digraph template, where each vertex has a Location for
+// its information and each edge has a RoadSegment for its information.  A
+// CompactRoadMap is the matching read-only snapshot, which is what queries
+// should be run against once a RoadMap has been loaded.
 
 #ifndef ROADMAP_HPP
 #define ROADMAP_HPP
 
-#include <string>
 #include "Digraph.hpp"
+#include "CompactDigraph.hpp"
+#include "Location.hpp"
 #include "RoadSegment.hpp"
 
 
 
-typedef Digraph<std::string, RoadSegment> RoadMap;
+typedef Digraph<Location, RoadSegment> RoadMap;
+typedef CompactDigraph<Location, RoadSegment> CompactRoadMap;
 
 
 
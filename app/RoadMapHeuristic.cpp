@@ -0,0 +1,54 @@
+// RoadMapHeuristic.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include <algorithm>
+#include "RoadMapHeuristic.hpp"
+
+
+RoadMapHeuristic::RoadMapHeuristic(const CompactRoadMap& roadMap)
+    : roadMap_{roadMap}, available_{roadMap.vertexCount() > 0}, maxMilesPerHour_{0.0}
+{
+    for (int i = 0; i < roadMap.vertexCount(); ++i)
+    {
+        available_ = available_ && roadMap.vertexInfoAt(i).hasCoordinates;
+    }
+
+    for (int e = 0; e < roadMap.edgeCount(); ++e)
+    {
+        maxMilesPerHour_ = std::max(maxMilesPerHour_, roadMap.edgeInfoAt(e).milesPerHour);
+    }
+
+    available_ = available_ && maxMilesPerHour_ > 0.0;
+}
+
+
+bool RoadMapHeuristic::available() const noexcept
+{
+    return available_;
+}
+
+
+std::function<double(int)> RoadMapHeuristic::estimateTo(int endVertex, TripMetric metric) const
+{
+    const CompactRoadMap& roadMap = roadMap_;
+    const Location& end = roadMap.vertexInfo(endVertex);
+
+    if (metric == TripMetric::Distance)
+    {
+        return [&roadMap, &end](int index)
+        {
+            return greatCircleMiles(roadMap.vertexInfoAt(index), end);
+        };
+    }
+    else
+    {
+        double milesPerHour = maxMilesPerHour_;
+
+        return [&roadMap, &end, milesPerHour](int index)
+        {
+            return greatCircleMiles(roadMap.vertexInfoAt(index), end) / milesPerHour;
+        };
+    }
+}
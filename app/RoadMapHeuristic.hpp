@@ -0,0 +1,53 @@
+// RoadMapHeuristic.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// A RoadMapHeuristic supplies the estimates that A* searches on a RoadMap
+// use to steer toward the end of a trip.  The estimates come from the
+// locations' coordinates: no road can be shorter than the great-circle
+// distance between its ends, and no road can be driven faster than the
+// fastest road on the map, so
+//
+// * for TripMetric::Distance, the estimate is the great-circle distance
+//   (in miles) to the end of the trip, and
+// * for TripMetric::Time, it's that distance divided by the map's largest
+//   milesPerHour (in hours).
+//
+// This only works when every location on the map has coordinates, and
+// when no road is shorter than the straight line between its ends.
+
+#ifndef ROADMAPHEURISTIC_HPP
+#define ROADMAPHEURISTIC_HPP
+
+#include <functional>
+#include "RoadMap.hpp"
+#include "TripMetric.hpp"
+
+
+
+class RoadMapHeuristic
+{
+public:
+    // Initializes a RoadMapHeuristic for the given map, which must outlive
+    // it.
+    explicit RoadMapHeuristic(const CompactRoadMap& roadMap);
+
+    // available() returns true if every location on the map has
+    // coordinates, so that estimates can be made at all.
+    bool available() const noexcept;
+
+    // estimateTo() returns an estimate function for trips that end at the
+    // given vertex and minimize the given metric, suitable for passing to
+    // CompactRoadMap::findShortestPathAStar().
+    std::function<double(int)> estimateTo(int endVertex, TripMetric metric) const;
+
+private:
+    const CompactRoadMap& roadMap_;
+    bool available_;
+    double maxMilesPerHour_;
+};
+
+
+
+#endif // ROADMAPHEURISTIC_HPP
@@ -0,0 +1,105 @@
+// RoadMapImage.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// A road map image is a binary file holding a CompactRoadMap laid out
+// exactly the way it's used in memory, so that it can be mapped into memory
+// and queried where it is, with no parsing at all (see MappedRoadMap).  It's
+// written by RoadMapImageWriter.
+//
+// The file starts with a RoadMapImageHeader, followed by these sections,
+// each of which starts on a multiple of RoadMapImageFormat::alignment bytes
+// from the beginning of the file:
+//
+// * vertex numbers: vertexCount int32s, ascending
+// * vertices: vertexCount RoadMapImageVertex records, in the same order
+// * offsets: vertexCount + 1 int32s, where the edges of the vertex at index
+//   i are the ones from offsets[i] to offsets[i + 1] - 1
+// * targets: edgeCount int32s, the index each edge points to
+// * segments: edgeCount RoadSegments
+// * reverse offsets, reverse sources, and reverse edges: the incoming edges
+//   of every vertex, laid out the same way as in a CompactDigraph
+// * names: nameBytes bytes of location names, one after another, with no
+//   terminators; each RoadMapImageVertex says where its name is
+//
+// Everything is stored in the byte order of the machine that wrote it,
+// which the header records, so an image can only be read on a machine with
+// the same byte order.
+
+#ifndef ROADMAPIMAGE_HPP
+#define ROADMAPIMAGE_HPP
+
+#include <cstdint>
+#include <type_traits>
+#include "RoadSegment.hpp"
+
+
+
+namespace RoadMapImageFormat
+{
+    // every image starts with these bytes, followed by a version number
+    const char magic[8] = {'R', 'O', 'A', 'D', 'M', 'A', 'P', '\0'};
+    const std::uint32_t version = 1;
+
+    // written as-is, so it reads back differently on a machine with a
+    // different byte order
+    const std::uint32_t byteOrder = 0x01020304;
+
+    // every section starts on a multiple of this many bytes, which is at
+    // least a cache line and divides the size of a page
+    const std::uint64_t alignment = 64;
+}
+
+
+
+struct RoadMapImageHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+
+    std::uint64_t vertexCount;
+    std::uint64_t edgeCount;
+    std::uint64_t nameBytes;
+    std::uint64_t fileSize;
+
+    // where each section starts, in bytes from the beginning of the file
+    std::uint64_t vertexNumbers;
+    std::uint64_t vertices;
+    std::uint64_t offsets;
+    std::uint64_t targets;
+    std::uint64_t segments;
+    std::uint64_t reverseOffsets;
+    std::uint64_t reverseSources;
+    std::uint64_t reverseEdges;
+    std::uint64_t names;
+};
+
+
+
+struct RoadMapImageVertex
+{
+    double latitude;
+    double longitude;
+
+    // the name is nameLength bytes long, starting nameOffset bytes into
+    // the names section
+    std::uint64_t nameOffset;
+    std::uint32_t nameLength;
+
+    // 1 if latitude and longitude mean anything, 0 if not
+    std::uint32_t hasCoordinates;
+};
+
+
+
+// The layouts above are the file format, so they mustn't change by accident.
+static_assert(sizeof(RoadMapImageHeader) == 120, "RoadMapImageHeader has padding");
+static_assert(sizeof(RoadMapImageVertex) == 32, "RoadMapImageVertex has padding");
+static_assert(sizeof(RoadSegment) == 16, "RoadSegment has padding");
+static_assert(std::is_trivially_copyable<RoadSegment>::value, "RoadSegment can't be copied as bytes");
+
+
+
+#endif // ROADMAPIMAGE_HPP
@@ -0,0 +1,143 @@
+// RoadMapImageWriter.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "RoadMapImage.hpp"
+#include "RoadMapImageWriter.hpp"
+
+
+namespace
+{
+    // rounds a file position up to the start of the next section
+    std::uint64_t alignUp(std::uint64_t position)
+    {
+        std::uint64_t a = RoadMapImageFormat::alignment;
+        return (position + a - 1) / a * a;
+    }
+
+
+    // hands out where each section goes, one after another
+    class SectionLayout
+    {
+    public:
+        explicit SectionLayout(std::uint64_t start)
+            : end_{start}
+        {
+        }
+
+        std::uint64_t place(std::uint64_t bytes)
+        {
+            std::uint64_t start = alignUp(end_);
+            end_ = start + bytes;
+            return start;
+        }
+
+        std::uint64_t end() const noexcept
+        {
+            return end_;
+        }
+
+    private:
+        std::uint64_t end_;
+    };
+
+
+    // writes an array at the given position, padding up to it first
+    template <typename T>
+    void writeSection(std::ostream& out, std::uint64_t& written, std::uint64_t position, const std::vector<T>& items)
+    {
+        static const char zeroes[RoadMapImageFormat::alignment] = {};
+
+        out.write(zeroes, position - written);
+        out.write(reinterpret_cast<const char*>(items.data()), items.size() * sizeof(T));
+        written = position + items.size() * sizeof(T);
+    }
+}
+
+
+void RoadMapImageWriter::writeRoadMapImage(std::ostream& out, const CompactRoadMap& roadMap)
+{
+    int vertexCount = roadMap.vertexCount();
+    int edgeCount = roadMap.edgeCount();
+
+    std::vector<std::int32_t> vertexNumbers(vertexCount);
+    std::vector<RoadMapImageVertex> vertices(vertexCount);
+    std::vector<char> names;
+
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        const Location& location = roadMap.vertexInfoAt(i);
+
+        vertexNumbers[i] = roadMap.vertexNumber(i);
+        vertices[i] = RoadMapImageVertex{
+            location.latitude,
+            location.longitude,
+            names.size(),
+            static_cast<std::uint32_t>(location.name.size()),
+            location.hasCoordinates ? 1u : 0u};
+
+        names.insert(names.end(), location.name.begin(), location.name.end());
+    }
+
+    std::vector<std::int32_t> offsets(vertexCount + 1);
+    std::vector<std::int32_t> targets(edgeCount);
+    std::vector<RoadSegment> segments(edgeCount);
+    std::vector<std::int32_t> reverseOffsets(vertexCount + 1);
+    std::vector<std::int32_t> reverseSources(edgeCount);
+    std::vector<std::int32_t> reverseEdges(edgeCount);
+
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        offsets[i] = roadMap.edgeBegin(i);
+        reverseOffsets[i] = roadMap.inEdgeBegin(i);
+    }
+
+    offsets[vertexCount] = edgeCount;
+    reverseOffsets[vertexCount] = edgeCount;
+
+    for (int e = 0; e < edgeCount; ++e)
+    {
+        targets[e] = roadMap.edgeTarget(e);
+        segments[e] = roadMap.edgeInfoAt(e);
+        reverseSources[e] = roadMap.inEdgeSource(e);
+        reverseEdges[e] = roadMap.inEdgePosition(e);
+    }
+
+    RoadMapImageHeader header{};
+    std::copy(std::begin(RoadMapImageFormat::magic), std::end(RoadMapImageFormat::magic), header.magic);
+    header.version = RoadMapImageFormat::version;
+    header.byteOrder = RoadMapImageFormat::byteOrder;
+    header.vertexCount = vertexCount;
+    header.edgeCount = edgeCount;
+    header.nameBytes = names.size();
+
+    SectionLayout layout{sizeof(RoadMapImageHeader)};
+    header.vertexNumbers = layout.place(vertexNumbers.size() * sizeof(std::int32_t));
+    header.vertices = layout.place(vertices.size() * sizeof(RoadMapImageVertex));
+    header.offsets = layout.place(offsets.size() * sizeof(std::int32_t));
+    header.targets = layout.place(targets.size() * sizeof(std::int32_t));
+    header.segments = layout.place(segments.size() * sizeof(RoadSegment));
+    header.reverseOffsets = layout.place(reverseOffsets.size() * sizeof(std::int32_t));
+    header.reverseSources = layout.place(reverseSources.size() * sizeof(std::int32_t));
+    header.reverseEdges = layout.place(reverseEdges.size() * sizeof(std::int32_t));
+    header.names = layout.place(names.size());
+    header.fileSize = layout.end();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::uint64_t written = sizeof(header);
+
+    writeSection(out, written, header.vertexNumbers, vertexNumbers);
+    writeSection(out, written, header.vertices, vertices);
+    writeSection(out, written, header.offsets, offsets);
+    writeSection(out, written, header.targets, targets);
+    writeSection(out, written, header.segments, segments);
+    writeSection(out, written, header.reverseOffsets, reverseOffsets);
+    writeSection(out, written, header.reverseSources, reverseSources);
+    writeSection(out, written, header.reverseEdges, reverseEdges);
+    writeSection(out, written, header.names, names);
+}
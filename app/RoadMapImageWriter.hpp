@@ -0,0 +1,28 @@
+// RoadMapImageWriter.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// The RoadMapImageWriter class writes a CompactRoadMap to an output stream
+// as a road map image (see RoadMapImage.hpp), which MappedRoadMap can later
+// map into memory and query without reading the original map again.
+
+#ifndef ROADMAPIMAGEWRITER_HPP
+#define ROADMAPIMAGEWRITER_HPP
+
+#include <ostream>
+#include "RoadMap.hpp"
+
+
+
+class RoadMapImageWriter
+{
+public:
+    // writeRoadMapImage() writes the given map to the given output stream,
+    // which should have been opened in binary mode.
+    void writeRoadMapImage(std::ostream& out, const CompactRoadMap& roadMap);
+};
+
+
+
+#endif // ROADMAPIMAGEWRITER_HPP
@@ -0,0 +1,50 @@
+// RoadMapLandmarks.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include "RoadMapLandmarks.hpp"
+#include "TripWeights.hpp"
+
+
+RoadMapLandmarks::RoadMapLandmarks()
+{
+}
+
+
+RoadMapLandmarks RoadMapLandmarks::build(const CompactRoadMap& roadMap, int landmarkCount)
+{
+    RoadMapLandmarks landmarks;
+    landmarks.distance_ = LandmarkTable::build(roadMap, weightFor(TripMetric::Distance), landmarkCount);
+    landmarks.time_ = LandmarkTable::build(roadMap, weightFor(TripMetric::Time), landmarkCount);
+    return landmarks;
+}
+
+
+const LandmarkTable& RoadMapLandmarks::forMetric(TripMetric metric) const noexcept
+{
+    return metric == TripMetric::Distance ? distance_ : time_;
+}
+
+
+bool RoadMapLandmarks::matches(const CompactRoadMap& roadMap) const noexcept
+{
+    return distance_.vertexCount() == roadMap.vertexCount()
+        && time_.vertexCount() == roadMap.vertexCount();
+}
+
+
+void RoadMapLandmarks::write(std::ostream& out) const
+{
+    distance_.write(out);
+    time_.write(out);
+}
+
+
+RoadMapLandmarks RoadMapLandmarks::read(std::istream& in)
+{
+    RoadMapLandmarks landmarks;
+    landmarks.distance_ = LandmarkTable::read(in);
+    landmarks.time_ = LandmarkTable::read(in);
+    return landmarks;
+}
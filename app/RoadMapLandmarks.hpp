@@ -0,0 +1,51 @@
+// RoadMapLandmarks.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// RoadMapLandmarks holds one LandmarkTable per TripMetric for a particular
+// RoadMap, so that both kinds of trips can be answered with ALT searches.
+// The tables can be saved to a file after being built, so the expensive
+// preprocessing can be done once, offline, rather than on every run.
+
+#ifndef ROADMAPLANDMARKS_HPP
+#define ROADMAPLANDMARKS_HPP
+
+#include <istream>
+#include <ostream>
+#include "LandmarkTable.hpp"
+#include "RoadMap.hpp"
+#include "TripMetric.hpp"
+
+
+
+class RoadMapLandmarks
+{
+public:
+    // Initializes an empty set of tables, which give no estimates at all.
+    RoadMapLandmarks();
+
+    // build() chooses landmarkCount landmarks on the given map and builds
+    // tables for both metrics.
+    static RoadMapLandmarks build(const CompactRoadMap& roadMap, int landmarkCount);
+
+    // forMetric() returns the table for the given metric.
+    const LandmarkTable& forMetric(TripMetric metric) const noexcept;
+
+    // matches() returns true if the tables were built for a map with the
+    // same number of locations as the given one.
+    bool matches(const CompactRoadMap& roadMap) const noexcept;
+
+    // write() writes both tables to the given stream, and read() reads
+    // them back in, throwing a DigraphException if they're not there.
+    void write(std::ostream& out) const;
+    static RoadMapLandmarks read(std::istream& in);
+
+private:
+    LandmarkTable distance_;
+    LandmarkTable time_;
+};
+
+
+
+#endif // ROADMAPLANDMARKS_HPP
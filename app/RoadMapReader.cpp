@@ -4,37 +4,134 @@
 // Project #4: Rock and Roll Stops the Traffic
 
 #include <algorithm>
-#include <sstream>
+#include <cctype>
+#include <utility>
+#include <vector>
+#include "LineFields.hpp"
 #include "RoadMapReader.hpp"
 
 
-RoadMap RoadMapReader::readRoadMap(InputReader& in)
+namespace
 {
-    RoadMap roadMap;
+    // how many road segments each task parses when they're parsed in
+    // parallel
+    const int segmentsPerChunk = 16384;
 
-    int numberOfLocations = in.readIntLine();
 
-    for (int i = 0; i < numberOfLocations; ++i)
+    Location parseLocation(std::string_view line)
     {
-        roadMap.addVertex(i, in.readLine());
+        Location location{std::string{line}};
+
+        std::string_view::size_type at = line.rfind('@');
+
+        if (at == std::string_view::npos)
+        {
+            return location;
+        }
+
+        LineFields coordinates{line.substr(at + 1)};
+        double latitude;
+        double longitude;
+
+        if (!coordinates.read(latitude) || !coordinates.read(longitude) || !coordinates.atEnd())
+        {
+            return location;
+        }
+
+        // drop the '@' and any spaces in front of it from the name
+        std::string_view::size_type end = at;
+
+        while (end > 0 && std::isspace(static_cast<unsigned char>(line[end - 1])))
+        {
+            --end;
+        }
+
+        location.name = std::string{line.substr(0, end)};
+        location.hasCoordinates = true;
+        location.latitude = latitude;
+        location.longitude = longitude;
+
+        return location;
     }
 
-    int numberOfRoadSegments = in.readIntLine();
 
-    for (int i = 0; i < numberOfRoadSegments; ++i)
+    DigraphEdgeListEntry<RoadSegment> parseRoadSegment(std::string_view line)
     {
-        std::istringstream roadSegmentLine{in.readLine()};
+        LineFields fields{line};
 
         int fromLocation;
         int toLocation;
         double miles;
         double milesPerHour;
 
-        roadSegmentLine >> fromLocation >> toLocation >> miles >> milesPerHour;
+        fields.read(fromLocation);
+        fields.read(toLocation);
+        fields.read(miles);
+        fields.read(milesPerHour);
 
-        roadMap.addEdge(fromLocation, toLocation, RoadSegment{miles, milesPerHour});
+        return {fromLocation, toLocation, RoadSegment{miles, milesPerHour}};
     }
+}
+
+
+RoadMapReader::RoadMapReader()
+    : pool_{nullptr}
+{
+}
+
 
-    return roadMap;
+RoadMapReader::RoadMapReader(WorkerPool& pool)
+    : pool_{&pool}
+{
 }
 
+
+RoadMap RoadMapReader::readRoadMap(InputReader& in, std::pmr::memory_resource* resource)
+{
+    int numberOfLocations = in.readIntLine();
+
+    std::vector<std::pair<int, Location>> locations;
+    locations.reserve(numberOfLocations);
+
+    for (int i = 0; i < numberOfLocations; ++i)
+    {
+        locations.emplace_back(i, parseLocation(in.readLineView()));
+    }
+
+    int numberOfRoadSegments = in.readIntLine();
+
+    // the lines are split up first, which is quick, so that the parsing,
+    // which isn't, can be spread across the pool
+    std::vector<std::string_view> lines = in.readLineViews(numberOfRoadSegments);
+    std::vector<DigraphEdgeListEntry<RoadSegment>> roadSegments(numberOfRoadSegments);
+
+    auto parseChunk =
+        [&lines, &roadSegments](int chunk, int)
+        {
+            int first = chunk * segmentsPerChunk;
+            int last = std::min(first + segmentsPerChunk, static_cast<int>(lines.size()));
+
+            for (int i = first; i < last; ++i)
+            {
+                roadSegments[i] = parseRoadSegment(lines[i]);
+            }
+        };
+
+    int chunkCount = (numberOfRoadSegments + segmentsPerChunk - 1) / segmentsPerChunk;
+
+    if (pool_ != nullptr && chunkCount > 1)
+    {
+        pool_->run(chunkCount, parseChunk);
+    }
+    else
+    {
+        for (int chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            parseChunk(chunk, 0);
+        }
+    }
+
+    // everything is checked and built at once, so a bad map is reported
+    // with all of its bad segments rather than just the first
+    return RoadMap::fromEdgeList(std::move(locations), std::move(roadSegments), resource);
+}
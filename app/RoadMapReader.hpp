@@ -6,22 +6,49 @@
 // The RoadMapReader class provides an object that knows how to read a
 // RoadMap from the standard input, using the format given in the
 // project write-up.
+//
+// The format is extended in one way: a location's line may end with an
+// '@' followed by its latitude and longitude in degrees, such as
+//
+//     Anteater Pkwy & Culver Dr @ 33.6491 -117.8427
+//
+// in which case the location's name is everything before the '@'.  Lines
+// without a well-formed trailing coordinate are taken entirely as names,
+// so maps written in the original format read exactly as before.
+//
+// Given a WorkerPool, a RoadMapReader splits the road segments into chunks
+// and parses them on all of the pool's workers at once.
 
 #ifndef ROADMAPREADER_HPP
 #define ROADMAPREADER_HPP
 
+#include <memory_resource>
 #include "RoadMap.hpp"
 #include "InputReader.hpp"
+#include "WorkerPool.hpp"
 
 
 
 class RoadMapReader
 {
 public:
+    // Initializes a RoadMapReader that parses everything on the calling
+    // thread.
+    RoadMapReader();
+
+    // Initializes a RoadMapReader that parses road segments using the
+    // given pool, which must outlive it.
+    explicit RoadMapReader(WorkerPool& pool);
+
     // readRoadMap() reads a RoadMap from the given InputReader.  The
     // RoadMap is expected to be described in the format given in the
-    // project write-up.
-    RoadMap readRoadMap(InputReader& in);
+    // project write-up.  It allocates from the given memory resource.
+    RoadMap readRoadMap(
+        InputReader& in,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+private:
+    WorkerPool* pool_;
 };
 
 
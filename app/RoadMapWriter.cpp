@@ -12,7 +12,15 @@ void RoadMapWriter::writeRoadMap(std::ostream& out, const RoadMap& roadMap)
 
     for (int vertex : roadMap.vertices())
     {
-        out << "    " << vertex << ": " << roadMap.vertexInfo(vertex) << std::endl;
+        const Location& location = roadMap.vertexInfo(vertex);
+        out << "    " << vertex << ": " << location.name;
+
+        if (location.hasCoordinates)
+        {
+            out << " @ " << location.latitude << " " << location.longitude;
+        }
+
+        out << std::endl;
     }
 
     out << std::endl;
@@ -22,7 +30,7 @@ void RoadMapWriter::writeRoadMap(std::ostream& out, const RoadMap& roadMap)
     {
         out << "    " << edge.first << "," << edge.second << ": ";
 
-        RoadSegment segment = roadMap.edgeInfo(edge.first, edge.second);
+        const RoadSegment& segment = roadMap.edgeInfo(edge.first, edge.second);
         out << segment.miles << "miles; " << segment.milesPerHour << "mph";
 
         out << std::endl;
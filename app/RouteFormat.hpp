@@ -0,0 +1,25 @@
+// RouteFormat.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// A RouteFormat describes how the program writes out the routes it finds
+// (see RouteFormatter).  There are three: the text that people read, which
+// is what the program has always written, and two formats that are meant
+// for other programs to read, JSON lines and binary records.
+
+#ifndef ROUTEFORMAT_HPP
+#define ROUTEFORMAT_HPP
+
+
+
+enum class RouteFormat
+{
+    Text,
+    JsonLines,
+    Binary
+};
+
+
+
+#endif // ROUTEFORMAT_HPP
@@ -0,0 +1,296 @@
+// RouteFormatter.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include <charconv>
+#include <cmath>
+#include <system_error>
+#include "RouteFormatter.hpp"
+
+
+namespace
+{
+    // more than enough room for any number written with to_chars(),
+    // including a fixed-point double as large as a double gets
+    const std::size_t numberRoom = 400;
+
+
+    // the precision a stream starts out with
+    const int defaultPrecision = 6;
+}
+
+
+RouteFormatter::RouteFormatter(const CompactRoadMap& roadMap, RouteFormat format)
+    : roadMap_{roadMap}, format_{format}, fixed_{false}, precision_{defaultPrecision}
+{
+}
+
+
+void RouteFormatter::format(const Trip& trip, const ShortestPath& path)
+{
+    switch (format_)
+    {
+    case RouteFormat::Text:
+        formatText(trip, path);
+        break;
+
+    case RouteFormat::JsonLines:
+        formatJson(trip, path);
+        break;
+
+    case RouteFormat::Binary:
+        formatBinary(trip, path);
+        break;
+    }
+}
+
+
+std::size_t RouteFormatter::size() const noexcept
+{
+    return buffer_.size();
+}
+
+
+void RouteFormatter::writeTo(std::ostream& out)
+{
+    out.write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+}
+
+
+void RouteFormatter::formatText(const Trip& trip, const ShortestPath& path)
+{
+    const std::string& startName = roadMap_.vertexInfo(trip.startVertex).name;
+    const std::string& endName = roadMap_.vertexInfo(trip.endVertex).name;
+
+    if (trip.metric == TripMetric::Distance)
+    {
+        append("Shortest distance from ");
+        append(startName);
+        append(" to ");
+        append(endName);
+        append(":\n");
+
+        if (!path.exists())
+        {
+            append("\tNo route exists\n\n");
+            return;
+        }
+
+        append("\tBegin at ");
+        append(startName);
+        append("\n");
+
+        for (std::size_t leg = 1; leg < path.vertices.size(); ++leg)
+        {
+            append("\tContinue to ");
+            append(roadMap_.vertexInfo(path.vertices[leg]).name);
+            append(" (");
+            appendNumber(path.weights[leg - 1]);
+            append(" miles)\n");
+        }
+
+        append("Total distance: ");
+        appendNumber(path.totalCost);
+        append(" miles\n");
+    }
+    else
+    {
+        append("Shortest driving time from ");
+        append(startName);
+        append(" to ");
+        append(endName);
+        append(":\n");
+
+        if (!path.exists())
+        {
+            append("\tNo route exists\n");
+
+            // as though the route's time had been printed
+            fixed_ = true;
+            precision_ = 2;
+
+            append("\n");
+            return;
+        }
+
+        append("\tBegin at ");
+        append(startName);
+        append("\n");
+
+        for (std::size_t leg = 1; leg < path.vertices.size(); ++leg)
+        {
+            const RoadSegment& segment = roadMap_.edgeInfo(path.vertices[leg - 1], path.vertices[leg]);
+
+            append("\tContinue to ");
+            append(roadMap_.vertexInfo(path.vertices[leg]).name);
+            append(" (");
+            appendNumber(segment.miles);
+            append(" miles @ ");
+            appendNumber(segment.milesPerHour);
+            append("mph = ");
+            appendTime(path.weights[leg - 1]);
+            append(")\n");
+        }
+
+        append("Total time: ");
+        appendTime(path.totalCost);
+        append("\n");
+    }
+
+    append("\n");
+}
+
+
+void RouteFormatter::formatJson(const Trip& trip, const ShortestPath& path)
+{
+    append("{\"from\":");
+    appendInt(trip.startVertex);
+    append(",\"to\":");
+    appendInt(trip.endVertex);
+    append(trip.metric == TripMetric::Distance ? ",\"metric\":\"distance\"" : ",\"metric\":\"time\"");
+
+    if (!path.exists())
+    {
+        append(",\"route\":null}\n");
+        return;
+    }
+
+    append(",\"route\":[");
+
+    for (std::size_t i = 0; i < path.vertices.size(); ++i)
+    {
+        if (i > 0)
+        {
+            append(",");
+        }
+
+        appendInt(path.vertices[i]);
+    }
+
+    append("],\"weights\":[");
+
+    for (std::size_t i = 0; i < path.weights.size(); ++i)
+    {
+        if (i > 0)
+        {
+            append(",");
+        }
+
+        appendShortest(path.weights[i]);
+    }
+
+    append("],\"total\":");
+    appendShortest(path.totalCost);
+    append("}\n");
+}
+
+
+void RouteFormatter::formatBinary(const Trip& trip, const ShortestPath& path)
+{
+    RouteRecord record{
+        trip.startVertex,
+        trip.endVertex,
+        trip.metric == TripMetric::Distance ? 0u : 1u,
+        path.exists() ? static_cast<std::uint32_t>(path.vertices.size()) : 0u,
+        path.exists() ? path.totalCost : 0.0};
+
+    appendBytes(&record, 1);
+
+    if (path.exists())
+    {
+        appendBytes(path.weights.data(), path.weights.size());
+        appendBytes(path.vertices.data(), path.vertices.size());
+    }
+}
+
+
+void RouteFormatter::append(std::string_view text)
+{
+    buffer_.append(text);
+}
+
+
+template <typename T>
+void RouteFormatter::appendBytes(const T* items, std::size_t count)
+{
+    buffer_.append(reinterpret_cast<const char*>(items), count * sizeof(T));
+}
+
+
+void RouteFormatter::appendNumber(double value)
+{
+    char digits[numberRoom];
+    std::to_chars_result result;
+
+    if (fixed_)
+    {
+        result = std::to_chars(digits, digits + numberRoom, value, std::chars_format::fixed, precision_);
+    }
+    else
+    {
+        // a stream's default format is printf()'s %g
+        result = std::to_chars(digits, digits + numberRoom, value, std::chars_format::general, precision_);
+    }
+
+    buffer_.append(digits, result.ptr);
+}
+
+
+void RouteFormatter::appendInt(int value)
+{
+    char digits[numberRoom];
+    std::to_chars_result result = std::to_chars(digits, digits + numberRoom, value);
+    buffer_.append(digits, result.ptr);
+}
+
+
+void RouteFormatter::appendShortest(double value)
+{
+    char digits[numberRoom];
+    std::to_chars_result result = std::to_chars(digits, digits + numberRoom, value);
+    buffer_.append(digits, result.ptr);
+}
+
+
+void RouteFormatter::appendTime(float hours)
+{
+    // the arithmetic (float and all) and the formatting are just as they
+    // always were, so the same times come out the same way
+    double hr = hours;
+    double min = hours * 60;
+
+    double fHour = std::floor(hr);
+    double fMin = std::floor((hr - fHour) * 60);
+    double fSec = (((hr - fHour) * 60) - fMin) * 60;
+
+    fixed_ = true;
+
+    if (hr >= 1)
+    {
+        precision_ = 0;
+        appendNumber(hr);
+        append(" hours ");
+        appendNumber(fMin);
+        append(" minutes ");
+        precision_ = 2;
+        appendNumber(fSec);
+        append(" seconds");
+    }
+    else if (min >= 1)
+    {
+        precision_ = 0;
+        appendNumber(fMin);
+        append(" min ");
+        precision_ = 2;
+        appendNumber(fSec);
+        append(" seconds");
+    }
+    else
+    {
+        precision_ = 2;
+        appendNumber(fSec);
+        append(" seconds");
+    }
+}
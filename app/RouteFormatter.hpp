@@ -0,0 +1,115 @@
+// RouteFormatter.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// A RouteFormatter writes the route found for each trip into a buffer of
+// bytes, which is written to an output stream in large blocks rather than
+// a line at a time.  Numbers are written with std::to_chars, and the buffer
+// is reused from one block to the next, so once it's grown to the size of
+// a block, formatting routes doesn't allocate any memory at all.
+//
+// In RouteFormat::Text, the output is exactly what the program has always
+// printed through std::cout, down to one quirk: numbers print in the
+// stream's default format until the first time trip is printed, which
+// leaves the stream fixed with 2 digits after the decimal point, and every
+// number printed after that comes out that way.  A RouteFormatter keeps
+// track of that the same way, so trips have to be formatted in order.
+//
+// In RouteFormat::JsonLines, each trip is one line holding a JSON object:
+//
+//     {"from":0,"to":5,"metric":"distance","route":[0,3,5],"weights":[1.5,2],"total":3.5}
+//
+// where the weights are miles for distance trips and hours for time trips,
+// and "route" is null (with no weights or total) if there's no route.
+// Numbers are written with as few digits as read back exactly.
+//
+// In RouteFormat::Binary, each trip is a RouteRecord, followed by the
+// weight of each leg of the route as a double, followed by the vertex
+// number of each vertex on it as an int32, all in the byte order of the
+// machine writing them.  Records are packed one after another with no
+// padding, so they should be read with std::memcpy.
+
+#ifndef ROUTEFORMATTER_HPP
+#define ROUTEFORMATTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "RoadMap.hpp"
+#include "RouteFormat.hpp"
+#include "ShortestPathTree.hpp"
+#include "Trip.hpp"
+
+
+
+struct RouteRecord
+{
+    std::int32_t startVertex;
+    std::int32_t endVertex;
+
+    // 0 for TripMetric::Distance, 1 for TripMetric::Time
+    std::uint32_t metric;
+
+    // the number of vertices on the route, which is 0 if there isn't one,
+    // so there are vertexCount - 1 legs
+    std::uint32_t vertexCount;
+
+    double totalCost;
+};
+
+
+
+class RouteFormatter
+{
+public:
+    // Initializes a RouteFormatter for routes on the given map, which must
+    // outlive it.
+    RouteFormatter(const CompactRoadMap& roadMap, RouteFormat format);
+
+    // format() adds the output for the given trip and the route found for
+    // it to the buffer.  If the trip's vertices aren't on the map, a
+    // DigraphException is thrown.
+    void format(const Trip& trip, const ShortestPath& path);
+
+    // size() returns the number of bytes in the buffer.
+    std::size_t size() const noexcept;
+
+    // writeTo() writes the whole buffer to the given stream and empties
+    // it.
+    void writeTo(std::ostream& out);
+
+private:
+    const CompactRoadMap& roadMap_;
+    RouteFormat format_;
+    std::string buffer_;
+
+    // how numbers in RouteFormat::Text print right now, as a stream's
+    // std::fixed and precision would say
+    bool fixed_;
+    int precision_;
+
+    void formatText(const Trip& trip, const ShortestPath& path);
+    void formatJson(const Trip& trip, const ShortestPath& path);
+    void formatBinary(const Trip& trip, const ShortestPath& path);
+
+    // append() adds text to the buffer.  appendNumber() adds a number the
+    // way a stream in the current state would print it, and appendTime()
+    // adds a length of time given in hours the way the program always has,
+    // as hours, minutes, and seconds.  appendInt() and appendShortest()
+    // add numbers for JSON, and appendBytes() adds raw values.
+    void append(std::string_view text);
+    void appendNumber(double value);
+    void appendInt(int value);
+    void appendShortest(double value);
+    void appendTime(float hours);
+
+    template <typename T>
+    void appendBytes(const T* items, std::size_t count);
+};
+
+
+
+#endif // ROUTEFORMATTER_HPP
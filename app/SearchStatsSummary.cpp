@@ -0,0 +1,103 @@
+// SearchStatsSummary.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include "SearchStatsSummary.hpp"
+
+
+namespace
+{
+    // percentile() returns the smallest value that at least the given
+    // fraction of the (sorted) values are no greater than
+    double percentile(const std::vector<double>& sorted, double fraction)
+    {
+        std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * sorted.size()));
+        return sorted[std::max<std::size_t>(rank, 1) - 1];
+    }
+
+
+    // one row of the table, and how to pull its value out of SearchStats
+    struct Row
+    {
+        const char* name;
+        double (*value)(const SearchStats&);
+    };
+
+
+    const Row rows[] = {
+        {"settled", [](const SearchStats& s) { return static_cast<double>(s.settled); }},
+        {"relaxed", [](const SearchStats& s) { return static_cast<double>(s.relaxed); }},
+        {"pushes", [](const SearchStats& s) { return static_cast<double>(s.pushes); }},
+        {"pops", [](const SearchStats& s) { return static_cast<double>(s.pops); }},
+        {"decrease-keys", [](const SearchStats& s) { return static_cast<double>(s.decreaseKeys); }},
+        {"peak queue", [](const SearchStats& s) { return static_cast<double>(s.peakQueueSize); }},
+        {"init ms", [](const SearchStats& s) { return s.initSeconds * 1000.0; }},
+        {"search ms", [](const SearchStats& s) { return s.searchSeconds * 1000.0; }},
+        {"path ms", [](const SearchStats& s) { return s.pathSeconds * 1000.0; }},
+        {"total ms", [](const SearchStats& s) { return s.totalSeconds() * 1000.0; }}
+    };
+}
+
+
+void SearchStatsSummary::add(const SearchStats& stats)
+{
+    trips_.push_back(stats);
+}
+
+
+std::size_t SearchStatsSummary::tripCount() const noexcept
+{
+    return trips_.size();
+}
+
+
+void SearchStatsSummary::write(std::ostream& out) const
+{
+    out << "Search statistics for " << trips_.size() << " trips" << std::endl;
+
+    if (trips_.empty())
+    {
+        return;
+    }
+
+    const int width = 12;
+
+    // the table's formatting is undone afterward
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << std::left << std::setw(16) << "" << std::right
+        << std::setw(width) << "mean" << std::setw(width) << "p50"
+        << std::setw(width) << "p90" << std::setw(width) << "p99"
+        << std::setw(width) << "max" << std::endl;
+
+    std::vector<double> values(trips_.size());
+
+    for (const Row& row : rows)
+    {
+        double sum = 0.0;
+
+        for (std::size_t i = 0; i < trips_.size(); ++i)
+        {
+            values[i] = row.value(trips_[i]);
+            sum += values[i];
+        }
+
+        std::sort(values.begin(), values.end());
+
+        out << std::left << std::setw(16) << row.name << std::right
+            << std::fixed << std::setprecision(3)
+            << std::setw(width) << sum / values.size()
+            << std::setw(width) << percentile(values, 0.50)
+            << std::setw(width) << percentile(values, 0.90)
+            << std::setw(width) << percentile(values, 0.99)
+            << std::setw(width) << values.back() << std::endl;
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
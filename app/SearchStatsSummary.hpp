@@ -0,0 +1,41 @@
+// SearchStatsSummary.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// A SearchStatsSummary gathers up the SearchStats of a batch of trips and
+// summarizes them: for each statistic, its mean, median, 90th and 99th
+// percentiles, and maximum over the batch.  That's usually enough to see
+// whether slow trips are slow because they search more of the map, or
+// because something else (such as putting a long path together) is slow.
+
+#ifndef SEARCHSTATSSUMMARY_HPP
+#define SEARCHSTATSSUMMARY_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+#include "SearchStats.hpp"
+
+
+
+class SearchStatsSummary
+{
+public:
+    // add() adds one trip's statistics to the batch.
+    void add(const SearchStats& stats);
+
+    // tripCount() returns the number of trips added so far.
+    std::size_t tripCount() const noexcept;
+
+    // write() writes the summary as a table, one statistic per line, with
+    // times in milliseconds.
+    void write(std::ostream& out) const;
+
+private:
+    std::vector<SearchStats> trips_;
+};
+
+
+
+#endif // SEARCHSTATSSUMMARY_HPP
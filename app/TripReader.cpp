@@ -3,8 +3,8 @@
 // ICS 46 Winter 2019
 // Project #4: Rock and Roll Stops the Traffic
 
-#include <sstream>
-#include <string>
+#include <string_view>
+#include "LineFields.hpp"
 #include "TripReader.hpp"
 
 
@@ -12,23 +12,56 @@ std::vector<Trip> TripReader::readTrips(InputReader& in)
 {
     std::vector<Trip> trips;
 
-    int numberOfTrips = in.readIntLine();
+    TripStream stream{in};
+    Trip trip;
 
-    for (int i = 0; i < numberOfTrips; ++i)
+    while (stream.next(trip))
     {
-        std::istringstream tripLine{in.readLine()};
+        trips.push_back(trip);
+    }
+
+    return trips;
+}
+
 
-        int fromVertex;
-        int toVertex;
-        std::string metricType;
+TripStream::TripStream(InputReader& in)
+    : in_{in}, remaining_{-1}
+{
+}
 
-        tripLine >> fromVertex >> toVertex >> metricType;
 
-        trips.push_back(
-            {fromVertex, toVertex,
-             metricType == "D" ? TripMetric::Distance : TripMetric::Time});
+bool TripStream::next(Trip& trip)
+{
+    if (remaining_ == -1)
+    {
+        remaining_ = in_.readIntLine();
     }
 
-    return trips;
-}
+    if (remaining_ <= 0)
+    {
+        return false;
+    }
+
+    std::string_view line = in_.readLineView();
+
+    // meaningful lines are never empty, so this is the end of the input
+    if (line.empty())
+    {
+        remaining_ = 0;
+        return false;
+    }
+
+    --remaining_;
 
+    LineFields tripLine{line};
+
+    std::string_view metricType;
+
+    tripLine.read(trip.startVertex);
+    tripLine.read(trip.endVertex);
+    tripLine.read(metricType);
+
+    trip.metric = metricType == "D" ? TripMetric::Distance : TripMetric::Time;
+
+    return true;
+}
@@ -25,5 +25,31 @@ public:
 
 
 
+// A TripStream reads the same sequence of trips as readTrips(), but one at
+// a time, as they're asked for, so that the first trips can be answered
+// before the rest have even arrived, and so that no more than one trip has
+// to be held at a time.
+
+class TripStream
+{
+public:
+    // Initializes a TripStream that reads from the given input, which must
+    // outlive it.  Nothing is read until next() is called.
+    explicit TripStream(InputReader& in);
+
+    // next() reads the next trip into trip and returns true, or returns
+    // false if every trip has been read or the input has run out.
+    bool next(Trip& trip);
+
+private:
+    InputReader& in_;
+
+    // how many trips are left to read, or -1 if the count hasn't been
+    // read yet
+    int remaining_;
+};
+
+
+
 #endif // TRIPREADER_HPP
 
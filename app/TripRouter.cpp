@@ -0,0 +1,354 @@
+// TripRouter.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include <algorithm>
+#include <utility>
+#include "TripRouter.hpp"
+#include "TripWeights.hpp"
+
+
+namespace
+{
+    // findIslands() numbers the vertices of the map so that two vertices
+    // get the same number exactly when roads, followed in either
+    // direction, lead from one to the other.
+    std::vector<int> findIslands(const CompactRoadMap& roadMap)
+    {
+        std::vector<int> parent(roadMap.vertexCount());
+
+        for (int v = 0; v < roadMap.vertexCount(); ++v)
+        {
+            parent[v] = v;
+        }
+
+        auto root = [&parent](int v)
+        {
+            while (parent[v] != v)
+            {
+                parent[v] = parent[parent[v]];
+                v = parent[v];
+            }
+
+            return v;
+        };
+
+        for (int v = 0; v < roadMap.vertexCount(); ++v)
+        {
+            for (int e = roadMap.edgeBegin(v); e < roadMap.edgeEnd(v); ++e)
+            {
+                parent[root(roadMap.edgeTarget(e))] = root(v);
+            }
+        }
+
+        for (int v = 0; v < roadMap.vertexCount(); ++v)
+        {
+            parent[v] = root(v);
+        }
+
+        return parent;
+    }
+
+
+    // A StatsCollection points every queue in a TripRouterSearch at the
+    // given SearchStats (or at none, if it's nullptr) for as long as the
+    // StatsCollection exists.
+    class StatsCollection
+    {
+    public:
+        StatsCollection(TripRouterSearch& search, SearchStats* stats)
+            : search_{search}
+        {
+            collect(stats);
+        }
+
+        ~StatsCollection()
+        {
+            collect(nullptr);
+        }
+
+        StatsCollection(const StatsCollection&) = delete;
+        StatsCollection& operator=(const StatsCollection&) = delete;
+
+    private:
+        TripRouterSearch& search_;
+
+        // cells searched again while unpacking an overlay path are timed
+        // as part of putting the path together, so search_.overlay.unpack
+        // is left out
+        void collect(SearchStats* stats)
+        {
+            search_.space.forward.queue.collectStats(stats);
+            search_.space.backward.queue.collectStats(stats);
+            search_.hierarchy.forwardQueue.collectStats(stats);
+            search_.hierarchy.backwardQueue.collectStats(stats);
+            search_.overlay.query.queue.collectStats(stats);
+        }
+    };
+}
+
+
+TripRouter::TripRouter(const CompactRoadMap& roadMap)
+    : roadMap_{roadMap}, heuristic_{roadMap},
+      distanceWeights_{EdgeWeightColumn::build(roadMap, TripWeight<TripMetric::Distance>{})},
+      timeWeights_{EdgeWeightColumn::build(roadMap, TripWeight<TripMetric::Time>{})},
+      components_{roadMap.stronglyConnectedComponents()}, islands_{findIslands(roadMap)},
+      hasLandmarks_{false}, hasHierarchies_{false}, hasOverlay_{false}
+{
+}
+
+
+void TripRouter::useLandmarks(RoadMapLandmarks landmarks)
+{
+    if (!landmarks.matches(roadMap_))
+    {
+        throw DigraphException("Landmark tables do not match the map");
+    }
+
+    landmarks_ = std::move(landmarks);
+    hasLandmarks_ = true;
+}
+
+
+void TripRouter::useContractionHierarchies()
+{
+    distanceHierarchy_ = ContractionHierarchy::build(roadMap_, weightFor(TripMetric::Distance));
+    timeHierarchy_ = ContractionHierarchy::build(roadMap_, weightFor(TripMetric::Time));
+    hasHierarchies_ = true;
+}
+
+
+void TripRouter::useOverlay(const std::vector<int>& maxCellSizes)
+{
+    overlay_ = PartitionOverlay::build(roadMap_, MultilevelPartition::build(roadMap_, maxCellSizes));
+    customizeOverlay(TripMetric::Distance);
+    customizeOverlay(TripMetric::Time);
+    hasOverlay_ = true;
+}
+
+
+void TripRouter::customizeOverlay(TripMetric metric)
+{
+    OverlayMetric& customized = metric == TripMetric::Distance ? distanceOverlay_ : timeOverlay_;
+    customized = overlay_.customize(roadMap_, weightFor(metric));
+}
+
+
+ShortestPath TripRouter::route(const Trip& trip, TripRouterSearch& search) const
+{
+    return routeWith(trip, search, nullptr);
+}
+
+
+ShortestPath TripRouter::route(const Trip& trip, TripRouterSearch& search, SearchStats& stats) const
+{
+    stats = SearchStats{};
+    return routeWith(trip, search, &stats);
+}
+
+
+ShortestPath TripRouter::routeWith(const Trip& trip, TripRouterSearch& search, SearchStats* stats) const
+{
+    StatsCollection collecting{search, stats};
+
+    if (unreachable(roadMap_.indexOf(trip.startVertex), roadMap_.indexOf(trip.endVertex)))
+    {
+        return ShortestPath{};
+    }
+
+    if (hasHierarchies_)
+    {
+        const ContractionHierarchy& hierarchy =
+            trip.metric == TripMetric::Distance ? distanceHierarchy_ : timeHierarchy_;
+
+        return hierarchy.findShortestPath(roadMap_, trip.startVertex, trip.endVertex, search.hierarchy);
+    }
+    else if (hasOverlay_)
+    {
+        const OverlayMetric& metric =
+            trip.metric == TripMetric::Distance ? distanceOverlay_ : timeOverlay_;
+
+        return overlay_.findShortestPath(roadMap_, metric, trip.startVertex, trip.endVertex, search.overlay);
+    }
+
+    const EdgeWeightColumn& weights = weightsFor(trip.metric);
+
+    // A* only needs one tree, so it borrows the forward half
+    if (hasLandmarks_)
+    {
+        const LandmarkTable& table = landmarks_.forMetric(trip.metric);
+
+        return roadMap_.findShortestPathAStar(
+            trip.startVertex, trip.endVertex, weights,
+            table.estimateTo(roadMap_.indexOf(trip.endVertex)), search.space.forward);
+    }
+    else if (heuristic_.available())
+    {
+        return roadMap_.findShortestPathAStar(
+            trip.startVertex, trip.endVertex, weights,
+            heuristic_.estimateTo(trip.endVertex, trip.metric), search.space.forward);
+    }
+    else
+    {
+        return roadMap_.findShortestPathBidirectional(
+            trip.startVertex, trip.endVertex, weights, search.space);
+    }
+}
+
+
+std::vector<std::vector<std::size_t>> TripRouter::groupTrips(const std::vector<Trip>& trips)
+{
+    // trips in order of (metric, start), so that each group is contiguous;
+    // stable, so each group is still in input order
+    std::vector<std::size_t> order(trips.size());
+
+    for (std::size_t i = 0; i < trips.size(); ++i)
+    {
+        order[i] = i;
+    }
+
+    std::stable_sort(
+        order.begin(), order.end(),
+        [&trips](std::size_t a, std::size_t b)
+        {
+            if (trips[a].metric != trips[b].metric)
+            {
+                return trips[a].metric < trips[b].metric;
+            }
+
+            return trips[a].startVertex < trips[b].startVertex;
+        });
+
+    std::vector<std::vector<std::size_t>> groups;
+
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        const Trip& trip = trips[order[i]];
+
+        if (i == 0
+            || trip.metric != trips[order[i - 1]].metric
+            || trip.startVertex != trips[order[i - 1]].startVertex)
+        {
+            groups.emplace_back();
+        }
+
+        groups.back().push_back(order[i]);
+    }
+
+    return groups;
+}
+
+
+std::vector<ShortestPath> TripRouter::routeGroup(
+    const std::vector<Trip>& trips, const std::vector<std::size_t>& group,
+    TripRouterSearch& search) const
+{
+    return routeGroupWith(trips, group, search, nullptr);
+}
+
+
+std::vector<ShortestPath> TripRouter::routeGroup(
+    const std::vector<Trip>& trips, const std::vector<std::size_t>& group,
+    TripRouterSearch& search, std::vector<SearchStats>& stats) const
+{
+    stats.assign(group.size(), SearchStats{});
+    return routeGroupWith(trips, group, search, &stats);
+}
+
+
+std::vector<ShortestPath> TripRouter::routeGroupWith(
+    const std::vector<Trip>& trips, const std::vector<std::size_t>& group,
+    TripRouterSearch& search, std::vector<SearchStats>* stats) const
+{
+    std::vector<ShortestPath> paths;
+    paths.reserve(group.size());
+
+    // where the statistics for the kth trip in the group go, if anywhere
+    auto statsFor =
+        [stats](std::size_t k)
+        {
+            return stats != nullptr ? &(*stats)[k] : nullptr;
+        };
+
+    if (group.size() == 1 || hasHierarchies_ || hasOverlay_)
+    {
+        for (std::size_t k = 0; k < group.size(); ++k)
+        {
+            paths.push_back(routeWith(trips[group[k]], search, statsFor(k)));
+        }
+    }
+    else
+    {
+        const Trip& leader = trips[group.front()];
+        int start = roadMap_.indexOf(leader.startVertex);
+
+        // the tree is only worth growing if some trip might use it, and
+        // the first one that does is charged for it
+        std::size_t firstReachable = group.size();
+
+        for (std::size_t k = group.size(); k > 0; --k)
+        {
+            if (!unreachable(start, roadMap_.indexOf(trips[group[k - 1]].endVertex)))
+            {
+                firstReachable = k - 1;
+            }
+        }
+
+        const EdgeWeightColumn& weights = weightsFor(leader.metric);
+
+        if (firstReachable < group.size())
+        {
+            StatsCollection collecting{search, statsFor(firstReachable)};
+            roadMap_.findShortestPaths(leader.startVertex, weights, search.space.forward);
+        }
+
+        for (std::size_t k = 0; k < group.size(); ++k)
+        {
+            const Trip& trip = trips[group[k]];
+
+            if (unreachable(start, roadMap_.indexOf(trip.endVertex)))
+            {
+                paths.push_back(ShortestPath{});
+            }
+            else
+            {
+                StatsCollection collecting{search, statsFor(k)};
+                paths.push_back(roadMap_.pathTo(search.space.forward, trip.endVertex, weights));
+            }
+        }
+    }
+
+    return paths;
+}
+
+
+std::vector<ShortestPath> TripRouter::routeAll(const std::vector<Trip>& trips, TripRouterSearch& search) const
+{
+    std::vector<ShortestPath> paths(trips.size());
+
+    for (const std::vector<std::size_t>& group : groupTrips(trips))
+    {
+        std::vector<ShortestPath> routed = routeGroup(trips, group, search);
+
+        for (std::size_t i = 0; i < group.size(); ++i)
+        {
+            paths[group[i]] = std::move(routed[i]);
+        }
+    }
+
+    return paths;
+}
+
+
+const EdgeWeightColumn& TripRouter::weightsFor(TripMetric metric) const noexcept
+{
+    return metric == TripMetric::Distance ? distanceWeights_ : timeWeights_;
+}
+
+
+bool TripRouter::unreachable(int startIndex, int endIndex) const noexcept
+{
+    return islands_[startIndex] != islands_[endIndex]
+        || !components_.mightReach(startIndex, endIndex);
+}
@@ -0,0 +1,160 @@
+// TripRouter.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// A TripRouter finds the route for each trip on a RoadMap, picking the
+// fastest technique the map supports:
+//
+// * a contraction hierarchy, if one has been built;
+// * otherwise a partition overlay, if one has been built;
+// * otherwise A* guided by landmark tables, if they've been supplied;
+// * otherwise A* guided by coordinates, if every location has them;
+// * otherwise bidirectional Dijkstra.
+//
+// When routing a whole batch of trips, trips that share a start vertex and
+// a metric are answered from a single shortest path tree instead (unless a
+// contraction hierarchy or an overlay makes each trip cheaper on its own).
+//
+// Every road's weight under each metric is worked out once, up front, and
+// kept in an EdgeWeightColumn, so searches read weights instead of working
+// them out (which, for time, means a division) every time a road is
+// followed.
+//
+// Before any searching, a trip is checked against the map's strongly
+// connected components and its islands (groups of locations joined by
+// roads in either direction).  A trip between two islands, or from a
+// component that comes later in the map's one-way order to one that comes
+// earlier, can't have a route, so it's turned away without a search.
+//
+// Every technique finds a shortest route, so which one is used affects only
+// how long it takes, and which route is printed when several tie.
+//
+// Once it's been set up, a TripRouter never changes while routing: all of
+// the scratch space a search needs lives in a TripRouterSearch, so several
+// threads can route trips at the same time, each with its own.  Reusing a
+// TripRouterSearch from one trip to the next means nothing is reallocated.
+//
+// Trips can also be routed along with SearchStats describing the work
+// each one took, which are only collected in builds with
+// DIGRAPH_SEARCH_STATS defined (see SearchStats.hpp).
+
+#ifndef TRIPROUTER_HPP
+#define TRIPROUTER_HPP
+
+#include "BidirectionalSearch.hpp"
+#include "ContractionHierarchy.hpp"
+#include "EdgeWeightColumn.hpp"
+#include "PartitionOverlay.hpp"
+#include "RoadMap.hpp"
+#include "RoadMapHeuristic.hpp"
+#include "RoadMapLandmarks.hpp"
+#include "SearchStats.hpp"
+#include "ShortestPathTree.hpp"
+#include "StronglyConnectedComponents.hpp"
+#include <vector>
+#include "Trip.hpp"
+#include "TripMetric.hpp"
+
+
+
+struct TripRouterSearch
+{
+    BidirectionalSearchSpace space;
+    ContractionHierarchySearch hierarchy;
+    OverlaySearch overlay;
+};
+
+
+
+class TripRouter
+{
+public:
+    // Initializes a TripRouter for the given map, which must outlive it.
+    explicit TripRouter(const CompactRoadMap& roadMap);
+
+    // useLandmarks() makes later trips use the given landmark tables.  A
+    // DigraphException is thrown if they were built for a different map.
+    void useLandmarks(RoadMapLandmarks landmarks);
+
+    // useContractionHierarchies() contracts the map once for each metric,
+    // and makes later trips use the resulting hierarchies.
+    void useContractionHierarchies();
+
+    // useOverlay() partitions the map into cells of at most the given
+    // sizes, builds an overlay on top of it, and customizes it for each
+    // metric.  Later trips use the overlay.
+    void useOverlay(const std::vector<int>& maxCellSizes);
+
+    // customizeOverlay() customizes the overlay for the given metric
+    // again, without partitioning the map again, which is all that's
+    // needed when only the weights of the roads have changed.
+    void customizeOverlay(TripMetric metric);
+
+    // route() returns a shortest route for the given trip.  Its weights
+    // are miles for TripMetric::Distance and hours for TripMetric::Time.
+    // If there's no route, the result's exists() is false.
+    ShortestPath route(const Trip& trip, TripRouterSearch& search) const;
+
+    // This overload of route() also sets stats to describe the search.
+    ShortestPath route(const Trip& trip, TripRouterSearch& search, SearchStats& stats) const;
+
+    // groupTrips() divides the given trips into groups that share a start
+    // vertex and a metric.  Each group lists the positions of its trips,
+    // in increasing order.
+    static std::vector<std::vector<std::size_t>> groupTrips(const std::vector<Trip>& trips);
+
+    // routeGroup() returns a shortest route for each trip in one of the
+    // groups returned by groupTrips(), in the same order as the group.
+    std::vector<ShortestPath> routeGroup(
+        const std::vector<Trip>& trips, const std::vector<std::size_t>& group,
+        TripRouterSearch& search) const;
+
+    // This overload of routeGroup() also sets stats[i] to describe the
+    // search for the ith trip in the group.  When the group shares one
+    // search, that search is counted toward the first trip that uses it,
+    // and the rest count only putting their own paths together.
+    std::vector<ShortestPath> routeGroup(
+        const std::vector<Trip>& trips, const std::vector<std::size_t>& group,
+        TripRouterSearch& search, std::vector<SearchStats>& stats) const;
+
+    // routeAll() returns a shortest route for each of the given trips, in
+    // the same order as the trips.
+    std::vector<ShortestPath> routeAll(const std::vector<Trip>& trips, TripRouterSearch& search) const;
+
+private:
+    const CompactRoadMap& roadMap_;
+    RoadMapHeuristic heuristic_;
+    EdgeWeightColumn distanceWeights_;
+    EdgeWeightColumn timeWeights_;
+    StronglyConnectedComponents components_;
+    std::vector<int> islands_;
+    RoadMapLandmarks landmarks_;
+    bool hasLandmarks_;
+    ContractionHierarchy distanceHierarchy_;
+    ContractionHierarchy timeHierarchy_;
+    bool hasHierarchies_;
+    PartitionOverlay overlay_;
+    OverlayMetric distanceOverlay_;
+    OverlayMetric timeOverlay_;
+    bool hasOverlay_;
+
+    // routeWith() and routeGroupWith() do the work of route() and
+    // routeGroup(), collecting statistics if stats isn't nullptr.
+    ShortestPath routeWith(const Trip& trip, TripRouterSearch& search, SearchStats* stats) const;
+
+    std::vector<ShortestPath> routeGroupWith(
+        const std::vector<Trip>& trips, const std::vector<std::size_t>& group,
+        TripRouterSearch& search, std::vector<SearchStats>* stats) const;
+
+    // weightsFor() returns the column of weights for the given metric.
+    const EdgeWeightColumn& weightsFor(TripMetric metric) const noexcept;
+
+    // unreachable() returns true if the components or islands of the
+    // vertices at the two indices rule out any route between them.
+    bool unreachable(int startIndex, int endIndex) const noexcept;
+};
+
+
+
+#endif // TRIPROUTER_HPP
@@ -0,0 +1,97 @@
+// TripWeights.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Edge weight functions for the two kinds of trips.  A trip that minimizes
+// distance weighs each RoadSegment by its length in miles; a trip that
+// minimizes driving time weighs it by the hours it takes to drive.
+//
+// Each weight comes in two forms: as a std::function chosen at run time by
+// weightFor(), and as a TripWeight function object whose metric is fixed
+// at compile time, which searches can inline into their inner loops.
+
+#ifndef TRIPWEIGHTS_HPP
+#define TRIPWEIGHTS_HPP
+
+#include <functional>
+#include "RoadSegment.hpp"
+#include "TripMetric.hpp"
+
+
+
+// distanceWeight() returns the miles a road segment spans.
+inline double distanceWeight(const RoadSegment& segment)
+{
+    return segment.miles;
+}
+
+
+// timeWeight() returns the hours it takes to drive a road segment.
+inline double timeWeight(const RoadSegment& segment)
+{
+    // mi / (mi/hr) = hr
+    return segment.miles / segment.milesPerHour;
+}
+
+
+// TripWeight<metric> weighs a road segment the same way as distanceWeight()
+// or timeWeight(), depending on the metric.
+template <TripMetric metric>
+struct TripWeight;
+
+
+template <>
+struct TripWeight<TripMetric::Distance>
+{
+    double operator()(const RoadSegment& segment) const noexcept
+    {
+        return distanceWeight(segment);
+    }
+};
+
+
+template <>
+struct TripWeight<TripMetric::Time>
+{
+    double operator()(const RoadSegment& segment) const noexcept
+    {
+        return timeWeight(segment);
+    }
+};
+
+
+// withTripWeight() calls action with the TripWeight for the given metric
+// and returns what it returns.  action is compiled once for each metric,
+// so each copy knows exactly which weight it's using.
+template <typename Action>
+auto withTripWeight(TripMetric metric, Action&& action)
+    -> decltype(action(TripWeight<TripMetric::Distance>{}))
+{
+    if (metric == TripMetric::Distance)
+    {
+        return action(TripWeight<TripMetric::Distance>{});
+    }
+    else
+    {
+        return action(TripWeight<TripMetric::Time>{});
+    }
+}
+
+
+// weightFor() returns the weight function to use for the given metric.
+inline std::function<double(const RoadSegment&)> weightFor(TripMetric metric)
+{
+    if (metric == TripMetric::Distance)
+    {
+        return distanceWeight;
+    }
+    else
+    {
+        return timeWeight;
+    }
+}
+
+
+
+#endif // TRIPWEIGHTS_HPP
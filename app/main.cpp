@@ -7,188 +7,291 @@
 // console user interface.
 
 #include "Digraph.hpp"
+#include "DigraphArena.hpp"
+#include "DimacsReader.hpp"
 #include "InputReader.hpp"
+#include "MappedFile.hpp"
+#include "MappedRoadMap.hpp"
+#include "OrderedPipeline.hpp"
 #include "RoadMap.hpp"
+#include "ProgramOptions.hpp"
+#include "RoadMapImageWriter.hpp"
+#include "RoadMapLandmarks.hpp"
 #include "RoadMapReader.hpp"
 #include "RoadSegment.hpp"
+#include "RouteFormatter.hpp"
+#include "SearchStats.hpp"
+#include "SearchStatsSummary.hpp"
+#include "ShortestPathTree.hpp"
 #include "Trip.hpp"
 #include "TripMetric.hpp"
 #include "TripReader.hpp"
+#include "TripRouter.hpp"
+#include "WorkerPool.hpp"
+#include <fstream>
 #include <map>
 #include <cmath>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <typeinfo>
 #include <vector>
 #include <iomanip>
 
-// time calculations
-void za_warudo_toki_wo_tamare(float toki)
+// one trip and the route found for it, waiting its turn to be printed in --stream mode
+struct road_trip
 {
-	// uncalcalculated hour
-	double hr = toki;
-	// minutes calculated from hour
-	double min = toki*60;
-
-	// floored hour
-	double fHour = floor(hr);
-	// floored minute
-	double fMin = floor((hr-fHour)*60);
-	// calculated seconds remainder
-	double fSec = (((hr-fHour)*60)-fMin)*60;
-
-	// if hour isn't 0
-	if (hr >= 1)
+	// where from + where to + how
+	Trip ride;
+	// how to get there // or not
+	ShortestPath directions;
+	// how hard it was to find // only with --stats
+	SearchStats effort;
+};
+
+int main(int argc, char** argv)
+{
+	// cin + cout on their own buffers instead of going through C's one char at a time
+	std::ios::sync_with_stdio(false);
+
+	// command line // nothing on it means the same old stdin-to-stdout run
+	ProgramOptions Knobs;
+	try
 	{
-		std::cout << std::fixed << std::setprecision(0) << hr << " hours " << std::fixed << std::setprecision(0) << fMin << " minutes " << std::fixed << std::setprecision(2) << fSec << " seconds";
+		Knobs = readProgramOptions(argc, argv);
 	}
-	// if hour is 0 and min isnt 0
-	else if (!(hr >= 1) && min >= 1)
+	catch (ProgramOptionsException& e)
 	{
-		std::cout << std::fixed << std::setprecision(0) << fMin << " min " << std::fixed << std::setprecision(2) << fSec << " seconds";
+		std::cerr << e.what() << std::endl;
+		return 1;
 	}
-	// else just use seconds
-	else
+
+	// Input stream
+	InputReader InTheZone = InputReader(std::cin);
+	
+	// how many at once // one by default, which runs everything in order
+	WorkerPool Crew{Knobs.threadCount};
+
+	// Map // road segments are parsed by the whole crew
+	RoadMapReader WhoNeedsAMap{Crew};
+	
+	// Actual Map // frozen once it's loaded, since all we do from here is query it
+	CompactRoadMap Mappo;
+
+	// straight from an image if there is one // no parsing, just copying
+	try
 	{
-		std::cout << std::fixed << std::setprecision(2) << fSec << " seconds";
+		if (!Knobs.readImagePath.empty())
+		{
+			Mappo = MappedRoadMap{Knobs.readImagePath}.toCompactRoadMap();
+		}
+		// somebody else's map // big, so the crew splits up the parsing
+		else if (!Knobs.dimacsPath.empty())
+		{
+			Mappo = DimacsReader{Crew}.readRoadMap(Knobs.dimacsPath, Knobs.dimacsTimesPath, Knobs.dimacsCoordinatesPath);
+		}
+		else
+		{
+			// the editable map is just a stepping stone, so it's built in an
+			// arena and thrown away all at once when the snapshot is taken
+			DigraphArena Sandbox;
+			Mappo = CompactRoadMap{WhoNeedsAMap.readRoadMap(InTheZone, &Sandbox)};
+		}
+	}
+	catch (MappedFileException& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	catch (DigraphException& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
 	}
-}
 
+	// image, if asked for // parse the text once, then never again
+	if (!Knobs.writeImagePath.empty())
+	{
+		std::ofstream Snapshot{Knobs.writeImagePath, std::ios::binary};
+		RoadMapImageWriter{}.writeRoadMapImage(Snapshot, Mappo);
 
-// struct to keep track of street + metric
-struct vertigo_tech
-{
-	// street name
-	std::string OnevOneMeHereFoo;
-	// miles
-	double whyHaventWeSwitched2MetricSystemYet;
-	// mph // could be blank
-	double stillWaitingOnMetrics;
-	// time // could be blank
-	double TimeIsRelative;
-};
+		if (!Snapshot)
+		{
+			std::cerr << "Could not write " << Knobs.writeImagePath << std::endl;
+			return 1;
+		}
+		// preprocessing only, no trips to read
+		return 0;
+	}
+	
+	// picks contraction hierarchies, a partition overlay, A* with landmarks,
+	// A* with coordinates, or bidirectional Dijkstra
+	TripRouter Uber{Mappo};
 
-// Dijkstra Algorithm input weight for distance
-double Paff(const RoadSegment& roadkill)
-{
-	// return the miles from road segment
-	return roadkill.miles;
-}
+	// landmarks, if asked for // building them is the slow part, so they can be
+	// built once, saved, and read back in on later runs
+	try
+	{
+		if (!Knobs.writeLandmarksPath.empty())
+		{
+			std::ofstream Vault{Knobs.writeLandmarksPath, std::ios::binary};
+			RoadMapLandmarks::build(Mappo, Knobs.landmarkCount).write(Vault);
 
-// Dijkstra Algorithm input weight for time
-double Timm(const RoadSegment& roadkill)
-{
-	// return hour // mi/hr / mi = hr
-	return (roadkill.miles / roadkill.milesPerHour);
-}
+			if (!Vault)
+			{
+				std::cerr << "Could not write " << Knobs.writeLandmarksPath << std::endl;
+				return 1;
+			}
+			// preprocessing only, no trips to read
+			return 0;
+		}
+		else if (!Knobs.readLandmarksPath.empty())
+		{
+			std::ifstream Vault{Knobs.readLandmarksPath, std::ios::binary};
+			Uber.useLandmarks(RoadMapLandmarks::read(Vault));
+		}
+		else if (Knobs.landmarkCount > 0)
+		{
+			Uber.useLandmarks(RoadMapLandmarks::build(Mappo, Knobs.landmarkCount));
+		}
+
+		// shortcuts for the whole map // slow to build, then every trip is quick
+		if (Knobs.contract)
+		{
+			Uber.useContractionHierarchies();
+		}
+
+		// cells + cliques // the cells are shared by both metrics
+		if (Knobs.overlay)
+		{
+			Uber.useOverlay(ProgramOptions::overlayCellSizes);
+		}
+	}
+	catch (DigraphException& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	// scratch space for each worker, so they never share a search
+	std::vector<TripRouterSearch> Desks(Crew.workerCount());
+
+	// how the routes come out // text by default, same as it ever was
+	RouteFormatter Scribe{Mappo, Knobs.output};
+
+	// --stats // every trip's search, summed up at the end on stderr
+	SearchStatsSummary Receipts;
+
+	// one trip at a time, answered as soon as it shows up // only a window's worth
+	// of trips is ever held, however many come in
+	if (Knobs.stream)
+	{
+		// trips as they arrive
+		TripStream Conveyor{InTheZone};
+
+		runOrderedPipeline<Trip, road_trip>(
+			Crew, ProgramOptions::streamWindow * Crew.workerCount(),
+			[&](Trip& ride)
+			{
+				return Conveyor.next(ride);
+			},
+			[&](const Trip& ride, int worker)
+			{
+				road_trip done{ride, {}, {}};
+				if (Knobs.stats)
+				{
+					done.directions = Uber.route(ride, Desks[worker], done.effort);
+				}
+				else
+				{
+					done.directions = Uber.route(ride, Desks[worker]);
+				}
+				return done;
+			},
+			[&](const road_trip& done)
+			{
+				if (Knobs.stats)
+				{
+					Receipts.add(done.effort);
+				}
+
+				// out the door right away, someone's waiting on it
+				Scribe.format(done.ride, done.directions);
+				Scribe.writeTo(std::cout);
+				std::cout.flush();
+			});
+
+		if (Knobs.stats)
+		{
+			Receipts.write(std::cerr);
+		}
+		return 0;
+	}
 
-int main()
-{
-	// Input stream
-	InputReader InTheZone = InputReader(std::cin);
-	
-	// Map
-	RoadMapReader WhoNeedsAMap;
-	
-	// Actual Map
-	RoadMap Mappo = WhoNeedsAMap.readRoadMap(InTheZone);
-	
 	// Trip
 	TripReader DontTripBruh;
 	
 	// Actual Trips
 	std::vector<Trip> WhyUTrippingBro = DontTripBruh.readTrips(InTheZone);
-	
-	// Iterate through the trips
-	for (std::vector<Trip>::iterator dirks = WhyUTrippingBro.begin(); dirks != WhyUTrippingBro.end(); ++dirks)
-	{
-		// vector to iterate through to get struct of street name + metric
-		std::vector<vertigo_tech> Trippin;
-		std::map<int, int> pathfinder;
-		// total distance
-		double HowMuchURun = 0;
-		// total time
-		double HowFastUGoing = 0;
-		// Starting point of route
-		int start = dirks->startVertex;
-		// end point of route
-		int end = dirks->endVertex;
-
-		// Distance condition
-		if (dirks->metric == TripMetric::Distance)
-		{
-			// Print start
-			std::cout << "Shortest distance from " << Mappo.vertexInfo(start) << " to " << Mappo.vertexInfo(end) << ":" << std::endl;
 
-			// Dijkstra map for distance
-			pathfinder = Mappo.findShortestPaths(dirks->startVertex, Paff);
+	// trips from the same place share one search
+	std::vector<std::vector<std::size_t>> Carpools = TripRouter::groupTrips(WhyUTrippingBro);
 
-			std::cout << "	Begin at " << Mappo.vertexInfo(start) << std::endl;
+	// each trip's route goes in its own spot, Atlas[i] for WhyUTrippingBro[i]
+	std::vector<ShortestPath> Atlas(WhyUTrippingBro.size());
 
-			// Back track the algorithm to find shortest path
-			while (end != start)
+	// and its search's stats in Effort[i], but only with --stats
+	std::vector<SearchStats> Effort(Knobs.stats ? WhyUTrippingBro.size() : 0);
+
+	Crew.run(
+		Carpools.size(),
+		[&](int carpool, int worker)
+		{
+			const std::vector<std::size_t>& riders = Carpools[carpool];
+			std::vector<ShortestPath> Directions;
+			std::vector<SearchStats> Receipt;
+
+			if (Knobs.stats)
 			{
-				// Total distance
-				HowMuchURun += Mappo.edgeInfo(pathfinder[end], end).miles;
-				// push the struct of information for each edge
-				// only street + miles
-				Trippin.push_back(vertigo_tech{
-					.OnevOneMeHereFoo = Mappo.vertexInfo(end), 
-					.whyHaventWeSwitched2MetricSystemYet = Mappo.edgeInfo(pathfinder[end], end).miles});
-				// make end equal to its predecessor
-				end = pathfinder[end];
+				Directions = Uber.routeGroup(WhyUTrippingBro, riders, Desks[worker], Receipt);
 			}
-			// printing the vector backwards because it was pushed in backwards
-			for (std::vector<vertigo_tech>::reverse_iterator itr = Trippin.rbegin(); itr != Trippin.rend(); ++itr)
+			else
 			{
-				std::cout << "	Continue to " << itr->OnevOneMeHereFoo << " (" << itr->whyHaventWeSwitched2MetricSystemYet << " miles)" << std::endl;
+				Directions = Uber.routeGroup(WhyUTrippingBro, riders, Desks[worker]);
 			}
-			// printing total distance
-			std::cout << "Total distance: " << HowMuchURun << " miles" << std::endl;
-		}
-		// Time Condition by default
-		else
-		{
-			// Print Start
-			std::cout << "Shortest driving time from " << Mappo.vertexInfo(start) << " to " << Mappo.vertexInfo(end) << ":" << std::endl;
-			
-			// Dijkstra Map for Time
-			pathfinder = Mappo.findShortestPaths(dirks->startVertex, Timm);
-
-			std::cout << "	Begin at " << Mappo.vertexInfo(start) << std::endl;
 
-			// Back track the algorithm to find shortest timed path
-			while (end != start)
+			for (std::size_t i = 0; i < riders.size(); ++i)
 			{
-				// total time
-				HowFastUGoing += ((Mappo.edgeInfo(pathfinder[end], end).miles)/Mappo.edgeInfo(pathfinder[end], end).milesPerHour);
-				// push the struct of information for each edge
-				// street + miles + mph + time
-				Trippin.push_back(vertigo_tech{
-					.OnevOneMeHereFoo = Mappo.vertexInfo(end), 
-					.whyHaventWeSwitched2MetricSystemYet = Mappo.edgeInfo(pathfinder[end], end).miles,
-					.stillWaitingOnMetrics = Mappo.edgeInfo(pathfinder[end], end).milesPerHour,
-					.TimeIsRelative = ((Mappo.edgeInfo(pathfinder[end], end).miles)/Mappo.edgeInfo(pathfinder[end], end).milesPerHour)});
-				// make end equal to its predecessor
-				end = pathfinder[end];				
+				Atlas[riders[i]] = std::move(Directions[i]);
+				if (Knobs.stats)
+				{
+					Effort[riders[i]] = Receipt[i];
+				}
 			}
+		});
 
-			// printing the vector backwards because it was pushed in backwards
-			for (std::vector<vertigo_tech>::reverse_iterator itr = Trippin.rbegin(); itr != Trippin.rend(); ++itr)
-			{
-				std::cout << "	Continue to " << itr->OnevOneMeHereFoo << " (" << itr->whyHaventWeSwitched2MetricSystemYet << " miles @ " << 
-				itr->stillWaitingOnMetrics << "mph = ";
-				za_warudo_toki_wo_tamare(itr->TimeIsRelative);
-				std::cout << ")" << std::endl;
-			}
-			// printing total distance
-			std::cout << "Total time: ";
-			za_warudo_toki_wo_tamare(HowFastUGoing);
-			std::cout << std::endl;
+	// everything back out in the order it came in, a big block at a time
+	for (std::size_t i = 0; i < WhyUTrippingBro.size(); ++i)
+	{
+		Scribe.format(WhyUTrippingBro[i], Atlas[i]);
+		// done with it // no need to hang onto it
+		Atlas[i] = ShortestPath{};
+
+		if (Scribe.size() >= ProgramOptions::outputBlockSize)
+		{
+			Scribe.writeTo(std::cout);
 		}
-		// new line to separate trips
-		std::cout << std::endl;
+	}
+	Scribe.writeTo(std::cout);
 
+	// the whole batch at once // percentiles need everything
+	if (Knobs.stats)
+	{
+		for (const SearchStats& receipt : Effort)
+		{
+			Receipts.add(receipt);
+		}
+		Receipts.write(std::cerr);
 	}
 
 
@@ -0,0 +1,286 @@
+// DigraphBenchmarks.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Benchmarks for the network generators themselves, for each Digraph
+// operation, and for the searches that CompactDigraph adds, each on every
+// kind of generated network.  Items processed are vertices, edges, or
+// searches, whichever the operation works through.
+
+#include <random>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "EdgeWeightColumn.hpp"
+#include "RoadMap.hpp"
+#include "RoadBenchmark.hpp"
+#include "RoadNetworkGenerators.hpp"
+#include "ShortestPathTree.hpp"
+#include "TripWeights.hpp"
+
+
+namespace
+{
+    // how many lookups, removals, or searches are done per iteration
+    const int batchSize = 1000;
+
+    const unsigned int querySeed = 1978;
+
+
+    // batchSize different vertex numbers picked at random
+    std::vector<int> randomVertices(const RoadNetwork& network)
+    {
+        std::mt19937 random{querySeed};
+        std::uniform_int_distribution<int> vertex{0, static_cast<int>(network.locations.size()) - 1};
+        std::unordered_set<int> picked;
+        std::vector<int> vertices;
+
+        while (static_cast<int>(vertices.size()) < batchSize)
+        {
+            int v = vertex(random);
+
+            if (picked.insert(v).second)
+            {
+                vertices.push_back(v);
+            }
+        }
+
+        return vertices;
+    }
+
+
+    // the vertices alone, with no edges
+    RoadMap verticesOnly(const RoadNetwork& network)
+    {
+        RoadMap roadMap;
+
+        for (std::size_t i = 0; i < network.locations.size(); ++i)
+        {
+            roadMap.addVertex(i, network.locations[i]);
+        }
+
+        return roadMap;
+    }
+}
+
+
+void BM_GenerateNetwork(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    std::size_t edges = 0;
+
+    for (auto _ : state)
+    {
+        RoadNetwork network = generator(state.range(0), querySeed);
+        edges = network.roads.size();
+        benchmark::DoNotOptimize(network);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["edges"] = edges;
+}
+
+
+void BM_DigraphAddVertex(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    const RoadNetwork& network = cachedNetwork(generator, state.range(0));
+
+    for (auto _ : state)
+    {
+        RoadMap roadMap;
+
+        for (std::size_t i = 0; i < network.locations.size(); ++i)
+        {
+            roadMap.addVertex(i, network.locations[i]);
+        }
+
+        // tearing it down isn't part of it
+        state.PauseTiming();
+        roadMap = RoadMap{};
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * network.locations.size());
+}
+
+
+void BM_DigraphAddEdge(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    const RoadNetwork& network = cachedNetwork(generator, state.range(0));
+    RoadMap empty = verticesOnly(network);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        RoadMap roadMap = empty;
+        state.ResumeTiming();
+
+        for (const auto& road : network.roads)
+        {
+            roadMap.addEdge(road.fromVertex, road.toVertex, road.einfo);
+        }
+
+        state.PauseTiming();
+        roadMap = RoadMap{};
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * network.roads.size());
+}
+
+
+void BM_DigraphFromEdgeList(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    const RoadNetwork& network = cachedNetwork(generator, state.range(0));
+
+    for (auto _ : state)
+    {
+        RoadMap roadMap = network.toRoadMap();
+
+        state.PauseTiming();
+        roadMap = RoadMap{};
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * network.roads.size());
+}
+
+
+void BM_DigraphEdgeInfo(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    const RoadNetwork& network = cachedNetwork(generator, state.range(0));
+    RoadMap roadMap = network.toRoadMap();
+
+    std::mt19937 random{querySeed};
+    std::uniform_int_distribution<std::size_t> road{0, network.roads.size() - 1};
+    std::vector<std::pair<int, int>> queries(batchSize);
+
+    for (auto& query : queries)
+    {
+        const auto& picked = network.roads[road(random)];
+        query = {picked.fromVertex, picked.toVertex};
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            benchmark::DoNotOptimize(roadMap.edgeInfo(query.first, query.second));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+
+void BM_DigraphRemoveVertex(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    const RoadNetwork& network = cachedNetwork(generator, state.range(0));
+    RoadMap original = network.toRoadMap();
+    std::vector<int> victims = randomVertices(network);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        RoadMap roadMap = original;
+        state.ResumeTiming();
+
+        for (int v : victims)
+        {
+            roadMap.removeVertex(v);
+        }
+
+        state.PauseTiming();
+        roadMap = RoadMap{};
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * victims.size());
+}
+
+
+void BM_DigraphFindShortestPaths(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    const RoadNetwork& network = cachedNetwork(generator, state.range(0));
+    RoadMap roadMap = network.toRoadMap();
+    std::vector<int> starts = randomVertices(network);
+
+    ShortestPathTree tree;
+    std::size_t next = 0;
+
+    for (auto _ : state)
+    {
+        roadMap.findShortestPaths(starts[next], TripWeight<TripMetric::Time>{}, tree);
+        next = (next + 1) % starts.size();
+    }
+
+    state.SetItemsProcessed(state.iterations() * network.locations.size());
+}
+
+
+void BM_DigraphIsStronglyConnected(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    const RoadNetwork& network = cachedNetwork(generator, state.range(0));
+    RoadMap roadMap = network.toRoadMap();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(roadMap.isStronglyConnected());
+    }
+
+    state.SetItemsProcessed(state.iterations() * network.locations.size());
+}
+
+
+void BM_CompactFindShortestPaths(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    const RoadNetwork& network = cachedNetwork(generator, state.range(0));
+    CompactRoadMap roadMap = network.toCompactRoadMap();
+    EdgeWeightColumn hours = EdgeWeightColumn::build(roadMap, TripWeight<TripMetric::Time>{});
+    std::vector<int> starts = randomVertices(network);
+
+    ShortestPathTree tree;
+    std::size_t next = 0;
+
+    for (auto _ : state)
+    {
+        roadMap.findShortestPaths(starts[next], hours, tree);
+        next = (next + 1) % starts.size();
+    }
+
+    state.SetItemsProcessed(state.iterations() * network.locations.size());
+}
+
+
+void BM_CompactFindShortestPathBidirectional(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    const RoadNetwork& network = cachedNetwork(generator, state.range(0));
+    CompactRoadMap roadMap = network.toCompactRoadMap();
+    EdgeWeightColumn hours = EdgeWeightColumn::build(roadMap, TripWeight<TripMetric::Time>{});
+    std::vector<Trip> trips = network.randomTrips(batchSize, querySeed);
+
+    BidirectionalSearchSpace space;
+    std::size_t next = 0;
+
+    for (auto _ : state)
+    {
+        const Trip& trip = trips[next];
+        benchmark::DoNotOptimize(roadMap.findShortestPathBidirectional(trip.startVertex, trip.endVertex, hours, space));
+        next = (next + 1) % trips.size();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+ROAD_NETWORK_BENCHMARK(BM_GenerateNetwork, forEverySize);
+ROAD_NETWORK_BENCHMARK(BM_DigraphAddVertex, forEverySlowSize);
+ROAD_NETWORK_BENCHMARK(BM_DigraphAddEdge, forEverySlowSize);
+ROAD_NETWORK_BENCHMARK(BM_DigraphFromEdgeList, forEverySlowSize);
+ROAD_NETWORK_BENCHMARK(BM_DigraphEdgeInfo, forEverySlowSize);
+ROAD_NETWORK_BENCHMARK(BM_DigraphRemoveVertex, forEverySlowSize);
+ROAD_NETWORK_BENCHMARK(BM_DigraphFindShortestPaths, forEverySlowSize);
+ROAD_NETWORK_BENCHMARK(BM_DigraphIsStronglyConnected, forEverySlowSize);
+ROAD_NETWORK_BENCHMARK(BM_CompactFindShortestPaths, forEverySize);
+ROAD_NETWORK_BENCHMARK(BM_CompactFindShortestPathBidirectional, forEverySize);
@@ -0,0 +1,111 @@
+// PipelineBenchmarks.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Benchmarks for the whole program, run the way main() runs it by default:
+// read a map and trips from text, freeze the map, route every trip, and
+// format the routes.  The map is read on its own, too, since for one-shot
+// runs that's often where most of the time goes.
+
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "InputReader.hpp"
+#include "RoadMap.hpp"
+#include "RoadMapReader.hpp"
+#include "RoadBenchmark.hpp"
+#include "RoadNetworkGenerators.hpp"
+#include "RouteFormatter.hpp"
+#include "TripReader.hpp"
+#include "TripRouter.hpp"
+
+
+namespace
+{
+    // how many trips each run of the program answers
+    const int tripsPerRun = 1000;
+
+    const unsigned int tripSeed = 2019;
+
+
+    // a stream buffer that throws away everything written to it, so the
+    // output costs only what formatting it costs
+    class DiscardBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) override
+        {
+            return c;
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize count) override
+        {
+            return count;
+        }
+    };
+
+
+    // the program's whole input for the network
+    std::string inputFor(const RoadNetwork& network)
+    {
+        std::ostringstream text;
+        network.writeText(text, network.randomTrips(tripsPerRun, tripSeed));
+        return text.str();
+    }
+}
+
+
+void BM_ReadRoadMap(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    std::string input = inputFor(cachedNetwork(generator, state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::istringstream in{input};
+        InputReader reader{in};
+        CompactRoadMap roadMap{RoadMapReader{}.readRoadMap(reader)};
+        benchmark::DoNotOptimize(roadMap);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+
+void BM_TripPipeline(benchmark::State& state, RoadNetworkGenerator generator)
+{
+    std::string input = inputFor(cachedNetwork(generator, state.range(0)));
+
+    DiscardBuffer discard;
+    std::ostream out{&discard};
+
+    for (auto _ : state)
+    {
+        std::istringstream in{input};
+        InputReader reader{in};
+        CompactRoadMap roadMap{RoadMapReader{}.readRoadMap(reader)};
+
+        TripRouter router{roadMap};
+        TripRouterSearch search;
+
+        std::vector<Trip> trips = TripReader{}.readTrips(reader);
+        std::vector<ShortestPath> routes = router.routeAll(trips, search);
+
+        RouteFormatter formatter{roadMap, RouteFormat::Text};
+
+        for (std::size_t i = 0; i < trips.size(); ++i)
+        {
+            formatter.format(trips[i], routes[i]);
+        }
+
+        formatter.writeTo(out);
+    }
+
+    state.SetItemsProcessed(state.iterations() * tripsPerRun);
+}
+
+
+ROAD_NETWORK_BENCHMARK(BM_ReadRoadMap, forEverySize);
+ROAD_NETWORK_BENCHMARK(BM_TripPipeline, forEverySize);
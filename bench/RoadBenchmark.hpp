@@ -0,0 +1,57 @@
+// RoadBenchmark.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// What every benchmark on a generated road network has in common: the
+// sizes of the networks, which go up by factors of ten from a thousand
+// locations to ROADBENCH_MAX_VERTICES (operations that are slow for their
+// size, such as building a Digraph one vertex and edge at a time, stop a
+// factor of ten sooner), and a way to register a benchmark once for every
+// kind of network.
+
+#ifndef ROADBENCHMARK_HPP
+#define ROADBENCHMARK_HPP
+
+#include <benchmark/benchmark.h>
+#include "RoadNetworkGenerators.hpp"
+
+
+#ifndef ROADBENCH_MAX_VERTICES
+#define ROADBENCH_MAX_VERTICES 1000000
+#endif
+
+
+namespace BenchmarkSizes
+{
+    const int smallest = 1000;
+    const int largest = ROADBENCH_MAX_VERTICES;
+    const int largestSlow = largest / 10 > smallest ? largest / 10 : smallest;
+}
+
+
+// forEverySize() and forEverySlowSize() apply the ranges above to a
+// benchmark, as in BENCHMARK(...)->Apply(forEverySize).
+inline void forEverySize(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(10)->Range(BenchmarkSizes::smallest, BenchmarkSizes::largest)->Unit(benchmark::kMillisecond);
+}
+
+
+inline void forEverySlowSize(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(10)->Range(BenchmarkSizes::smallest, BenchmarkSizes::largestSlow)->Unit(benchmark::kMillisecond);
+}
+
+
+
+// ROAD_NETWORK_BENCHMARK() registers a benchmark that takes a
+// RoadNetworkGenerator once for each kind of network, over the given sizes.
+#define ROAD_NETWORK_BENCHMARK(function, sizes) \
+    BENCHMARK_CAPTURE(function, grid, makeGridNetwork)->Apply(sizes); \
+    BENCHMARK_CAPTURE(function, geometric, makeRandomGeometricNetwork)->Apply(sizes); \
+    BENCHMARK_CAPTURE(function, highway, makeHighwayNetwork)->Apply(sizes)
+
+
+
+#endif // ROADBENCHMARK_HPP
@@ -0,0 +1,389 @@
+// RoadNetworkGenerators.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <string>
+#include "RoadNetworkGenerators.hpp"
+
+
+namespace
+{
+    // the patch of the map every network is placed in
+    const double southEdge = 33.5;
+    const double westEdge = -118.5;
+    const double patchDegrees = 1.0;
+
+    const unsigned int cachedSeed = 46;
+
+
+    // locations are named "Place 0", "Place 1", and so on
+    Location makeLocation(int number, double latitude, double longitude)
+    {
+        return Location{"Place " + std::to_string(number), true, latitude, longitude};
+    }
+
+
+    // adds a road from a to b, somewhat longer than the straight line
+    // between them
+    void addRoad(
+        RoadNetwork& network, int a, int b, double milesPerHour,
+        std::mt19937& random)
+    {
+        std::uniform_real_distribution<double> detour{1.0, 1.3};
+
+        double miles = greatCircleMiles(network.locations[a], network.locations[b]) * detour(random) + 0.001;
+        network.roads.push_back({a, b, RoadSegment{miles, milesPerHour}});
+    }
+
+
+    void addTwoWayRoad(
+        RoadNetwork& network, int a, int b, double milesPerHour,
+        std::mt19937& random)
+    {
+        addRoad(network, a, b, milesPerHour, random);
+        addRoad(network, b, a, milesPerHour, random);
+    }
+
+
+    // picks one of the given speeds at random
+    double pickSpeed(std::mt19937& random, std::initializer_list<double> speeds)
+    {
+        std::uniform_int_distribution<int> which{0, static_cast<int>(speeds.size()) - 1};
+        return speeds.begin()[which(random)];
+    }
+
+
+    // the side of the smallest square grid with at least vertexCount
+    // locations
+    int gridSide(int vertexCount)
+    {
+        return std::ceil(std::sqrt(static_cast<double>(std::max(vertexCount, 4))));
+    }
+
+
+    // places side * side locations in rows, numbered from the south west
+    void placeGrid(RoadNetwork& network, int side)
+    {
+        double spacing = patchDegrees / side;
+        network.locations.reserve(side * side);
+
+        for (int row = 0; row < side; ++row)
+        {
+            for (int column = 0; column < side; ++column)
+            {
+                network.locations.push_back(
+                    makeLocation(row * side + column, southEdge + row * spacing, westEdge + column * spacing));
+            }
+        }
+    }
+}
+
+
+RoadMap RoadNetwork::toRoadMap() const
+{
+    std::vector<std::pair<int, Location>> vertices;
+    vertices.reserve(locations.size());
+
+    for (std::size_t i = 0; i < locations.size(); ++i)
+    {
+        vertices.emplace_back(i, locations[i]);
+    }
+
+    return RoadMap::fromEdgeList(std::move(vertices), roads);
+}
+
+
+CompactRoadMap RoadNetwork::toCompactRoadMap() const
+{
+    int n = locations.size();
+
+    // counting sort by "from", then each row by "to"
+    std::vector<int> offsets(n + 1, 0);
+
+    for (const auto& road : roads)
+    {
+        ++offsets[road.fromVertex + 1];
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<int> order(roads.size());
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+
+    for (std::size_t r = 0; r < roads.size(); ++r)
+    {
+        order[next[roads[r].fromVertex]++] = r;
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        std::sort(
+            order.begin() + offsets[i], order.begin() + offsets[i + 1],
+            [this](int a, int b)
+            {
+                return roads[a].toVertex < roads[b].toVertex;
+            });
+    }
+
+    std::vector<int> vertexNumbers(n);
+    std::vector<int> targets(roads.size());
+    std::vector<RoadSegment> segments(roads.size());
+
+    for (int i = 0; i < n; ++i)
+    {
+        vertexNumbers[i] = i;
+    }
+
+    for (std::size_t e = 0; e < order.size(); ++e)
+    {
+        targets[e] = roads[order[e]].toVertex;
+        segments[e] = roads[order[e]].einfo;
+    }
+
+    return CompactRoadMap::fromArrays(
+        std::move(vertexNumbers), locations, std::move(offsets), std::move(targets), std::move(segments));
+}
+
+
+std::vector<Trip> RoadNetwork::randomTrips(int count, unsigned int seed) const
+{
+    std::mt19937 random{seed};
+    std::uniform_int_distribution<int> vertex{0, static_cast<int>(locations.size()) - 1};
+
+    std::vector<Trip> trips;
+    trips.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        int start = vertex(random);
+        int end = vertex(random);
+        trips.push_back({start, end, i % 2 == 0 ? TripMetric::Distance : TripMetric::Time});
+    }
+
+    return trips;
+}
+
+
+void RoadNetwork::writeText(std::ostream& out, const std::vector<Trip>& trips) const
+{
+    out.precision(17);
+
+    out << locations.size() << '\n';
+
+    for (const Location& location : locations)
+    {
+        out << location.name << " @ " << location.latitude << ' ' << location.longitude << '\n';
+    }
+
+    out << roads.size() << '\n';
+
+    for (const auto& road : roads)
+    {
+        out << road.fromVertex << ' ' << road.toVertex << ' '
+            << road.einfo.miles << ' ' << road.einfo.milesPerHour << '\n';
+    }
+
+    out << trips.size() << '\n';
+
+    for (const Trip& trip : trips)
+    {
+        out << trip.startVertex << ' ' << trip.endVertex << ' '
+            << (trip.metric == TripMetric::Distance ? 'D' : 'T') << '\n';
+    }
+}
+
+
+RoadNetwork makeGridNetwork(int vertexCount, unsigned int seed)
+{
+    std::mt19937 random{seed};
+    RoadNetwork network;
+
+    int side = gridSide(vertexCount);
+    placeGrid(network, side);
+    network.roads.reserve(4 * side * side);
+
+    for (int row = 0; row < side; ++row)
+    {
+        for (int column = 0; column < side; ++column)
+        {
+            int v = row * side + column;
+
+            if (column + 1 < side)
+            {
+                addTwoWayRoad(network, v, v + 1, pickSpeed(random, {25, 35, 45}), random);
+            }
+
+            if (row + 1 < side)
+            {
+                addTwoWayRoad(network, v, v + side, pickSpeed(random, {25, 35, 45}), random);
+            }
+        }
+    }
+
+    return network;
+}
+
+
+RoadNetwork makeRandomGeometricNetwork(int vertexCount, unsigned int seed)
+{
+    std::mt19937 random{seed};
+    std::uniform_real_distribution<double> coordinate{0.0, patchDegrees};
+    RoadNetwork network;
+
+    int n = std::max(vertexCount, 2);
+    network.locations.reserve(n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        network.locations.push_back(makeLocation(i, southEdge + coordinate(random), westEdge + coordinate(random)));
+    }
+
+    // in a patch of area A, n * pi * r^2 / A neighbors fall within r
+    const double neighbors = 6.0;
+    double radius = patchDegrees * std::sqrt(neighbors / (3.14159265358979323846 * n));
+
+    // each location only has to be compared to the ones in its own bucket
+    // and the buckets around it
+    int buckets = std::max(1, static_cast<int>(patchDegrees / radius));
+    std::vector<std::vector<int>> grid(buckets * buckets);
+
+    auto bucketOf =
+        [&](double degrees)
+        {
+            return std::min(buckets - 1, static_cast<int>(degrees / patchDegrees * buckets));
+        };
+
+    for (int i = 0; i < n; ++i)
+    {
+        const Location& location = network.locations[i];
+        grid[bucketOf(location.latitude - southEdge) * buckets + bucketOf(location.longitude - westEdge)].push_back(i);
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        const Location& a = network.locations[i];
+        int row = bucketOf(a.latitude - southEdge);
+        int column = bucketOf(a.longitude - westEdge);
+
+        for (int r = std::max(0, row - 1); r <= std::min(buckets - 1, row + 1); ++r)
+        {
+            for (int c = std::max(0, column - 1); c <= std::min(buckets - 1, column + 1); ++c)
+            {
+                for (int j : grid[r * buckets + c])
+                {
+                    const Location& b = network.locations[j];
+                    double dLat = a.latitude - b.latitude;
+                    double dLon = a.longitude - b.longitude;
+
+                    // each pair once, from its lower number
+                    if (j > i && dLat * dLat + dLon * dLon <= radius * radius)
+                    {
+                        addTwoWayRoad(network, i, j, pickSpeed(random, {25, 35, 45, 55}), random);
+                    }
+                }
+            }
+        }
+    }
+
+    return network;
+}
+
+
+RoadNetwork makeHighwayNetwork(int vertexCount, unsigned int seed)
+{
+    std::mt19937 random{seed};
+    std::uniform_real_distribution<double> chance{0.0, 1.0};
+    RoadNetwork network;
+
+    int side = gridSide(vertexCount);
+    placeGrid(network, side);
+    network.roads.reserve(5 * side * side);
+
+    // local streets, one in ten of them one way
+    for (int row = 0; row < side; ++row)
+    {
+        for (int column = 0; column < side; ++column)
+        {
+            int v = row * side + column;
+
+            for (int w : {column + 1 < side ? v + 1 : -1, row + 1 < side ? v + side : -1})
+            {
+                if (w == -1)
+                {
+                    continue;
+                }
+
+                double milesPerHour = pickSpeed(random, {25, 30, 35});
+
+                if (chance(random) < 0.1)
+                {
+                    // alternate directions, so one-way streets don't strand anyone
+                    if ((row + column) % 2 == 0)
+                    {
+                        addRoad(network, v, w, milesPerHour, random);
+                    }
+                    else
+                    {
+                        addRoad(network, w, v, milesPerHour, random);
+                    }
+                }
+                else
+                {
+                    addTwoWayRoad(network, v, w, milesPerHour, random);
+                }
+            }
+        }
+    }
+
+    // highways every sixteenth row and column, straight from one
+    // interchange to the next
+    const int spacing = 16;
+
+    for (int row = 0; row < side; row += spacing)
+    {
+        for (int column = 0; column < side; column += spacing)
+        {
+            int v = row * side + column;
+
+            if (column + spacing < side)
+            {
+                addTwoWayRoad(network, v, v + spacing, 65, random);
+            }
+
+            if (row + spacing < side)
+            {
+                addTwoWayRoad(network, v, v + spacing * side, 65, random);
+            }
+        }
+    }
+
+    return network;
+}
+
+
+const RoadNetwork& cachedNetwork(RoadNetworkGenerator generator, int vertexCount)
+{
+    static RoadNetworkGenerator lastGenerator = nullptr;
+    static int lastVertexCount = -1;
+    static std::unique_ptr<RoadNetwork> last;
+
+    if (generator != lastGenerator || vertexCount != lastVertexCount)
+    {
+        // the old one goes first, so the two are never held at once
+        last.reset();
+        last = std::make_unique<RoadNetwork>(generator(vertexCount, cachedSeed));
+        lastGenerator = generator;
+        lastVertexCount = vertexCount;
+    }
+
+    return *last;
+}
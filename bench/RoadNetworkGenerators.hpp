@@ -0,0 +1,78 @@
+// RoadNetworkGenerators.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Generators for synthetic road networks of any size, for benchmarking.
+// Each one places its locations in a patch of southern California about a
+// degree on a side, gives every location coordinates, and makes every road
+// at least as long as the straight line between its ends, so every
+// technique TripRouter knows about works on them.  The same generator,
+// size, and seed always make the same network.
+//
+// * A grid network is a square grid of two-way streets.
+//
+// * A random geometric network scatters its locations at random and joins
+//   every pair that's close enough with a two-way road, with the distance
+//   chosen so each location has about six neighbors.  Some locations end
+//   up on islands of their own.
+//
+// * A highway network is a grid of slow local streets, a few of them one
+//   way, with a coarser grid of fast highways on top, each of which runs
+//   straight from one interchange to the next.  Like real road networks,
+//   it has a hierarchy that contraction and overlays can take advantage
+//   of.
+
+#ifndef ROADNETWORKGENERATORS_HPP
+#define ROADNETWORKGENERATORS_HPP
+
+#include <ostream>
+#include <utility>
+#include <vector>
+#include "RoadMap.hpp"
+#include "Trip.hpp"
+
+
+
+struct RoadNetwork
+{
+    // locations[i] is vertex number i
+    std::vector<Location> locations;
+    std::vector<DigraphEdgeListEntry<RoadSegment>> roads;
+
+    // toRoadMap() builds a RoadMap out of the network, and
+    // toCompactRoadMap() builds a CompactRoadMap without building a
+    // RoadMap first.
+    RoadMap toRoadMap() const;
+    CompactRoadMap toCompactRoadMap() const;
+
+    // randomTrips() returns count trips between locations chosen at
+    // random, alternating between the two metrics.
+    std::vector<Trip> randomTrips(int count, unsigned int seed) const;
+
+    // writeText() writes the network, followed by the given trips, in the
+    // program's input format.
+    void writeText(std::ostream& out, const std::vector<Trip>& trips) const;
+};
+
+
+
+// A RoadNetworkGenerator makes a network with roughly the given number of
+// locations from the given seed.
+typedef RoadNetwork (*RoadNetworkGenerator)(int vertexCount, unsigned int seed);
+
+
+RoadNetwork makeGridNetwork(int vertexCount, unsigned int seed);
+RoadNetwork makeRandomGeometricNetwork(int vertexCount, unsigned int seed);
+RoadNetwork makeHighwayNetwork(int vertexCount, unsigned int seed);
+
+
+// cachedNetwork() returns the network the given generator makes with the
+// given number of locations and a fixed seed, making it only if the last
+// call didn't ask for the same one, so that a benchmark's setup doesn't
+// swamp its measurements.  The network is good until the next call.
+const RoadNetwork& cachedNetwork(RoadNetworkGenerator generator, int vertexCount);
+
+
+
+#endif // ROADNETWORKGENERATORS_HPP
@@ -0,0 +1,26 @@
+// benchmain.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This launches Google Benchmark and runs every benchmark in the "bench"
+// directory.  The benchmarks are built along with everything in "core" and
+// everything in "app" except its main.cpp.
+//
+// Google Benchmark's own command-line options all work, most usefully
+//
+//     --benchmark_filter=REGEX      run only the benchmarks that match
+//     --benchmark_out=FILE          also write the results to FILE ...
+//     --benchmark_out_format=json   ... as JSON, for comparing builds
+//
+// Two sets of JSON results can be compared with the compare.py tool that
+// comes with Google Benchmark.
+//
+// Networks range from 1,000 to 1,000,000 locations by default.  Building
+// with ROADBENCH_MAX_VERTICES defined as something bigger, such as
+// 10000000, extends the ranges that far, given enough memory.
+
+#include <benchmark/benchmark.h>
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+// AStarSearch.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares searchShortestPathAStar(), which finds a
+// shortest path between two vertices using the A* algorithm.  A* is
+// Dijkstra's algorithm with a sense of direction: each vertex is ordered
+// by its distance from the start *plus* an estimate of its remaining
+// distance to the end, so the search heads toward the end vertex instead
+// of spreading out evenly in every direction.
+//
+// The estimate must never be larger than the true remaining distance, or
+// the path found may not be the shortest one.  An estimate of zero
+// everywhere turns A* back into plain Dijkstra.
+//
+// Like searchShortestPaths(), everything here is in terms of dense vertex
+// indices, and the graph is described by a callback.
+
+#ifndef ASTARSEARCH_HPP
+#define ASTARSEARCH_HPP
+
+#include "ShortestPathTree.hpp"
+
+
+
+// searchShortestPathAStar() searches for a shortest path from the source
+// index to the target index, writing what it finds into the given tree.
+// forEachEdge(v, relax) must call relax(w, weight) for every edge v -> w,
+// and estimate(v) must return a lower bound on the length of a shortest
+// path from index v to the target.  Edge weights must not be negative.
+//
+// When the search is done, the path to the target can be pulled out of the
+// tree with tracePath().  Distances of other vertices are not final.
+
+template <typename ForEachEdge, typename Estimate>
+void searchShortestPathAStar(
+    ShortestPathTree& tree, int indexBound, int sourceIndex, int targetIndex,
+    ForEachEdge forEachEdge, Estimate estimate);
+
+
+
+template <typename ForEachEdge, typename Estimate>
+void searchShortestPathAStar(
+    ShortestPathTree& tree, int indexBound, int sourceIndex, int targetIndex,
+    ForEachEdge forEachEdge, Estimate estimate)
+{
+    SearchStats* stats = tree.queue.stats();
+    SearchPhaseTimer timer{stats};
+
+    tree.reset(indexBound, sourceIndex);
+
+    tree.distance[sourceIndex] = 0.0;
+    tree.queue.push(sourceIndex, estimate(sourceIndex));
+    timer.lap(&SearchStats::initSeconds);
+
+    while (!tree.queue.empty())
+    {
+        int v = tree.queue.pop();
+
+        if (v == targetIndex)
+        {
+            break;
+        }
+
+        double dv = tree.distance[v];
+        countSettled(stats);
+
+        // a vertex that's improved after being popped is simply pushed
+        // again, which keeps the search correct even if the estimate is
+        // admissible but not consistent
+        forEachEdge(
+            v,
+            [&tree, &estimate, stats, v, dv](int w, double weight)
+            {
+                countRelaxed(stats);
+                double dw = dv + weight;
+
+                if (dw < tree.distance[w])
+                {
+                    tree.distance[w] = dw;
+                    tree.predecessor[w] = v;
+                    tree.queue.pushOrDecrease(w, dw + estimate(w));
+                }
+            });
+    }
+
+    timer.lap(&SearchStats::searchSeconds);
+}
+
+
+
+#endif // ASTARSEARCH_HPP
@@ -0,0 +1,187 @@
+// BidirectionalSearch.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares searchShortestPathBidirectional(), which finds
+// a shortest path between two vertices by running Dijkstra's algorithm
+// from both ends at once: forward from the start vertex along outgoing
+// edges, and backward from the end vertex along incoming edges.  The
+// search stops once the two frontiers have met and no shorter path through
+// the unexplored part of the graph is possible, which usually happens
+// after settling roughly half as many vertices as a one-sided search.
+//
+// Like searchShortestPaths(), everything here is in terms of dense vertex
+// indices, and the graph is described by callbacks.
+
+#ifndef BIDIRECTIONALSEARCH_HPP
+#define BIDIRECTIONALSEARCH_HPP
+
+#include <limits>
+#include "ShortestPathTree.hpp"
+
+
+
+// A BidirectionalSearchSpace holds the two halves of a bidirectional
+// search.  In the forward tree, distances are measured from the start
+// vertex and predecessors point back toward it.  In the backward tree,
+// distances are measured to the end vertex and "predecessors" point
+// forward toward it.  Like a ShortestPathTree, it's meant to be reused.
+
+struct BidirectionalSearchSpace
+{
+    ShortestPathTree forward;
+    ShortestPathTree backward;
+};
+
+
+
+// searchShortestPathBidirectional() searches for a shortest path from the
+// source index to the target index.  forEachOutEdge(v, relax) must call
+// relax(w, weight) for every edge v -> w, and forEachInEdge(w, relax) must
+// call relax(v, weight) for every edge v -> w.  Edge weights must not be
+// negative.
+//
+// It returns the index of a vertex on a shortest path (the "meeting
+// vertex"), or -1 if there is no path at all.
+
+template <typename ForEachOutEdge, typename ForEachInEdge>
+int searchShortestPathBidirectional(
+    BidirectionalSearchSpace& space, int indexBound,
+    int sourceIndex, int targetIndex,
+    ForEachOutEdge forEachOutEdge, ForEachInEdge forEachInEdge);
+
+
+// traceBidirectionalPath() puts together the path found by a bidirectional
+// search that met at the given index.  edgeWeight(v, w) is called for each
+// edge v -> w on the path and vertexNumber(i) turns a dense index into a
+// vertex number, just as in tracePath().
+
+template <typename EdgeWeight, typename VertexNumber>
+ShortestPath traceBidirectionalPath(
+    const BidirectionalSearchSpace& space, int meetingIndex,
+    EdgeWeight edgeWeight, VertexNumber vertexNumber);
+
+
+
+template <typename ForEachOutEdge, typename ForEachInEdge>
+int searchShortestPathBidirectional(
+    BidirectionalSearchSpace& space, int indexBound,
+    int sourceIndex, int targetIndex,
+    ForEachOutEdge forEachOutEdge, ForEachInEdge forEachInEdge)
+{
+    ShortestPathTree& forward = space.forward;
+    ShortestPathTree& backward = space.backward;
+
+    // both halves count into the same statistics, if any
+    SearchStats* stats = forward.queue.stats();
+    SearchPhaseTimer timer{stats};
+
+    forward.reset(indexBound, sourceIndex);
+    backward.reset(indexBound, targetIndex);
+
+    forward.distance[sourceIndex] = 0.0;
+    forward.queue.push(sourceIndex, 0.0);
+    backward.distance[targetIndex] = 0.0;
+    backward.queue.push(targetIndex, 0.0);
+    timer.lap(&SearchStats::initSeconds);
+
+    // length of the best path seen so far, and where its halves meet
+    double best = sourceIndex == targetIndex ? 0.0 : std::numeric_limits<double>::infinity();
+    int meeting = sourceIndex == targetIndex ? sourceIndex : -1;
+
+    // relaxes an edge on one side, checking whether it completes a
+    // better path with what the other side has found
+    auto relaxer =
+        [&best, &meeting, stats](ShortestPathTree& side, const ShortestPathTree& other, int v, double dv)
+        {
+            countSettled(stats);
+
+            return [&side, &other, &best, &meeting, stats, v, dv](int w, double weight)
+            {
+                countRelaxed(stats);
+                double dw = dv + weight;
+
+                if (dw < side.distance[w])
+                {
+                    side.distance[w] = dw;
+                    side.predecessor[w] = v;
+                    side.queue.pushOrDecrease(w, dw);
+                }
+
+                if (side.distance[w] + other.distance[w] < best)
+                {
+                    best = side.distance[w] + other.distance[w];
+                    meeting = w;
+                }
+            };
+        };
+
+    while (!forward.queue.empty() && !backward.queue.empty())
+    {
+        // once the two closest unsettled vertices are together at least
+        // as far apart as the best path, nothing left can improve on it
+        if (forward.queue.topPriority() + backward.queue.topPriority() >= best)
+        {
+            break;
+        }
+
+        if (forward.queue.topPriority() <= backward.queue.topPriority())
+        {
+            int v = forward.queue.pop();
+            forEachOutEdge(v, relaxer(forward, backward, v, forward.distance[v]));
+        }
+        else
+        {
+            int w = backward.queue.pop();
+            forEachInEdge(w, relaxer(backward, forward, w, backward.distance[w]));
+        }
+    }
+
+    timer.lap(&SearchStats::searchSeconds);
+
+    return meeting;
+}
+
+
+template <typename EdgeWeight, typename VertexNumber>
+ShortestPath traceBidirectionalPath(
+    const BidirectionalSearchSpace& space, int meetingIndex,
+    EdgeWeight edgeWeight, VertexNumber vertexNumber)
+{
+    if (meetingIndex == -1)
+    {
+        return ShortestPath{};
+    }
+
+    // the forward half is an ordinary path from the start to the meeting
+    // vertex; the backward half continues from there to the end
+    ShortestPath path = tracePath(space.forward, meetingIndex, edgeWeight, vertexNumber);
+
+    // tracePath() timed its part already
+    SearchPhaseTimer timer{space.forward.queue.stats()};
+
+    for (int v = meetingIndex; space.backward.predecessor[v] != -1; v = space.backward.predecessor[v])
+    {
+        int w = space.backward.predecessor[v];
+        path.vertices.push_back(vertexNumber(w));
+        path.weights.push_back(edgeWeight(v, w));
+    }
+
+    // summed in path order, so the total comes out exactly as it would
+    // from a one-sided search
+    path.totalCost = 0.0;
+
+    for (double weight : path.weights)
+    {
+        path.totalCost += weight;
+    }
+
+    timer.lap(&SearchStats::pathSeconds);
+
+    return path;
+}
+
+
+
+#endif // BIDIRECTIONALSEARCH_HPP
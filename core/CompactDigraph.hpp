@@ -0,0 +1,1078 @@
+// CompactDigraph.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares a class template called CompactDigraph, which
+// is an immutable snapshot of a Digraph laid out in compressed sparse row
+// (CSR) form.  Vertices are renumbered with dense indices 0..N-1 (in
+// ascending order of their vertex numbers), the outgoing edges of every
+// vertex are stored contiguously, and a single offsets array tells where
+// each vertex's edges begin and end.  The transpose (every vertex's
+// incoming edges) is stored the same way, so searches can run backward.
+//
+// A Digraph is convenient to build and modify, but every edge it stores
+// is a separately allocated list node reachable only through a map lookup.
+// When a graph is loaded once and then queried many times, it's much
+// cheaper to freeze it into a CompactDigraph and run the queries against
+// that instead.
+
+#ifndef COMPACTDIGRAPH_HPP
+#define COMPACTDIGRAPH_HPP
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Digraph.hpp"
+#include "ShortestPathTree.hpp"
+#include "BidirectionalSearch.hpp"
+#include "AStarSearch.hpp"
+#include "StronglyConnectedComponents.hpp"
+#include "EdgeWeightColumn.hpp"
+#include "ShortestPathRepair.hpp"
+
+
+
+// CompactDigraph is a class template that represents a read-only directed
+// graph.  Like Digraph, it takes two type parameters:
+//
+// * VertexInfo, which specifies the kind of object stored for each vertex
+// * EdgeInfo, which specifies the kind of object stored for each edge
+//
+// Member functions that take vertex numbers behave the same way as their
+// Digraph counterparts, including throwing a DigraphException when given
+// a vertex or edge that doesn't exist.  In addition, the dense indices
+// and the raw CSR arrays are exposed, so that algorithms can walk the
+// graph without any lookups at all.
+//
+// Since a CompactDigraph never changes, any number of threads can query
+// one at the same time, each searching in its own ShortestPathTree.
+
+template <typename VertexInfo, typename EdgeInfo>
+class CompactDigraph
+{
+public:
+    // The default constructor initializes an empty CompactDigraph.
+    CompactDigraph();
+
+    // This constructor takes a snapshot of the given Digraph.  Later
+    // changes to the Digraph do not affect the snapshot.
+    explicit CompactDigraph(const Digraph<VertexInfo, EdgeInfo>& d);
+
+    // This constructor takes a snapshot of an expiring Digraph, moving its
+    // VertexInfo and EdgeInfo objects into the snapshot instead of
+    // copying them.
+    explicit CompactDigraph(Digraph<VertexInfo, EdgeInfo>&& d);
+
+    // fromArrays() builds a CompactDigraph directly from its CSR arrays
+    // (as described alongside the member variables below), such as ones
+    // read back from a file, without going through a Digraph.  Vertex
+    // numbers must be ascending and every vertex's edges sorted by target
+    // index; if the arrays don't fit together that way, a DigraphException
+    // is thrown.
+    static CompactDigraph fromArrays(
+        std::vector<int> vertexNumbers,
+        std::vector<VertexInfo> vertexInfos,
+        std::vector<int> offsets,
+        std::vector<int> targets,
+        std::vector<EdgeInfo> edgeInfos);
+
+    // vertices() returns a std::vector containing the vertex numbers of
+    // every vertex, in ascending order (i.e., in index order).
+    std::vector<int> vertices() const;
+
+    // edges() returns a std::vector of std::pairs, in which each pair
+    // contains the "from" and "to" vertex numbers of an edge.
+    std::vector<std::pair<int, int>> edges() const;
+
+    // This overload of edges() returns only the edges outgoing from the
+    // given vertex number.  If the given vertex does not exist, a
+    // DigraphException is thrown instead.
+    std::vector<std::pair<int, int>> edges(int vertex) const;
+
+    // vertexInfo() returns the VertexInfo object belonging to the vertex
+    // with the given vertex number.  If that vertex does not exist, a
+    // DigraphException is thrown instead.
+    const VertexInfo& vertexInfo(int vertex) const;
+
+    // edgeInfo() returns the EdgeInfo object belonging to the edge with
+    // the given "from" and "to" vertex numbers.  If either of those
+    // vertices does not exist *or* if the edge does not exist, a
+    // DigraphException is thrown instead.
+    const EdgeInfo& edgeInfo(int fromVertex, int toVertex) const;
+
+    // vertexCount() returns the number of vertices in the graph.
+    int vertexCount() const noexcept;
+
+    // edgeCount() returns the total number of edges in the graph.
+    int edgeCount() const noexcept;
+
+    // This overload of edgeCount() returns the number of edges outgoing
+    // from the given vertex number.  If the given vertex does not exist,
+    // a DigraphException is thrown instead.
+    int edgeCount(int vertex) const;
+
+    // indexOf() returns the dense index (0..vertexCount()-1) of the given
+    // vertex number.  If the vertex does not exist, a DigraphException is
+    // thrown instead.
+    int indexOf(int vertex) const;
+
+    // vertexNumber() returns the vertex number belonging to a dense index,
+    // and vertexInfoAt() returns the VertexInfo object belonging to it.
+    int vertexNumber(int index) const noexcept;
+    const VertexInfo& vertexInfoAt(int index) const noexcept;
+
+    // edgeBegin() and edgeEnd() return the half-open range of edge
+    // positions that belong to the vertex with the given dense index.
+    int edgeBegin(int index) const noexcept;
+    int edgeEnd(int index) const noexcept;
+
+    // edgeTarget() returns the dense index of the vertex that the edge at
+    // the given position points to, and edgeInfoAt() returns its EdgeInfo.
+    int edgeTarget(int edge) const noexcept;
+    const EdgeInfo& edgeInfoAt(int edge) const noexcept;
+
+    // inEdgeBegin() and inEdgeEnd() return the half-open range of incoming
+    // edge slots that belong to the vertex with the given dense index.
+    // For each slot, inEdgeSource() returns the dense index of the vertex
+    // the edge comes from and inEdgePosition() returns the edge's position
+    // (as used by edgeTarget() and edgeInfoAt()).
+    int inEdgeBegin(int index) const noexcept;
+    int inEdgeEnd(int index) const noexcept;
+    int inEdgeSource(int slot) const noexcept;
+    int inEdgePosition(int slot) const noexcept;
+
+    // isStronglyConnected() returns true if every vertex is reachable
+    // from every other, false otherwise.
+    bool isStronglyConnected() const;
+
+    // stronglyConnectedComponents() returns the strongly connected
+    // component of each vertex, by dense index.
+    StronglyConnectedComponents stronglyConnectedComponents() const;
+
+    // findShortestPaths() behaves exactly like its Digraph counterpart:
+    // it runs Dijkstra's algorithm from the start vertex and returns a
+    // std::map from each vertex number to its predecessor, where the
+    // start vertex and any unreachable vertices map to themselves.
+    std::map<int, int> findShortestPaths(
+        int startVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // This overload of findShortestPaths() writes its result into the
+    // given ShortestPathTree, indexed by dense index, instead of building
+    // a std::map.
+    void findShortestPaths(
+        int startVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        ShortestPathTree& tree) const;
+
+    // findShortestPath() behaves exactly like its Digraph counterpart:
+    // it finds a single shortest path from the start vertex to the end
+    // vertex, stopping as soon as the end vertex is settled.
+    ShortestPath findShortestPath(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // This overload of findShortestPath() does its searching in the given
+    // ShortestPathTree, so that it can be reused across searches.
+    ShortestPath findShortestPath(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        ShortestPathTree& tree) const;
+
+    // findShortestPathBidirectional() behaves exactly like its Digraph
+    // counterpart, searching from both ends at once.
+    ShortestPath findShortestPathBidirectional(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // This overload of findShortestPathBidirectional() does its searching
+    // in the given BidirectionalSearchSpace, so that it can be reused.
+    ShortestPath findShortestPathBidirectional(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        BidirectionalSearchSpace& space) const;
+
+    // findShortestPathAStar() behaves exactly like its Digraph counterpart,
+    // steering the search toward the end vertex using estimateFunc, which
+    // takes a dense index and returns a lower bound on the length of the
+    // shortest path from there to the end vertex.
+    ShortestPath findShortestPathAStar(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        std::function<double(int)> estimateFunc) const;
+
+    // This overload of findShortestPathAStar() does its searching in the
+    // given ShortestPathTree, so that it can be reused across searches.
+    ShortestPath findShortestPathAStar(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        std::function<double(int)> estimateFunc,
+        ShortestPathTree& tree) const;
+
+    // pathTo() pulls the path to the end vertex out of a tree filled in
+    // by findShortestPaths(), so that one search can answer any number of
+    // trips that share a start vertex.  The weight function must be the
+    // one the tree was searched with.  If the end vertex doesn't exist, a
+    // DigraphException is thrown.
+    ShortestPath pathTo(
+        const ShortestPathTree& tree,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // Each member function above that searches in a ShortestPathTree or
+    // BidirectionalSearchSpace, along with pathTo(), also comes in a
+    // version that takes any callable as its weight function (and, for
+    // A*, as its estimate), such as a lambda or a function object.  Those
+    // can be inlined into the search, where a std::function has to be
+    // called indirectly for every edge, so they're the ones to use when
+    // speed matters.  An EdgeWeightColumn built from this graph can be
+    // passed in place of the weight function, in which case each edge's
+    // weight is simply looked up in the column.
+    template <typename WeightFn>
+    void findShortestPaths(
+        int startVertex, WeightFn edgeWeightFunc, ShortestPathTree& tree) const;
+
+    template <typename WeightFn>
+    ShortestPath findShortestPath(
+        int startVertex, int endVertex, WeightFn edgeWeightFunc, ShortestPathTree& tree) const;
+
+    template <typename WeightFn>
+    ShortestPath findShortestPathBidirectional(
+        int startVertex, int endVertex, WeightFn edgeWeightFunc, BidirectionalSearchSpace& space) const;
+
+    template <typename WeightFn, typename EstimateFn>
+    ShortestPath findShortestPathAStar(
+        int startVertex, int endVertex, WeightFn edgeWeightFunc, EstimateFn estimateFunc,
+        ShortestPathTree& tree) const;
+
+    template <typename WeightFn>
+    ShortestPath pathTo(const ShortestPathTree& tree, int endVertex, WeightFn edgeWeightFunc) const;
+
+    // edgePosition() returns the position (as used by edgeTarget() and
+    // edgeInfoAt()) of the edge with the given "from" and "to" vertex
+    // numbers, which is where its weight lives in an EdgeWeightColumn.  If
+    // the edge does not exist, a DigraphException is thrown.
+    int edgePosition(int fromVertex, int toVertex) const;
+
+    // repairShortestPaths() brings a tree filled in by findShortestPaths()
+    // up to date after the weights of the edges listed in changedEdges (as
+    // pairs of "from" and "to" vertex numbers) have changed.  A
+    // CompactDigraph never changes, so the new weights have to come from
+    // the weight function, typically an EdgeWeightColumn whose entries
+    // were updated.  If a listed edge does not exist, a DigraphException
+    // is thrown.
+    template <typename WeightFn>
+    void repairShortestPaths(
+        ShortestPathTree& tree,
+        const std::vector<std::pair<int, int>>& changedEdges,
+        WeightFn edgeWeightFunc) const;
+
+private:
+    // vertex numbers, indexed by dense index; sorted ascending
+    std::vector<int> vertexNumbers;
+    std::vector<VertexInfo> vertexInfos;
+
+    // the edges of the vertex at index i occupy positions
+    // offsets[i] .. offsets[i + 1] - 1 of targets and edgeInfos,
+    // sorted by target index
+    std::vector<int> offsets;
+    std::vector<int> targets;
+    std::vector<EdgeInfo> edgeInfos;
+
+    // the incoming edges of the vertex at index i occupy slots
+    // reverseOffsets[i] .. reverseOffsets[i + 1] - 1 of reverseSources
+    // (where each edge comes from) and reverseEdges (its position above)
+    std::vector<int> reverseOffsets;
+    std::vector<int> reverseSources;
+    std::vector<int> reverseEdges;
+
+    // takeSnapshot() fills in the forward and reverse arrays from a
+    // Digraph, copying its VertexInfo and EdgeInfo objects if it's const
+    // and moving them otherwise.
+    template <typename SourceDigraph>
+    void takeSnapshot(SourceDigraph& d);
+
+    // buildTranspose() fills in the reverse arrays from the forward ones.
+    void buildTranspose();
+
+    // findEdge() returns the position of the edge between two dense
+    // indices, or -1 if there isn't one.
+    int findEdge(int fromIndex, int toIndex) const;
+
+    // weightOf() returns the weight of the edge at the given position,
+    // either by calling a weight function or by reading a column.
+    template <typename WeightFn>
+    double weightOf(const WeightFn& edgeWeightFunc, int edge) const;
+    double weightOf(const EdgeWeightColumn& column, int edge) const noexcept;
+
+    // reachesAll() returns true if an iterative depth-first search from
+    // index 0 over the given CSR arrays visits every vertex.
+    bool reachesAll(
+        const std::vector<int>& rowOffsets,
+        const std::vector<int>& rowTargets) const;
+};
+
+
+
+template <typename VertexInfo, typename EdgeInfo>
+CompactDigraph<VertexInfo, EdgeInfo>::CompactDigraph()
+    : offsets{0}, reverseOffsets{0}
+{
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+CompactDigraph<VertexInfo, EdgeInfo>::CompactDigraph(const Digraph<VertexInfo, EdgeInfo>& d)
+{
+    takeSnapshot(d);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+CompactDigraph<VertexInfo, EdgeInfo>::CompactDigraph(Digraph<VertexInfo, EdgeInfo>&& d)
+{
+    takeSnapshot(d);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename SourceDigraph>
+void CompactDigraph<VertexInfo, EdgeInfo>::takeSnapshot(SourceDigraph& d)
+{
+    // only a const Digraph has to be left the way it was found
+    constexpr bool stealing = !std::is_const_v<SourceDigraph>;
+
+    // the map is ordered by vertex number, so walking it hands out
+    // dense indices in ascending vertex number order
+    vertexNumbers.reserve(d.ImTheMap.size());
+    vertexInfos.reserve(d.ImTheMap.size());
+
+    for (auto& vertex : d.ImTheMap)
+    {
+        vertexNumbers.push_back(vertex.first);
+
+        if constexpr (stealing)
+        {
+            vertexInfos.push_back(std::move(vertex.second.vinfo));
+        }
+        else
+        {
+            vertexInfos.push_back(vertex.second.vinfo);
+        }
+    }
+
+    offsets.reserve(vertexNumbers.size() + 1);
+    offsets.push_back(0);
+
+    // scratch row, so each vertex's edges can be sorted by target
+    std::vector<std::pair<int, std::conditional_t<stealing, EdgeInfo*, const EdgeInfo*>>> row;
+
+    for (auto& vertex : d.ImTheMap)
+    {
+        row.clear();
+
+        for (auto& edge : vertex.second.edges)
+        {
+            row.emplace_back(indexOf(edge.toVertex), &edge.einfo);
+        }
+
+        std::sort(
+            row.begin(), row.end(),
+            [](const auto& a, const auto& b)
+            {
+                return a.first < b.first;
+            });
+
+        for (const auto& entry : row)
+        {
+            targets.push_back(entry.first);
+
+            if constexpr (stealing)
+            {
+                edgeInfos.push_back(std::move(*entry.second));
+            }
+            else
+            {
+                edgeInfos.push_back(*entry.second);
+            }
+        }
+
+        offsets.push_back(targets.size());
+    }
+
+    buildTranspose();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+CompactDigraph<VertexInfo, EdgeInfo> CompactDigraph<VertexInfo, EdgeInfo>::fromArrays(
+    std::vector<int> vertexNumbers,
+    std::vector<VertexInfo> vertexInfos,
+    std::vector<int> offsets,
+    std::vector<int> targets,
+    std::vector<EdgeInfo> edgeInfos)
+{
+    int n = vertexNumbers.size();
+
+    if (static_cast<int>(vertexInfos.size()) != n
+        || static_cast<int>(offsets.size()) != n + 1
+        || offsets.front() != 0
+        || offsets.back() != static_cast<int>(targets.size())
+        || targets.size() != edgeInfos.size())
+    {
+        throw DigraphException("Graph arrays have mismatched sizes");
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (i > 0 && vertexNumbers[i - 1] >= vertexNumbers[i])
+        {
+            throw DigraphException("Vertex numbers are not ascending");
+        }
+
+        if (offsets[i] > offsets[i + 1])
+        {
+            throw DigraphException("Edge offsets are not ascending");
+        }
+
+        for (int e = offsets[i]; e < offsets[i + 1]; ++e)
+        {
+            if (targets[e] < 0 || targets[e] >= n
+                || (e > offsets[i] && targets[e - 1] >= targets[e]))
+            {
+                throw DigraphException("Edge targets are out of range or out of order");
+            }
+        }
+    }
+
+    CompactDigraph result;
+    result.vertexNumbers = std::move(vertexNumbers);
+    result.vertexInfos = std::move(vertexInfos);
+    result.offsets = std::move(offsets);
+    result.targets = std::move(targets);
+    result.edgeInfos = std::move(edgeInfos);
+    result.buildTranspose();
+
+    return result;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void CompactDigraph<VertexInfo, EdgeInfo>::buildTranspose()
+{
+    // the transpose: count each vertex's incoming edges, then drop every
+    // edge into its target's range; walking sources in order keeps each
+    // range sorted by source
+    reverseOffsets.assign(vertexNumbers.size() + 1, 0);
+    reverseSources.resize(targets.size());
+    reverseEdges.resize(targets.size());
+
+    for (int target : targets)
+    {
+        ++reverseOffsets[target + 1];
+    }
+
+    for (int i = 0; i < vertexCount(); ++i)
+    {
+        reverseOffsets[i + 1] += reverseOffsets[i];
+    }
+
+    std::vector<int> next(reverseOffsets.begin(), reverseOffsets.end() - 1);
+
+    for (int i = 0; i < vertexCount(); ++i)
+    {
+        for (int e = offsets[i]; e < offsets[i + 1]; ++e)
+        {
+            int slot = next[targets[e]]++;
+            reverseSources[slot] = i;
+            reverseEdges[slot] = e;
+        }
+    }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+std::vector<int> CompactDigraph<VertexInfo, EdgeInfo>::vertices() const
+{
+    return vertexNumbers;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+std::vector<std::pair<int, int>> CompactDigraph<VertexInfo, EdgeInfo>::edges() const
+{
+    std::vector<std::pair<int, int>> result;
+    result.reserve(targets.size());
+
+    for (int i = 0; i < vertexCount(); ++i)
+    {
+        for (int e = offsets[i]; e < offsets[i + 1]; ++e)
+        {
+            result.emplace_back(vertexNumbers[i], vertexNumbers[targets[e]]);
+        }
+    }
+
+    return result;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+std::vector<std::pair<int, int>> CompactDigraph<VertexInfo, EdgeInfo>::edges(int vertex) const
+{
+    int i = indexOf(vertex);
+
+    std::vector<std::pair<int, int>> result;
+    result.reserve(offsets[i + 1] - offsets[i]);
+
+    for (int e = offsets[i]; e < offsets[i + 1]; ++e)
+    {
+        result.emplace_back(vertex, vertexNumbers[targets[e]]);
+    }
+
+    return result;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+const VertexInfo& CompactDigraph<VertexInfo, EdgeInfo>::vertexInfo(int vertex) const
+{
+    return vertexInfos[indexOf(vertex)];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+const EdgeInfo& CompactDigraph<VertexInfo, EdgeInfo>::edgeInfo(int fromVertex, int toVertex) const
+{
+    int e = findEdge(indexOf(fromVertex), indexOf(toVertex));
+
+    if (e == -1)
+    {
+        throw DigraphException("No such edge exists");
+    }
+
+    return edgeInfos[e];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::vertexCount() const noexcept
+{
+    return vertexNumbers.size();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::edgeCount() const noexcept
+{
+    return targets.size();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::edgeCount(int vertex) const
+{
+    int i = indexOf(vertex);
+    return offsets[i + 1] - offsets[i];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::indexOf(int vertex) const
+{
+    std::vector<int>::const_iterator itr =
+        std::lower_bound(vertexNumbers.begin(), vertexNumbers.end(), vertex);
+
+    if (itr == vertexNumbers.end() || *itr != vertex)
+    {
+        throw DigraphException("No vertex with that number exists");
+    }
+
+    return itr - vertexNumbers.begin();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::vertexNumber(int index) const noexcept
+{
+    return vertexNumbers[index];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+const VertexInfo& CompactDigraph<VertexInfo, EdgeInfo>::vertexInfoAt(int index) const noexcept
+{
+    return vertexInfos[index];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::edgeBegin(int index) const noexcept
+{
+    return offsets[index];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::edgeEnd(int index) const noexcept
+{
+    return offsets[index + 1];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::edgeTarget(int edge) const noexcept
+{
+    return targets[edge];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+const EdgeInfo& CompactDigraph<VertexInfo, EdgeInfo>::edgeInfoAt(int edge) const noexcept
+{
+    return edgeInfos[edge];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::inEdgeBegin(int index) const noexcept
+{
+    return reverseOffsets[index];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::inEdgeEnd(int index) const noexcept
+{
+    return reverseOffsets[index + 1];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::inEdgeSource(int slot) const noexcept
+{
+    return reverseSources[slot];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::inEdgePosition(int slot) const noexcept
+{
+    return reverseEdges[slot];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+bool CompactDigraph<VertexInfo, EdgeInfo>::isStronglyConnected() const
+{
+    if (vertexCount() == 0)
+    {
+        return true;
+    }
+
+    if (!reachesAll(offsets, targets))
+    {
+        return false;
+    }
+
+    // the same search over the transpose tells us whether every vertex
+    // can reach index 0
+    return reachesAll(reverseOffsets, reverseSources);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+StronglyConnectedComponents CompactDigraph<VertexInfo, EdgeInfo>::stronglyConnectedComponents() const
+{
+    StronglyConnectedComponents components;
+
+    findStronglyConnectedComponents(
+        components, vertexCount(),
+        [](int)
+        {
+            return true;
+        },
+        [this](int v, auto visit)
+        {
+            for (int e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                visit(targets[e]);
+            }
+        });
+
+    return components;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+std::map<int, int> CompactDigraph<VertexInfo, EdgeInfo>::findShortestPaths(
+    int startVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    ShortestPathTree tree;
+    findShortestPaths(startVertex, edgeWeightFunc, tree);
+
+    std::map<int, int> result;
+
+    for (int i = 0; i < vertexCount(); ++i)
+    {
+        int p = tree.predecessor[i] == -1 ? i : tree.predecessor[i];
+        result.emplace_hint(result.end(), vertexNumbers[i], vertexNumbers[p]);
+    }
+
+    return result;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void CompactDigraph<VertexInfo, EdgeInfo>::findShortestPaths(
+    int startVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    ShortestPathTree& tree) const
+{
+    findShortestPaths<std::function<double(const EdgeInfo&)>>(startVertex, edgeWeightFunc, tree);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn>
+void CompactDigraph<VertexInfo, EdgeInfo>::findShortestPaths(
+    int startVertex, WeightFn edgeWeightFunc, ShortestPathTree& tree) const
+{
+    searchShortestPaths(
+        tree, vertexCount(), indexOf(startVertex),
+        [this, &edgeWeightFunc](int v, auto relax)
+        {
+            for (int e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                relax(targets[e], weightOf(edgeWeightFunc, e));
+            }
+        });
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::findShortestPath(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    ShortestPathTree tree;
+    return findShortestPath(startVertex, endVertex, edgeWeightFunc, tree);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::findShortestPath(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    ShortestPathTree& tree) const
+{
+    return findShortestPath<std::function<double(const EdgeInfo&)>>(startVertex, endVertex, edgeWeightFunc, tree);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::findShortestPath(
+    int startVertex, int endVertex, WeightFn edgeWeightFunc, ShortestPathTree& tree) const
+{
+    int start = indexOf(startVertex);
+    int end = indexOf(endVertex);
+
+    searchShortestPaths(
+        tree, vertexCount(), start,
+        [this, &edgeWeightFunc](int v, auto relax)
+        {
+            for (int e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                relax(targets[e], weightOf(edgeWeightFunc, e));
+            }
+        },
+        end);
+
+    return tracePath(
+        tree, end,
+        [this, &edgeWeightFunc](int v, int w)
+        {
+            return weightOf(edgeWeightFunc, findEdge(v, w));
+        },
+        [this](int index)
+        {
+            return vertexNumbers[index];
+        });
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::pathTo(
+    const ShortestPathTree& tree,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    return pathTo<std::function<double(const EdgeInfo&)>>(tree, endVertex, edgeWeightFunc);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::pathTo(
+    const ShortestPathTree& tree, int endVertex, WeightFn edgeWeightFunc) const
+{
+    return tracePath(
+        tree, indexOf(endVertex),
+        [this, &edgeWeightFunc](int v, int w)
+        {
+            return weightOf(edgeWeightFunc, findEdge(v, w));
+        },
+        [this](int index)
+        {
+            return vertexNumbers[index];
+        });
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::findShortestPathBidirectional(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    BidirectionalSearchSpace space;
+    return findShortestPathBidirectional(startVertex, endVertex, edgeWeightFunc, space);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::findShortestPathBidirectional(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    BidirectionalSearchSpace& space) const
+{
+    return findShortestPathBidirectional<std::function<double(const EdgeInfo&)>>(
+        startVertex, endVertex, edgeWeightFunc, space);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::findShortestPathBidirectional(
+    int startVertex, int endVertex, WeightFn edgeWeightFunc, BidirectionalSearchSpace& space) const
+{
+    int start = indexOf(startVertex);
+    int end = indexOf(endVertex);
+
+    int meeting = searchShortestPathBidirectional(
+        space, vertexCount(), start, end,
+        [this, &edgeWeightFunc](int v, auto relax)
+        {
+            for (int e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                relax(targets[e], weightOf(edgeWeightFunc, e));
+            }
+        },
+        [this, &edgeWeightFunc](int w, auto relax)
+        {
+            for (int slot = reverseOffsets[w]; slot < reverseOffsets[w + 1]; ++slot)
+            {
+                relax(reverseSources[slot], weightOf(edgeWeightFunc, reverseEdges[slot]));
+            }
+        });
+
+    return traceBidirectionalPath(
+        space, meeting,
+        [this, &edgeWeightFunc](int v, int w)
+        {
+            return weightOf(edgeWeightFunc, findEdge(v, w));
+        },
+        [this](int index)
+        {
+            return vertexNumbers[index];
+        });
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::findShortestPathAStar(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    std::function<double(int)> estimateFunc) const
+{
+    ShortestPathTree tree;
+    return findShortestPathAStar(startVertex, endVertex, edgeWeightFunc, estimateFunc, tree);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::findShortestPathAStar(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    std::function<double(int)> estimateFunc,
+    ShortestPathTree& tree) const
+{
+    return findShortestPathAStar<std::function<double(const EdgeInfo&)>, std::function<double(int)>>(
+        startVertex, endVertex, edgeWeightFunc, estimateFunc, tree);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn, typename EstimateFn>
+ShortestPath CompactDigraph<VertexInfo, EdgeInfo>::findShortestPathAStar(
+    int startVertex, int endVertex, WeightFn edgeWeightFunc, EstimateFn estimateFunc,
+    ShortestPathTree& tree) const
+{
+    int start = indexOf(startVertex);
+    int end = indexOf(endVertex);
+
+    searchShortestPathAStar(
+        tree, vertexCount(), start, end,
+        [this, &edgeWeightFunc](int v, auto relax)
+        {
+            for (int e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                relax(targets[e], weightOf(edgeWeightFunc, e));
+            }
+        },
+        estimateFunc);
+
+    return tracePath(
+        tree, end,
+        [this, &edgeWeightFunc](int v, int w)
+        {
+            return weightOf(edgeWeightFunc, findEdge(v, w));
+        },
+        [this](int index)
+        {
+            return vertexNumbers[index];
+        });
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::edgePosition(int fromVertex, int toVertex) const
+{
+    int e = findEdge(indexOf(fromVertex), indexOf(toVertex));
+
+    if (e == -1)
+    {
+        throw DigraphException("No such edge exists");
+    }
+
+    return e;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn>
+void CompactDigraph<VertexInfo, EdgeInfo>::repairShortestPaths(
+    ShortestPathTree& tree,
+    const std::vector<std::pair<int, int>>& changedEdges,
+    WeightFn edgeWeightFunc) const
+{
+    std::vector<std::pair<int, int>> changed;
+    changed.reserve(changedEdges.size());
+
+    for (const std::pair<int, int>& edge : changedEdges)
+    {
+        int e = edgePosition(edge.first, edge.second);
+        changed.emplace_back(indexOf(edge.first), targets[e]);
+    }
+
+    // the free function, which this member would otherwise hide
+    ::repairShortestPaths(
+        tree, changed,
+        [this, &edgeWeightFunc](int v, auto relax)
+        {
+            for (int e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                relax(targets[e], weightOf(edgeWeightFunc, e));
+            }
+        },
+        [this, &edgeWeightFunc](int w, auto relax)
+        {
+            for (int slot = reverseOffsets[w]; slot < reverseOffsets[w + 1]; ++slot)
+            {
+                relax(reverseSources[slot], weightOf(edgeWeightFunc, reverseEdges[slot]));
+            }
+        });
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int CompactDigraph<VertexInfo, EdgeInfo>::findEdge(int fromIndex, int toIndex) const
+{
+    std::vector<int>::const_iterator first = targets.begin() + offsets[fromIndex];
+    std::vector<int>::const_iterator last = targets.begin() + offsets[fromIndex + 1];
+    std::vector<int>::const_iterator itr = std::lower_bound(first, last, toIndex);
+
+    if (itr == last || *itr != toIndex)
+    {
+        return -1;
+    }
+
+    return itr - targets.begin();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn>
+double CompactDigraph<VertexInfo, EdgeInfo>::weightOf(const WeightFn& edgeWeightFunc, int edge) const
+{
+    return edgeWeightFunc(edgeInfos[edge]);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+double CompactDigraph<VertexInfo, EdgeInfo>::weightOf(const EdgeWeightColumn& column, int edge) const noexcept
+{
+    return column[edge];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+bool CompactDigraph<VertexInfo, EdgeInfo>::reachesAll(
+    const std::vector<int>& rowOffsets,
+    const std::vector<int>& rowTargets) const
+{
+    std::vector<bool> visited(vertexCount(), false);
+    std::vector<int> stack{0};
+    visited[0] = true;
+    int visitedCount = 1;
+
+    while (!stack.empty())
+    {
+        int v = stack.back();
+        stack.pop_back();
+
+        for (int e = rowOffsets[v]; e < rowOffsets[v + 1]; ++e)
+        {
+            int w = rowTargets[e];
+
+            if (!visited[w])
+            {
+                visited[w] = true;
+                ++visitedCount;
+                stack.push_back(w);
+            }
+        }
+    }
+
+    return visitedCount == vertexCount();
+}
+
+
+
+#endif // COMPACTDIGRAPH_HPP
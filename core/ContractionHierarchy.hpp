@@ -0,0 +1,644 @@
+// ContractionHierarchy.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called ContractionHierarchy, which
+// answers shortest path queries on a CompactDigraph far faster than
+// Dijkstra's algorithm can, at the cost of some preprocessing up front.
+//
+// Preprocessing "contracts" the vertices one at a time, least important
+// first.  Contracting a vertex v removes it from the graph; whenever a
+// shortest path ran u -> v -> w, a "shortcut" edge u -> w with the same
+// length is added so that the remaining graph still has the same distances,
+// unless some other path from u to w (a "witness") is no longer than it.
+// The order in which vertices were contracted is their rank.
+//
+// Every shortest path then has a version that only climbs in rank and then
+// only falls, so a query searches upward from both ends of the trip at
+// once, over very few edges, and meets at the top.  Shortcuts remember the
+// two edges they replace, so a path can be unpacked back into edges of
+// the original graph.
+//
+// Like a LandmarkTable, a ContractionHierarchy is built for one particular
+// weight function and one particular graph, and uses its dense indices.
+
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "IndexedDaryHeap.hpp"
+#include "ShortestPathTree.hpp"
+
+
+
+// A ContractionHierarchySearch holds the scratch space used by queries.
+// Only the parts of it that a query touches are cleaned up afterward, so
+// reusing one keeps each query's cost independent of the graph's size.
+
+struct ContractionHierarchySearch
+{
+    std::vector<double> forwardDistance;
+    std::vector<double> backwardDistance;
+
+    // the arc each vertex was reached by, or -1
+    std::vector<int> forwardArc;
+    std::vector<int> backwardArc;
+
+    // every index whose distances need to be reset before the next query
+    std::vector<int> touched;
+
+    IndexedDaryHeap<double> forwardQueue;
+    IndexedDaryHeap<double> backwardQueue;
+};
+
+
+
+class ContractionHierarchy
+{
+public:
+    // The default constructor initializes a hierarchy for an empty graph.
+    ContractionHierarchy();
+
+    // build() contracts every vertex of the given graph, using the given
+    // edge weights, which must not be negative.
+    template <typename VertexInfo, typename EdgeInfo>
+    static ContractionHierarchy build(
+        const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc);
+
+    // vertexCount() returns the number of vertices in the graph the
+    // hierarchy was built for, and shortcutCount() the number of
+    // shortcuts that were added to it.
+    int vertexCount() const noexcept;
+    int shortcutCount() const noexcept;
+
+    // rank() returns the position at which the vertex at the given dense
+    // index was contracted.
+    int rank(int index) const noexcept;
+
+    // findShortestPath() finds a shortest path from the start vertex to
+    // the end vertex of the graph the hierarchy was built for.  Shortcuts
+    // are unpacked, so the path consists only of edges of that graph, and
+    // its weights are the ones the hierarchy was built with.  If either
+    // vertex doesn't exist, a DigraphException is thrown.
+    template <typename VertexInfo, typename EdgeInfo>
+    ShortestPath findShortestPath(
+        const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+        int startVertex, int endVertex,
+        ContractionHierarchySearch& search) const;
+
+private:
+    // An Arc is either an edge of the original graph (originalEdge is its
+    // position in the graph's edge array) or a shortcut (originalEdge is
+    // -1) standing in for the arcs lowerArc and then upperArc.
+    struct Arc
+    {
+        int from;
+        int to;
+        double weight;
+        int originalEdge;
+        int lowerArc;
+        int upperArc;
+    };
+
+    std::vector<Arc> arcs;
+    std::vector<int> ranks;
+    int shortcuts;
+
+    // upArcs[upOffsets[v]..upOffsets[v+1]-1] are the arcs leaving v toward
+    // higher ranks; downArcs[downOffsets[v]..downOffsets[v+1]-1] are the
+    // arcs arriving at v from higher ranks.
+    std::vector<int> upOffsets;
+    std::vector<int> upArcs;
+    std::vector<int> downOffsets;
+    std::vector<int> downArcs;
+
+    // searchUpward() runs the upward searches from both ends and returns
+    // the index where they meet on a shortest path, or -1 if there is none.
+    int searchUpward(ContractionHierarchySearch& search, int sourceIndex, int targetIndex) const;
+
+    // unpack() appends the original arcs along the path found by
+    // searchUpward() to the given vector, in order.
+    void unpack(
+        const ContractionHierarchySearch& search, int meetingIndex,
+        std::vector<int>& originalArcs) const;
+};
+
+
+
+namespace ContractionHierarchyTuning
+{
+    // a witness search gives up after settling this many vertices; giving
+    // up early only ever adds a shortcut that wasn't strictly needed
+    const int witnessSettleLimit = 500;
+}
+
+
+
+inline ContractionHierarchy::ContractionHierarchy()
+    : shortcuts{0}, upOffsets(1, 0), downOffsets(1, 0)
+{
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ContractionHierarchy ContractionHierarchy::build(
+    const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+    int n = graph.vertexCount();
+
+    ContractionHierarchy ch;
+    ch.ranks.assign(n, -1);
+
+    // the graph that remains as vertices are contracted, in both directions
+    struct Link
+    {
+        int other;
+        double weight;
+        int arc;
+    };
+
+    std::vector<std::vector<Link>> out(n);
+    std::vector<std::vector<Link>> in(n);
+
+    for (int v = 0; v < n; ++v)
+    {
+        for (int e = graph.edgeBegin(v); e < graph.edgeEnd(v); ++e)
+        {
+            int w = graph.edgeTarget(e);
+
+            // a loop is never part of a shortest path
+            if (w == v)
+            {
+                continue;
+            }
+
+            double weight = edgeWeightFunc(graph.edgeInfoAt(e));
+            int arc = ch.arcs.size();
+
+            ch.arcs.push_back(Arc{v, w, weight, e, -1, -1});
+            out[v].push_back(Link{w, weight, arc});
+            in[w].push_back(Link{v, weight, arc});
+        }
+    }
+
+    // witness searches: a Dijkstra search from one in-neighbor of the
+    // vertex being contracted, around it, only as far as it needs to go
+    std::vector<double> witnessDistance(n, infinity);
+    std::vector<int> witnessTouched;
+    IndexedDaryHeap<double> witnessQueue(n);
+
+    auto witnessSearch =
+        [&](int source, int avoid, double limit)
+        {
+            for (int v : witnessTouched)
+            {
+                witnessDistance[v] = infinity;
+            }
+
+            witnessTouched.clear();
+            witnessQueue.clear();
+
+            witnessDistance[source] = 0.0;
+            witnessTouched.push_back(source);
+            witnessQueue.push(source, 0.0);
+
+            for (int settled = 0;
+                 !witnessQueue.empty() && settled < ContractionHierarchyTuning::witnessSettleLimit;
+                 ++settled)
+            {
+                if (witnessQueue.topPriority() > limit)
+                {
+                    break;
+                }
+
+                int v = witnessQueue.pop();
+                double dv = witnessDistance[v];
+
+                for (const Link& link : out[v])
+                {
+                    double dw = dv + link.weight;
+
+                    if (link.other != avoid && dw < witnessDistance[link.other])
+                    {
+                        if (witnessDistance[link.other] == infinity)
+                        {
+                            witnessTouched.push_back(link.other);
+                        }
+
+                        witnessDistance[link.other] = dw;
+                        witnessQueue.pushOrDecrease(link.other, dw);
+                    }
+                }
+            }
+        };
+
+    // contract() works out which shortcuts contracting v needs, adding
+    // them unless it's only simulating, and returns how many there were
+    auto contract =
+        [&](int v, bool simulate)
+        {
+            int needed = 0;
+
+            for (const Link& inLink : in[v])
+            {
+                int u = inLink.other;
+                double limit = -1.0;
+
+                for (const Link& outLink : out[v])
+                {
+                    if (outLink.other != u)
+                    {
+                        limit = std::max(limit, inLink.weight + outLink.weight);
+                    }
+                }
+
+                if (limit < 0.0)
+                {
+                    continue;
+                }
+
+                witnessSearch(u, v, limit);
+
+                for (const Link& outLink : out[v])
+                {
+                    int w = outLink.other;
+                    double via = inLink.weight + outLink.weight;
+
+                    if (w == u || witnessDistance[w] <= via)
+                    {
+                        continue;
+                    }
+
+                    ++needed;
+
+                    if (simulate)
+                    {
+                        continue;
+                    }
+
+                    int arc = ch.arcs.size();
+                    ch.arcs.push_back(Arc{u, w, via, -1, inLink.arc, outLink.arc});
+                    ++ch.shortcuts;
+
+                    // an existing (longer) edge u -> w is replaced in place
+                    auto sameTarget = [w](const Link& link) { return link.other == w; };
+                    auto sameSource = [u](const Link& link) { return link.other == u; };
+                    auto existing = std::find_if(out[u].begin(), out[u].end(), sameTarget);
+
+                    if (existing != out[u].end())
+                    {
+                        *existing = Link{w, via, arc};
+                        *std::find_if(in[w].begin(), in[w].end(), sameSource) = Link{u, via, arc};
+                    }
+                    else
+                    {
+                        out[u].push_back(Link{w, via, arc});
+                        in[w].push_back(Link{u, via, arc});
+                    }
+                }
+            }
+
+            return needed;
+        };
+
+    // vertices are contracted in order of their "edge difference" (how
+    // many edges contracting them adds, less how many it removes), plus
+    // how many of their neighbors are gone already, which keeps the
+    // contraction spread evenly across the graph
+    std::vector<int> contractedNeighbors(n, 0);
+
+    auto priority =
+        [&](int v)
+        {
+            int removed = in[v].size() + out[v].size();
+            return contract(v, true) - removed + contractedNeighbors[v];
+        };
+
+    using Candidate = std::pair<int, int>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> order;
+
+    for (int v = 0; v < n; ++v)
+    {
+        order.push(Candidate{priority(v), v});
+    }
+
+    int nextRank = 0;
+
+    while (!order.empty())
+    {
+        int v = order.top().second;
+        order.pop();
+
+        if (ch.ranks[v] != -1)
+        {
+            continue;
+        }
+
+        // priorities go stale as neighbors are contracted, so they're
+        // checked again lazily, when a vertex reaches the front
+        int current = priority(v);
+
+        if (!order.empty() && current > order.top().first)
+        {
+            order.push(Candidate{current, v});
+            continue;
+        }
+
+        contract(v, false);
+        ch.ranks[v] = nextRank++;
+
+        auto isV = [v](const Link& link) { return link.other == v; };
+
+        for (const Link& link : in[v])
+        {
+            auto& links = out[link.other];
+            links.erase(std::remove_if(links.begin(), links.end(), isV), links.end());
+            ++contractedNeighbors[link.other];
+        }
+
+        for (const Link& link : out[v])
+        {
+            auto& links = in[link.other];
+            links.erase(std::remove_if(links.begin(), links.end(), isV), links.end());
+            ++contractedNeighbors[link.other];
+        }
+
+        in[v].clear();
+        out[v].clear();
+    }
+
+    // every arc, original or shortcut, either climbs or falls in rank
+    ch.upOffsets.assign(n + 1, 0);
+    ch.downOffsets.assign(n + 1, 0);
+
+    for (const Arc& arc : ch.arcs)
+    {
+        if (ch.ranks[arc.from] < ch.ranks[arc.to])
+        {
+            ++ch.upOffsets[arc.from + 1];
+        }
+        else
+        {
+            ++ch.downOffsets[arc.to + 1];
+        }
+    }
+
+    for (int v = 0; v < n; ++v)
+    {
+        ch.upOffsets[v + 1] += ch.upOffsets[v];
+        ch.downOffsets[v + 1] += ch.downOffsets[v];
+    }
+
+    ch.upArcs.resize(ch.upOffsets[n]);
+    ch.downArcs.resize(ch.downOffsets[n]);
+
+    std::vector<int> nextUp(ch.upOffsets.begin(), ch.upOffsets.end() - 1);
+    std::vector<int> nextDown(ch.downOffsets.begin(), ch.downOffsets.end() - 1);
+
+    for (int a = 0; a < static_cast<int>(ch.arcs.size()); ++a)
+    {
+        const Arc& arc = ch.arcs[a];
+
+        if (ch.ranks[arc.from] < ch.ranks[arc.to])
+        {
+            ch.upArcs[nextUp[arc.from]++] = a;
+        }
+        else
+        {
+            ch.downArcs[nextDown[arc.to]++] = a;
+        }
+    }
+
+    return ch;
+}
+
+
+inline int ContractionHierarchy::vertexCount() const noexcept
+{
+    return ranks.size();
+}
+
+
+inline int ContractionHierarchy::shortcutCount() const noexcept
+{
+    return shortcuts;
+}
+
+
+inline int ContractionHierarchy::rank(int index) const noexcept
+{
+    return ranks[index];
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath ContractionHierarchy::findShortestPath(
+    const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+    int startVertex, int endVertex,
+    ContractionHierarchySearch& search) const
+{
+    if (graph.vertexCount() != vertexCount())
+    {
+        throw DigraphException("Contraction hierarchy does not match the graph");
+    }
+
+    int sourceIndex = graph.indexOf(startVertex);
+    int targetIndex = graph.indexOf(endVertex);
+
+    int meeting = searchUpward(search, sourceIndex, targetIndex);
+
+    ShortestPath path;
+
+    if (meeting == -1)
+    {
+        return path;
+    }
+
+    SearchPhaseTimer timer{search.forwardQueue.stats()};
+    std::vector<int> originalArcs;
+    unpack(search, meeting, originalArcs);
+
+    // summed in path order, so the total comes out exactly as it would
+    // from Dijkstra's algorithm
+    path.totalCost = 0.0;
+    path.vertices.push_back(startVertex);
+
+    for (int a : originalArcs)
+    {
+        path.vertices.push_back(graph.vertexNumber(arcs[a].to));
+        path.weights.push_back(arcs[a].weight);
+        path.totalCost += arcs[a].weight;
+    }
+
+    timer.lap(&SearchStats::pathSeconds);
+
+    return path;
+}
+
+
+inline int ContractionHierarchy::searchUpward(
+    ContractionHierarchySearch& search, int sourceIndex, int targetIndex) const
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+    int n = vertexCount();
+
+    // both directions count into the same statistics, if any
+    SearchStats* stats = search.forwardQueue.stats();
+    SearchPhaseTimer timer{stats};
+
+    if (static_cast<int>(search.forwardDistance.size()) != n)
+    {
+        search.forwardDistance.assign(n, infinity);
+        search.backwardDistance.assign(n, infinity);
+        search.forwardArc.assign(n, -1);
+        search.backwardArc.assign(n, -1);
+        search.touched.clear();
+        search.forwardQueue.reset(n);
+        search.backwardQueue.reset(n);
+    }
+
+    // clean up after the previous query
+    for (int v : search.touched)
+    {
+        search.forwardDistance[v] = infinity;
+        search.backwardDistance[v] = infinity;
+        search.forwardArc[v] = -1;
+        search.backwardArc[v] = -1;
+    }
+
+    search.touched.clear();
+    search.forwardQueue.clear();
+    search.backwardQueue.clear();
+
+    search.forwardDistance[sourceIndex] = 0.0;
+    search.forwardQueue.push(sourceIndex, 0.0);
+    search.backwardDistance[targetIndex] = 0.0;
+    search.backwardQueue.push(targetIndex, 0.0);
+    search.touched.push_back(sourceIndex);
+    search.touched.push_back(targetIndex);
+    timer.lap(&SearchStats::initSeconds);
+
+    double best = infinity;
+    int meeting = -1;
+
+    // settles the closest vertex on one side and relaxes its arcs, which
+    // lead upward in both cases: forward along arcs leaving it, backward
+    // against arcs arriving at it
+    auto settle =
+        [this, &search, &best, &meeting, stats](
+            IndexedDaryHeap<double>& queue, std::vector<double>& distance,
+            std::vector<int>& reachedBy, const std::vector<double>& otherDistance,
+            const std::vector<int>& offsets, const std::vector<int>& arcIds, bool forward)
+        {
+            int v = queue.pop();
+            double dv = distance[v];
+            countSettled(stats);
+
+            if (dv + otherDistance[v] < best)
+            {
+                best = dv + otherDistance[v];
+                meeting = v;
+            }
+
+            for (int slot = offsets[v]; slot < offsets[v + 1]; ++slot)
+            {
+                const Arc& arc = arcs[arcIds[slot]];
+                int w = forward ? arc.to : arc.from;
+                countRelaxed(stats);
+                double dw = dv + arc.weight;
+
+                if (dw < distance[w])
+                {
+                    search.touched.push_back(w);
+                    distance[w] = dw;
+                    reachedBy[w] = arcIds[slot];
+                    queue.pushOrDecrease(w, dw);
+                }
+            }
+        };
+
+    while (true)
+    {
+        // neither side can improve on the best path once its closest
+        // vertex is already at least that far away
+        bool forward = !search.forwardQueue.empty() && search.forwardQueue.topPriority() < best;
+        bool backward = !search.backwardQueue.empty() && search.backwardQueue.topPriority() < best;
+
+        if (!forward && !backward)
+        {
+            break;
+        }
+
+        if (forward && (!backward || search.forwardQueue.topPriority() <= search.backwardQueue.topPriority()))
+        {
+            settle(
+                search.forwardQueue, search.forwardDistance, search.forwardArc,
+                search.backwardDistance, upOffsets, upArcs, true);
+        }
+        else
+        {
+            settle(
+                search.backwardQueue, search.backwardDistance, search.backwardArc,
+                search.forwardDistance, downOffsets, downArcs, false);
+        }
+    }
+
+    timer.lap(&SearchStats::searchSeconds);
+
+    return meeting;
+}
+
+
+inline void ContractionHierarchy::unpack(
+    const ContractionHierarchySearch& search, int meetingIndex,
+    std::vector<int>& originalArcs) const
+{
+    // the arcs of the path in the hierarchy, some of them shortcuts
+    std::vector<int> path;
+
+    for (int v = meetingIndex; search.forwardArc[v] != -1; v = arcs[search.forwardArc[v]].from)
+    {
+        path.push_back(search.forwardArc[v]);
+    }
+
+    std::reverse(path.begin(), path.end());
+
+    for (int v = meetingIndex; search.backwardArc[v] != -1; v = arcs[search.backwardArc[v]].to)
+    {
+        path.push_back(search.backwardArc[v]);
+    }
+
+    // shortcuts are expanded with a stack rather than recursion, since
+    // they can nest very deeply on long paths
+    std::vector<int> pending(path.rbegin(), path.rend());
+
+    while (!pending.empty())
+    {
+        int a = pending.back();
+        pending.pop_back();
+
+        if (arcs[a].originalEdge != -1)
+        {
+            originalArcs.push_back(a);
+        }
+        else
+        {
+            pending.push_back(arcs[a].upperArc);
+            pending.push_back(arcs[a].lowerArc);
+        }
+    }
+}
+
+
+
+#endif // CONTRACTIONHIERARCHY_HPP
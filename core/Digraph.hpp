@@ -16,6 +16,22 @@
 // that they store different kinds of information about each vertex and
 // about each edge; these two types are the type parameters to the
 // Digraph class template.
+//
+// Vertices are found by number through a hash table, and edges through
+// another one keyed by their "from" and "to" vertex numbers, so looking up,
+// adding, or removing a single vertex or edge doesn't depend on how big
+// the rest of the graph is.
+//
+// Everything a Digraph allocates for its vertices and edges comes from a
+// std::pmr::memory_resource, which is the default one (i.e., new and
+// delete) unless the Digraph is given another.  Handing it a DigraphArena
+// (see DigraphArena.hpp) builds the whole graph out of a few large blocks
+// of memory, which are given back all at once when the graph is destroyed.
+//
+// The const member functions never modify anything, so any number of
+// threads can call them at the same time, as long as no thread modifies
+// the Digraph meanwhile and each thread searches in its own
+// ShortestPathTree (or BidirectionalSearchSpace).
 
 #ifndef DIGRAPH_HPP
 #define DIGRAPH_HPP
@@ -30,6 +46,17 @@
 #include <algorithm>
 #include <queue>
 #include <limits>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <tuple>
+#include "ShortestPathTree.hpp"
+#include "BidirectionalSearch.hpp"
+#include "AStarSearch.hpp"
+#include "StronglyConnectedComponents.hpp"
+#include "ShortestPathRepair.hpp"
 
 
 
@@ -55,9 +82,28 @@ inline DigraphException::DigraphException(const std::string& reason)
 // the edge points), a "to vertex" (the number of the vertex to which the
 // edge points), and an EdgeInfo object.  Because different kinds of Digraphs
 // store different kinds of edge information, DigraphEdge is a struct template.
+// It also remembers the dense indices of its "from vertex" and "to vertex",
+// so searches can follow it in either direction without looking vertex
+// numbers up.
 
 template <typename EdgeInfo>
 struct DigraphEdge
+{
+    int fromVertex;
+    int toVertex;
+    EdgeInfo einfo;
+    int fromIndex;
+    int toIndex;
+};
+
+
+
+// A DigraphEdgeListEntry describes one edge being handed to
+// Digraph::fromEdgeList(): its "from vertex", its "to vertex", and its
+// EdgeInfo object.
+
+template <typename EdgeInfo>
+struct DigraphEdgeListEntry
 {
     int fromVertex;
     int toVertex;
@@ -69,16 +115,64 @@ struct DigraphEdge
 // A DigraphVertex includes two things: a VertexInfo object and a list of
 // its outgoing edges.  Because different kinds of Digraphs store different
 // kinds of vertex and edge information, DigraphVertex is a struct template.
+// It also remembers its own dense index, along with a reverse index of its
+// incoming edges: pointers to the DigraphEdges, stored in other vertices'
+// lists, that point to it.
+//
+// A DigraphVertex's edges and incoming edges are allocated from the same
+// memory resource as the Digraph it belongs to, which hands it one
+// whenever it's constructed (see allocator_type below).
 
 template <typename VertexInfo, typename EdgeInfo>
 struct DigraphVertex
 {
     VertexInfo vinfo;
-    std::list<DigraphEdge<EdgeInfo>> edges;
+    std::pmr::list<DigraphEdge<EdgeInfo>> edges;
+    int index;
+    std::pmr::vector<DigraphEdge<EdgeInfo>*> incoming;
+
+    // Having an allocator_type tells the containers that DigraphVertex
+    // lives in to pass their allocator along to the constructors below.
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    DigraphVertex(VertexInfo vinfo, int index, const allocator_type& alloc = {});
+    DigraphVertex(const DigraphVertex& v, const allocator_type& alloc);
+    DigraphVertex(DigraphVertex&& v, const allocator_type& alloc);
+    DigraphVertex(DigraphVertex&& v) noexcept = default;
 };
 
 
 
+template <typename VertexInfo, typename EdgeInfo>
+DigraphVertex<VertexInfo, EdgeInfo>::DigraphVertex(VertexInfo vinfo, int index, const allocator_type& alloc)
+    : vinfo{std::move(vinfo)}, edges{alloc}, index{index}, incoming{alloc}
+{
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+DigraphVertex<VertexInfo, EdgeInfo>::DigraphVertex(const DigraphVertex& v, const allocator_type& alloc)
+    : vinfo{v.vinfo}, edges{v.edges, alloc}, index{v.index}, incoming{v.incoming, alloc}
+{
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+DigraphVertex<VertexInfo, EdgeInfo>::DigraphVertex(DigraphVertex&& v, const allocator_type& alloc)
+    : vinfo{std::move(v.vinfo)}, edges{std::move(v.edges), alloc}, index{v.index}, incoming{std::move(v.incoming), alloc}
+{
+}
+
+
+
+// CompactDigraph (declared in CompactDigraph.hpp) takes read-only snapshots
+// of a Digraph, so it's declared here in order to be made a friend.
+
+template <typename VertexInfo, typename EdgeInfo>
+class CompactDigraph;
+
+
+
 // Digraph is a class template that represents a directed graph implemented
 // using adjacency lists.  It takes two type parameters:
 //
@@ -100,12 +194,21 @@ public:
     // contains no vertices and no edges.
     Digraph();
 
+    // This constructor initializes a new, empty Digraph that allocates
+    // from the given memory resource, which must outlive it.
+    explicit Digraph(std::pmr::memory_resource* resource);
+
     // The copy constructor initializes a new Digraph to be a deep copy
     // of another one (i.e., any change to the copy will not affect the
-    // original).
+    // original).  The copy allocates from the default memory resource.
     Digraph(const Digraph& d);
 
-    // The move constructor initializes a new Digraph from an expiring one.
+    // This constructor initializes a new Digraph to be a deep copy of
+    // another one, allocating from the given memory resource instead.
+    Digraph(const Digraph& d, std::pmr::memory_resource* resource);
+
+    // The move constructor initializes a new Digraph from an expiring one,
+    // taking its memory resource along with everything in it.
     Digraph(Digraph&& d) noexcept;
 
     // The destructor deallocates any memory associated with the Digraph.
@@ -114,12 +217,33 @@ public:
     // The assignment operator assigns the contents of the given Digraph
     // into "this" Digraph, with "this" Digraph becoming a separate, deep
     // copy of the contents of the given one (i.e., any change made to
-    // "this" Digraph afterward will not affect the other).
+    // "this" Digraph afterward will not affect the other).  "this"
+    // Digraph keeps allocating from its own memory resource.
     Digraph& operator=(const Digraph& d);
 
     // The move assignment operator assigns the contents of an expiring
-    // Digraph into "this" Digraph.
-    Digraph& operator=(Digraph&& d) noexcept;
+    // Digraph into "this" Digraph.  "this" Digraph keeps its own memory
+    // resource, so if the two use different ones, the contents have to
+    // be moved over one vertex and edge at a time, which allocates.
+    Digraph& operator=(Digraph&& d);
+
+    // fromEdgeList() builds a Digraph all at once from a list of vertices
+    // (vertex numbers paired with VertexInfo objects) and a list of edges,
+    // which takes O(E log E) time instead of one lookup per addEdge() call.
+    // The lists are checked before anything is built: if any vertex
+    // number is listed twice, any edge is listed twice, or any edge has a
+    // vertex that isn't listed, one DigraphException describing all of
+    // them is thrown.  Each vertex's outgoing edges keep the order they
+    // were listed in, and dense indices (see below) are handed out in
+    // order of vertex number.  The Digraph allocates from the given
+    // memory resource.
+    static Digraph fromEdgeList(
+        std::vector<std::pair<int, VertexInfo>> vertices,
+        std::vector<DigraphEdgeListEntry<EdgeInfo>> edges,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // resource() returns the memory resource this Digraph allocates from.
+    std::pmr::memory_resource* resource() const noexcept;
 
     // vertices() returns a std::vector containing the vertex numbers of
     // every vertex in this Digraph.
@@ -137,29 +261,59 @@ public:
     // not exist, a DigraphException is thrown instead.
     std::vector<std::pair<int, int>> edges(int vertex) const;
 
+    // incomingEdges() returns a std::vector of std::pairs, in which each
+    // pair contains the "from" and "to" vertex numbers of an edge in this
+    // Digraph.  Only edges incoming to the given vertex number are
+    // included in the std::vector.  If the given vertex does not exist,
+    // a DigraphException is thrown instead.
+    std::vector<std::pair<int, int>> incomingEdges(int vertex) const;
+
     // vertexInfo() returns the VertexInfo object belonging to the vertex
     // with the given vertex number.  If that vertex does not exist, a
-    // DigraphException is thrown instead.
-    VertexInfo vertexInfo(int vertex) const;
+    // DigraphException is thrown instead.  The reference stays valid
+    // until the vertex is removed.
+    const VertexInfo& vertexInfo(int vertex) const;
 
     // edgeInfo() returns the EdgeInfo object belonging to the edge
     // with the given "from" and "to" vertex numbers.  If either of those
     // vertices does not exist *or* if the edge does not exist, a
-    // DigraphException is thrown instead.
-    EdgeInfo edgeInfo(int fromVertex, int toVertex) const;
+    // DigraphException is thrown instead.  The reference stays valid
+    // until the edge is removed or its EdgeInfo object is updated.
+    const EdgeInfo& edgeInfo(int fromVertex, int toVertex) const;
+
+    // tryVertexInfo() and findEdge() are like vertexInfo() and edgeInfo(),
+    // except that they return a pointer to the VertexInfo or EdgeInfo
+    // object, or nullptr if there's no such vertex or edge, instead of
+    // throwing.
+    const VertexInfo* tryVertexInfo(int vertex) const noexcept;
+    const EdgeInfo* findEdge(int fromVertex, int toVertex) const noexcept;
 
     // addVertex() adds a vertex to the Digraph with the given vertex
     // number and VertexInfo object.  If there is already a vertex in
     // the graph with the given vertex number, a DigraphException is
-    // thrown instead.
+    // thrown instead.  Given an rvalue, the VertexInfo object is moved
+    // into the Digraph rather than copied.
     void addVertex(int vertex, const VertexInfo& vinfo);
+    void addVertex(int vertex, VertexInfo&& vinfo);
 
     // addEdge() adds an edge to the Digraph pointing from the given
     // "from" vertex number to the given "to" vertex number, and
     // associates with the given EdgeInfo object with it.  If one
     // of the vertices does not exist *or* if the same edge is already
     // present in the graph, a DigraphException is thrown instead.
+    // Given an rvalue, the EdgeInfo object is moved rather than copied.
     void addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo);
+    void addEdge(int fromVertex, int toVertex, EdgeInfo&& einfo);
+
+    // emplaceVertex() and emplaceEdge() are like addVertex() and
+    // addEdge(), except that the VertexInfo or EdgeInfo object is
+    // constructed from the given arguments, which are only used once
+    // the vertex or edge is known to be one that can be added.
+    template <typename... Args>
+    void emplaceVertex(int vertex, Args&&... args);
+
+    template <typename... Args>
+    void emplaceEdge(int fromVertex, int toVertex, Args&&... args);
 
     // removeVertex() removes the vertex (and all of its incoming
     // and outgoing edges) with the given vertex number from the
@@ -174,6 +328,18 @@ public:
     // thrown instead.
     void removeEdge(int fromVertex, int toVertex);
 
+    // updateEdgeInfo() replaces the EdgeInfo object of the edge pointing
+    // from the given "from" vertex number to the given "to" vertex number,
+    // leaving the edge otherwise as it was.  If either of these vertices
+    // does not exist *or* if the edge is not present in the graph, a
+    // DigraphException is thrown instead.
+    void updateEdgeInfo(int fromVertex, int toVertex, const EdgeInfo& einfo);
+
+    // updateEdgeInfos() replaces the EdgeInfo objects of many edges at
+    // once.  Every edge is checked before any is changed, so if any of
+    // them doesn't exist, a DigraphException is thrown and nothing changes.
+    void updateEdgeInfos(const std::vector<DigraphEdgeListEntry<EdgeInfo>>& updates);
+
     // vertexCount() returns the number of vertices in the graph.
     int vertexCount() const noexcept;
 
@@ -192,6 +358,11 @@ public:
     // false otherwise.
     bool isStronglyConnected() const;
 
+    // stronglyConnectedComponents() works out which vertices can reach one
+    // another, returning the component of each vertex by dense index (see
+    // below).  Unused indices are in component -1.
+    StronglyConnectedComponents stronglyConnectedComponents() const;
+
     // findShortestPaths() takes a start vertex number and a function
     // that takes an EdgeInfo object and determines an edge weight.
     // It uses Dijkstra's Shortest Path Algorithm to determine the
@@ -206,6 +377,128 @@ public:
         int startVertex,
         std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
 
+    // This overload of findShortestPaths() runs the same algorithm, but
+    // writes its result into the given ShortestPathTree in terms of dense
+    // vertex indices (see below) instead of building a std::map.  Reusing
+    // one tree for many searches saves reallocating it every time.  If the
+    // start vertex does not exist, a DigraphException is thrown instead.
+    void findShortestPaths(
+        int startVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        ShortestPathTree& tree) const;
+
+    // findShortestPath() finds a single shortest path from the start
+    // vertex to the end vertex, using the given function to determine
+    // edge weights.  Unlike findShortestPaths(), it stops searching as
+    // soon as the end vertex's distance is known, so vertices further
+    // away than the end vertex are never visited.  If there's no path,
+    // the result's exists() is false.  If either vertex does not exist,
+    // a DigraphException is thrown instead.
+    ShortestPath findShortestPath(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // This overload of findShortestPath() does its searching in the given
+    // ShortestPathTree, so that it can be reused across searches.
+    ShortestPath findShortestPath(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        ShortestPathTree& tree) const;
+
+    // findShortestPathBidirectional() finds the same kind of path as
+    // findShortestPath(), but searches forward from the start vertex and
+    // backward from the end vertex at the same time, stopping once the two
+    // searches have met and can't find anything shorter.  This generally
+    // visits far fewer vertices than searching from one end only.  If
+    // either vertex does not exist, a DigraphException is thrown instead.
+    ShortestPath findShortestPathBidirectional(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // This overload of findShortestPathBidirectional() does its searching
+    // in the given BidirectionalSearchSpace, so that it can be reused.
+    ShortestPath findShortestPathBidirectional(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        BidirectionalSearchSpace& space) const;
+
+    // findShortestPathAStar() finds the same kind of path as
+    // findShortestPath(), but uses the A* algorithm to steer the search
+    // toward the end vertex.  estimateFunc takes the dense index of a
+    // vertex (see below) and must return a lower bound on the length of
+    // the shortest path from that vertex to the end vertex; the better
+    // the estimate, the fewer vertices are visited.  If either vertex
+    // does not exist, a DigraphException is thrown instead.
+    ShortestPath findShortestPathAStar(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        std::function<double(int)> estimateFunc) const;
+
+    // This overload of findShortestPathAStar() does its searching in the
+    // given ShortestPathTree, so that it can be reused across searches.
+    ShortestPath findShortestPathAStar(
+        int startVertex,
+        int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        std::function<double(int)> estimateFunc,
+        ShortestPathTree& tree) const;
+
+    // Each of the overloads above that searches in a ShortestPathTree or
+    // BidirectionalSearchSpace also comes in a version that takes any
+    // callable as its weight function (and, for A*, as its estimate), such
+    // as a lambda or a function object.  Those can be inlined into the
+    // search, where a std::function has to be called indirectly for every
+    // edge, so they're the ones to use when speed matters.
+    template <typename WeightFn>
+    void findShortestPaths(
+        int startVertex, WeightFn edgeWeightFunc, ShortestPathTree& tree) const;
+
+    template <typename WeightFn>
+    ShortestPath findShortestPath(
+        int startVertex, int endVertex, WeightFn edgeWeightFunc, ShortestPathTree& tree) const;
+
+    template <typename WeightFn>
+    ShortestPath findShortestPathBidirectional(
+        int startVertex, int endVertex, WeightFn edgeWeightFunc, BidirectionalSearchSpace& space) const;
+
+    template <typename WeightFn, typename EstimateFn>
+    ShortestPath findShortestPathAStar(
+        int startVertex, int endVertex, WeightFn edgeWeightFunc, EstimateFn estimateFunc,
+        ShortestPathTree& tree) const;
+
+    // repairShortestPaths() brings a tree filled in by findShortestPaths()
+    // up to date after the edges listed in changedEdges (as pairs of "from"
+    // and "to" vertex numbers) have had their EdgeInfo objects updated,
+    // which is usually much faster than searching again.  The weight
+    // function must be the one the tree was searched with.  If a listed
+    // edge does not exist, a DigraphException is thrown.
+    void repairShortestPaths(
+        ShortestPathTree& tree,
+        const std::vector<std::pair<int, int>>& changedEdges,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    template <typename WeightFn>
+    void repairShortestPaths(
+        ShortestPathTree& tree,
+        const std::vector<std::pair<int, int>>& changedEdges,
+        WeightFn edgeWeightFunc) const;
+
+    // Every vertex is also given a dense index, which stays the same for
+    // as long as the vertex exists; indices of removed vertices are handed
+    // out again to vertices added later.  indexBound() returns one more
+    // than the largest index in use.  indexOf() returns the index of the
+    // given vertex number, throwing a DigraphException if the vertex does
+    // not exist.  vertexNumber() returns the vertex number belonging to
+    // an index that is in use.
+    int indexBound() const noexcept;
+    int indexOf(int vertex) const;
+    int vertexNumber(int index) const noexcept;
+
 
 private:
     // Add whatever member variables you think you need here.  One
@@ -218,8 +511,40 @@ private:
 
 	// keep track of which keys belong to which vertex
 	// key = vertex number // value = outgoing edges
-    std::map<int, DigraphVertex<VertexInfo, EdgeInfo>> ImTheMap;
-
+    std::pmr::map<int, DigraphVertex<VertexInfo, EdgeInfo>> ImTheMap;
+
+    // dense index -> entry in ImTheMap, or nullptr for an index that's
+    // free; map nodes never move, so these stay valid until erased
+    std::vector<std::pair<const int, DigraphVertex<VertexInfo, EdgeInfo>>*> slots;
+    // indices given up by removed vertices, ready to be handed out again
+    std::vector<int> freeSlots;
+
+    // vertex number -> dense index, for finding a vertex without walking
+    // down ImTheMap
+    std::pmr::unordered_map<int, int> indexLookup;
+    // edgeKey(from, to) -> the edge's place in its from vertex's list;
+    // list nodes never move either, so these stay valid until erased
+    std::pmr::unordered_map<std::uint64_t, typename std::pmr::list<DigraphEdge<EdgeInfo>>::iterator> edgeLookup;
+
+    // edgeKey() packs a "from" and "to" vertex number into one key
+    static std::uint64_t edgeKey(int fromVertex, int toVertex) noexcept;
+
+    // findVertex() returns the vertex with the given number, or nullptr
+    // if there isn't one
+    DigraphVertex<VertexInfo, EdgeInfo>* findVertex(int vertex) noexcept;
+    const DigraphVertex<VertexInfo, EdgeInfo>* findVertex(int vertex) const noexcept;
+
+    // rebuildIndexes() points slots, both lookups, and every vertex's
+    // incoming edges at the entries of ImTheMap again, which is needed
+    // after ImTheMap has been copied from another Digraph
+    void rebuildIndexes(int indexBound);
+
+    // unlinkIncoming() removes an edge from the reverse index of the
+    // vertex it points to
+    void unlinkIncoming(const DigraphEdge<EdgeInfo>* edge);
+
+    // CompactDigraph reads ImTheMap directly when it takes a snapshot
+    friend class CompactDigraph<VertexInfo, EdgeInfo>;
 };
 
 
@@ -230,28 +555,49 @@ private:
 
 template <typename VertexInfo, typename EdgeInfo>
 Digraph<VertexInfo, EdgeInfo>::Digraph()
+	: Digraph{std::pmr::get_default_resource()}
 {
 	// empty by default, so nothing
 }
 
 
+template <typename VertexInfo, typename EdgeInfo>
+Digraph<VertexInfo, EdgeInfo>::Digraph(std::pmr::memory_resource* resource)
+	: ImTheMap{resource}, indexLookup{resource}, edgeLookup{resource}
+{
+	// still empty // everything just knows where to allocate from
+}
+
+
 template <typename VertexInfo, typename EdgeInfo>
 Digraph<VertexInfo, EdgeInfo>::Digraph(const Digraph& d)
+	: Digraph{d, std::pmr::get_default_resource()}
 {
-	// clear current map
-	this->ImTheMap.clear();
-	// copies the map
-	this->ImTheMap = d.ImTheMap;	
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+Digraph<VertexInfo, EdgeInfo>::Digraph(const Digraph& d, std::pmr::memory_resource* resource)
+	: Digraph{resource}
+{
+	// copies the map into our own resource
+	this->ImTheMap = d.ImTheMap;
+	// same indices, but pointing into our own copy of the map
+	this->freeSlots = d.freeSlots;
+	rebuildIndexes(d.slots.size());
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
 Digraph<VertexInfo, EdgeInfo>::Digraph(Digraph&& d) noexcept
+	// moves dying map in d into current map, along with d's resource; map
+	// nodes move along with it, so the slots can just be taken
+	: ImTheMap{std::move(d.ImTheMap)},
+	  slots{std::move(d.slots)},
+	  freeSlots{std::move(d.freeSlots)},
+	  indexLookup{std::move(d.indexLookup)},
+	  edgeLookup{std::move(d.edgeLookup)}
 {
-	// clear current map
-	this->ImTheMap.clear();
-	// moves dying map in d into current map
-	this->ImTheMap = std::move(d.ImTheMap);
 }
 
 
@@ -269,28 +615,183 @@ Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(const Di
 	ImTheMap.clear();
 	// d's ImTheMap is assigned this's map
 	this->ImTheMap = d.ImTheMap;
+	// same indices, but pointing into our own copy of the map
+	this->freeSlots = d.freeSlots;
+	rebuildIndexes(d.slots.size());
     return *this;
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(Digraph&& d) noexcept
+Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(Digraph&& d)
 {
 	// make sure existing map is cleared
 	ImTheMap.clear();
 	// d's ImTheMap is assigned this's map by std::move
 	this->ImTheMap = std::move(d.ImTheMap);
+	this->freeSlots = std::move(d.freeSlots);
+	if (resource() == d.resource())
+	{
+		// map nodes move along with it, so the slots can just be taken
+		this->slots = std::move(d.slots);
+		this->indexLookup = std::move(d.indexLookup);
+		this->edgeLookup = std::move(d.edgeLookup);
+	}
+	else
+	{
+		// every node was moved into a new one of ours, so nothing in d's
+		// indexes points at the right place anymore
+		rebuildIndexes(d.slots.size());
+		d.ImTheMap.clear();
+		d.slots.clear();
+		d.indexLookup.clear();
+		d.edgeLookup.clear();
+	}
     return *this;
 }
 
 
+template <typename VertexInfo, typename EdgeInfo>
+Digraph<VertexInfo, EdgeInfo> Digraph<VertexInfo, EdgeInfo>::fromEdgeList(
+    std::vector<std::pair<int, VertexInfo>> vertices,
+    std::vector<DigraphEdgeListEntry<EdgeInfo>> edges,
+    std::pmr::memory_resource* resource)
+{
+	// vertex numbers in order, so duplicates end up side by side
+	std::stable_sort(vertices.begin(), vertices.end(),
+		[](const std::pair<int, VertexInfo>& a, const std::pair<int, VertexInfo>& b)
+		{
+			return a.first < b.first;
+		});
+
+	// edges are sorted by position rather than moved around, so that each
+	// vertex's list can be built in the order the edges were given
+	std::vector<int> inOrder(edges.size());
+	for (int e = 0; e < static_cast<int>(edges.size()); ++e)
+	{
+		inOrder[e] = e;
+	}
+	std::sort(inOrder.begin(), inOrder.end(),
+		[&edges](int a, int b)
+		{
+			if (edges[a].fromVertex != edges[b].fromVertex)
+			{
+				return edges[a].fromVertex < edges[b].fromVertex;
+			}
+			if (edges[a].toVertex != edges[b].toVertex)
+			{
+				return edges[a].toVertex < edges[b].toVertex;
+			}
+			return a < b;
+		});
+
+	// every complaint, so they can all be reported at once
+	std::vector<std::string> WhatWentWrong;
+	int SilentComplaints = 0;
+	auto complain = [&WhatWentWrong, &SilentComplaints](std::string complaint)
+	{
+		// a handful is enough to go on; the rest are just counted
+		if (WhatWentWrong.size() < 10)
+		{
+			WhatWentWrong.push_back(std::move(complaint));
+		}
+		else
+		{
+			++SilentComplaints;
+		}
+	};
+
+	for (int i = 1; i < static_cast<int>(vertices.size()); ++i)
+	{
+		if (vertices[i].first == vertices[i - 1].first)
+		{
+			complain("vertex " + std::to_string(vertices[i].first) + " is listed more than once");
+		}
+	}
+
+	auto listed = [&vertices](int vertex)
+	{
+		typename std::vector<std::pair<int, VertexInfo>>::const_iterator itr = std::lower_bound(
+			vertices.begin(), vertices.end(), vertex,
+			[](const std::pair<int, VertexInfo>& v, int number)
+			{
+				return v.first < number;
+			});
+		return itr != vertices.end() && itr->first == vertex;
+	};
+
+	for (int i = 0; i < static_cast<int>(inOrder.size()); ++i)
+	{
+		const DigraphEdgeListEntry<EdgeInfo>& edge = edges[inOrder[i]];
+		std::string name = std::to_string(edge.fromVertex) + " -> " + std::to_string(edge.toVertex);
+
+		if (i > 0 && edge.fromVertex == edges[inOrder[i - 1]].fromVertex && edge.toVertex == edges[inOrder[i - 1]].toVertex)
+		{
+			complain("edge " + name + " is listed more than once");
+		}
+		else if (!listed(edge.fromVertex) || !listed(edge.toVertex))
+		{
+			complain("edge " + name + " has a vertex that isn't listed");
+		}
+	}
+
+	if (!WhatWentWrong.empty())
+	{
+		std::string reason = "Not a valid edge list: ";
+		for (int i = 0; i < static_cast<int>(WhatWentWrong.size()); ++i)
+		{
+			reason += (i == 0 ? "" : "; ") + WhatWentWrong[i];
+		}
+		if (SilentComplaints > 0)
+		{
+			reason += "; and " + std::to_string(SilentComplaints) + " more";
+		}
+		throw DigraphException(reason);
+	}
+
+	// the lists are good, so build everything in one go // indices follow
+	// vertex numbers, and every insertion lands at the end of ImTheMap
+	Digraph BobTheBuilder{resource};
+	BobTheBuilder.slots.reserve(vertices.size());
+	BobTheBuilder.indexLookup.reserve(vertices.size());
+	for (std::pair<int, VertexInfo>& vertex : vertices)
+	{
+		int index = BobTheBuilder.slots.size();
+		typename std::pmr::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::iterator itr = BobTheBuilder.ImTheMap.emplace_hint(
+			BobTheBuilder.ImTheMap.end(), std::piecewise_construct,
+			std::forward_as_tuple(vertex.first), std::forward_as_tuple(std::move(vertex.second), index));
+		BobTheBuilder.slots.push_back(&*itr);
+		BobTheBuilder.indexLookup.emplace(vertex.first, index);
+	}
+
+	BobTheBuilder.edgeLookup.reserve(edges.size());
+	for (DigraphEdgeListEntry<EdgeInfo>& edge : edges)
+	{
+		DigraphVertex<VertexInfo, EdgeInfo>& fromBoi = *BobTheBuilder.findVertex(edge.fromVertex);
+		DigraphVertex<VertexInfo, EdgeInfo>& toBoi = *BobTheBuilder.findVertex(edge.toVertex);
+		fromBoi.edges.push_back(DigraphEdge<EdgeInfo>{edge.fromVertex, edge.toVertex, std::move(edge.einfo), fromBoi.index, toBoi.index});
+		BobTheBuilder.edgeLookup.emplace(edgeKey(edge.fromVertex, edge.toVertex), std::prev(fromBoi.edges.end()));
+		toBoi.incoming.push_back(&fromBoi.edges.back());
+	}
+
+	return BobTheBuilder;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+std::pmr::memory_resource* Digraph<VertexInfo, EdgeInfo>::resource() const noexcept
+{
+	return ImTheMap.get_allocator().resource();
+}
+
+
 template <typename VertexInfo, typename EdgeInfo>
 std::vector<int> Digraph<VertexInfo, EdgeInfo>::vertices() const
 {
 	// vector of vertex numbers
 	std::vector<int> ArthriticJoints;
 	// iterate through map to get int number
-	for (typename std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
+	for (typename std::pmr::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
 	{
 		// push int vertex number to vector
 		ArthriticJoints.push_back(itr->first);
@@ -305,10 +806,10 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges() const
 	// vector of pairs of ints
 	std::vector<std::pair<int, int>> BoneHurtingJuice;
 	// iterate through map
-	for (typename std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
+	for (typename std::pmr::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
 	{
 		// iterate through std::list edges within the map
-		for (typename std::list<DigraphEdge<EdgeInfo>>::const_iterator igor = itr->second.edges.begin(); igor != itr->second.edges.end(); ++igor)
+		for (typename std::pmr::list<DigraphEdge<EdgeInfo>>::const_iterator igor = itr->second.edges.begin(); igor != itr->second.edges.end(); ++igor)
 		{
 			// push back the to BoneHurtingJuice <fromVertex, toVertex> in the std::list edges
 			BoneHurtingJuice.push_back(std::pair<int, int>(igor->fromVertex, igor->toVertex));
@@ -328,27 +829,21 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges(int vertex
 	}
 	// check if map even has the vertex number
 	// if == then not found // else if != then not found
-	else if (ImTheMap.find(vertex) == ImTheMap.end())
+	else if (findVertex(vertex) == nullptr)
 	{
 		throw DigraphException("No edges exist that are outgoing from this vertex");
 	}
 	// else make the vector of pairs of int
 	else
 	{
+		const std::pmr::list<DigraphEdge<EdgeInfo>>& fromEdges = findVertex(vertex)->edges;
 		std::vector<std::pair<int, int>> BoneHurtingJuice;
-		// iterate through map
-		for (typename std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
+		BoneHurtingJuice.reserve(fromEdges.size());
+		// every edge going out of vertex is in its own list, and nowhere else
+		for (typename std::pmr::list<DigraphEdge<EdgeInfo>>::const_iterator igor = fromEdges.begin(); igor != fromEdges.end(); ++igor)
 		{
-			// iterate through std::list edges within the map
-			for (typename std::list<DigraphEdge<EdgeInfo>>::const_iterator igor = itr->second.edges.begin(); igor != itr->second.edges.end(); ++igor)
-			{
-				// if fromVertex is == vertex
-				if (igor->fromVertex == vertex)
-				{
-					// push back the to BoneHurtingJuice <fromVertex, toVertex> in the std::list edges
-					BoneHurtingJuice.push_back(std::pair<int, int>(igor->fromVertex, igor->toVertex));
-				}	
-			}
+			// push back the to BoneHurtingJuice <fromVertex, toVertex> in the std::list edges
+			BoneHurtingJuice.push_back(std::pair<int, int>(igor->fromVertex, igor->toVertex));
 		}
 		return BoneHurtingJuice;
 	}
@@ -357,28 +852,48 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges(int vertex
 
 
 template <typename VertexInfo, typename EdgeInfo>
-VertexInfo Digraph<VertexInfo, EdgeInfo>::vertexInfo(int vertex) const
+std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::incomingEdges(int vertex) const
+{
+	// check if map even has the vertex number
+	const DigraphVertex<VertexInfo, EdgeInfo>* toBoi = findVertex(vertex);
+	if (toBoi == nullptr)
+	{
+		throw DigraphException("No vertex with that number exists");
+	}
+	std::vector<std::pair<int, int>> BoneHurtingJuice;
+	// the reverse index already has them all
+	for (const DigraphEdge<EdgeInfo>* edge : toBoi->incoming)
+	{
+		BoneHurtingJuice.push_back(std::pair<int, int>(edge->fromVertex, edge->toVertex));
+	}
+	return BoneHurtingJuice;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+const VertexInfo& Digraph<VertexInfo, EdgeInfo>::vertexInfo(int vertex) const
 {
 	// Check if map is empty
 	if (ImTheMap.size() == 0)
 	{
 		throw DigraphException("Empty Digraph");
 	}
+	const DigraphVertex<VertexInfo, EdgeInfo>* vertexBoi = findVertex(vertex);
 	// Check if vertex given even exists
-	else if (ImTheMap.find(vertex) == ImTheMap.end())
+	if (vertexBoi == nullptr)
 	{
 		throw DigraphException("No vertex with that number exists");
 	}
 	// return the value.vinfo at key
 	else
 	{
-		return ImTheMap.at(vertex).vinfo;
+		return vertexBoi->vinfo;
 	}
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-EdgeInfo Digraph<VertexInfo, EdgeInfo>::edgeInfo(int fromVertex, int toVertex) const
+const EdgeInfo& Digraph<VertexInfo, EdgeInfo>::edgeInfo(int fromVertex, int toVertex) const
 {
 	// check if map is empty
 	if (ImTheMap.size() == 0)
@@ -387,70 +902,131 @@ EdgeInfo Digraph<VertexInfo, EdgeInfo>::edgeInfo(int fromVertex, int toVertex) c
 	}
 	// check if fromVertex exists
 	// if == then not found // else if != then not found
-	if (ImTheMap.find(fromVertex) == ImTheMap.end() || ImTheMap.find(toVertex) == ImTheMap.end())
+	if (findVertex(fromVertex) == nullptr || findVertex(toVertex) == nullptr)
 	{
 		throw DigraphException("No such vertex with that number exists");
 	}
 	else
 	{
-		// iterate through map
-		for (typename std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
+		// the edge lookup knows exactly where the edge is, if it's anywhere
+		typename std::pmr::unordered_map<std::uint64_t, typename std::pmr::list<DigraphEdge<EdgeInfo>>::iterator>::const_iterator itr =
+			edgeLookup.find(edgeKey(fromVertex, toVertex));
+		if (itr == edgeLookup.end())
 		{
-			// iterate through std::list edges within the map
-			for (typename std::list<DigraphEdge<EdgeInfo>>::const_iterator igor = itr->second.edges.begin(); igor != itr->second.edges.end(); ++igor)
-			{
-				// if vertices match, return to edge info
-				if (igor->fromVertex == fromVertex && igor->toVertex == toVertex)
-				{
-					return igor->einfo;
-				}
-			}
+			throw DigraphException("No such edge exists");
 		}
-		throw DigraphException("No such edge exists");
+		return itr->second->einfo;
 	}
 }
 
 
+template <typename VertexInfo, typename EdgeInfo>
+const VertexInfo* Digraph<VertexInfo, EdgeInfo>::tryVertexInfo(int vertex) const noexcept
+{
+	const DigraphVertex<VertexInfo, EdgeInfo>* vertexBoi = findVertex(vertex);
+	return vertexBoi == nullptr ? nullptr : &vertexBoi->vinfo;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+const EdgeInfo* Digraph<VertexInfo, EdgeInfo>::findEdge(int fromVertex, int toVertex) const noexcept
+{
+	// no edge without both vertices, so the lookup alone is enough
+	typename std::pmr::unordered_map<std::uint64_t, typename std::pmr::list<DigraphEdge<EdgeInfo>>::iterator>::const_iterator itr =
+		edgeLookup.find(edgeKey(fromVertex, toVertex));
+	return itr == edgeLookup.end() ? nullptr : &itr->second->einfo;
+}
+
+
 template <typename VertexInfo, typename EdgeInfo>
 void Digraph<VertexInfo, EdgeInfo>::addVertex(int vertex, const VertexInfo& vinfo)
+{
+	emplaceVertex(vertex, vinfo);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::addVertex(int vertex, VertexInfo&& vinfo)
+{
+	emplaceVertex(vertex, std::move(vinfo));
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename... Args>
+void Digraph<VertexInfo, EdgeInfo>::emplaceVertex(int vertex, Args&&... args)
 {
 	// if there's at least already one with same key
 	// if != to end, then there exists a key already
-	if (ImTheMap.find(vertex) != ImTheMap.end())
+	if (findVertex(vertex) != nullptr)
 	{
 		throw DigraphException("Vertex already exists");
 	}
 	else
 	{
+		// reuse a free index if there is one, otherwise take a new one
+		int index = slots.size();
+		if (!freeSlots.empty())
+		{
+			index = freeSlots.back();
+		}
 		// insert into the map the vertex key and a new Digraph vertex
-		ImTheMap.insert(std::pair<int, DigraphVertex<VertexInfo, EdgeInfo>>(vertex, DigraphVertex<VertexInfo, EdgeInfo>{vinfo}));
+		typename std::pmr::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::iterator itr = ImTheMap.emplace(
+			std::piecewise_construct, std::forward_as_tuple(vertex),
+			std::forward_as_tuple(VertexInfo(std::forward<Args>(args)...), index)).first;
+		// remember where the new vertex lives
+		if (index == static_cast<int>(slots.size()))
+		{
+			slots.push_back(&*itr);
+		}
+		else
+		{
+			freeSlots.pop_back();
+			slots[index] = &*itr;
+		}
+		indexLookup.emplace(vertex, index);
 	}
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
 void Digraph<VertexInfo, EdgeInfo>::addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo)
+{
+	emplaceEdge(fromVertex, toVertex, einfo);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::addEdge(int fromVertex, int toVertex, EdgeInfo&& einfo)
+{
+	emplaceEdge(fromVertex, toVertex, std::move(einfo));
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename... Args>
+void Digraph<VertexInfo, EdgeInfo>::emplaceEdge(int fromVertex, int toVertex, Args&&... args)
 {
 	// check if vertices exist
 	// if == then not found // else if != then not found
-	if (ImTheMap.find(fromVertex) == ImTheMap.end() || ImTheMap.find(toVertex) == ImTheMap.end())
+	DigraphVertex<VertexInfo, EdgeInfo>* fromBoi = findVertex(fromVertex);
+	DigraphVertex<VertexInfo, EdgeInfo>* toBoi = findVertex(toVertex);
+	if (fromBoi == nullptr || toBoi == nullptr)
 	{
 		throw DigraphException("One or Both vertex does not exist");
 	}
 	// check if edge already exists
-	for (typename std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
+	if (edgeLookup.find(edgeKey(fromVertex, toVertex)) != edgeLookup.end())
 	{
-		// iterate through std::list edges within the map
-		for (typename std::list<DigraphEdge<EdgeInfo>>::const_iterator igor = itr->second.edges.begin(); igor != itr->second.edges.end(); ++igor)
-		{
-			if (igor->fromVertex == fromVertex && igor->toVertex == toVertex)
-			{
-				throw DigraphException("Not a valid edge");
-			}
-		}
+		throw DigraphException("Not a valid edge");
 	}
 	// push back the edge inside a vertex
-	ImTheMap.at(fromVertex).edges.push_back(DigraphEdge<EdgeInfo>{fromVertex, toVertex, einfo});
+	fromBoi->edges.push_back(DigraphEdge<EdgeInfo>{
+		fromVertex, toVertex, EdgeInfo(std::forward<Args>(args)...), fromBoi->index, toBoi->index});
+	// remember where it went
+	edgeLookup.emplace(edgeKey(fromVertex, toVertex), std::prev(fromBoi->edges.end()));
+	// and let the to vertex know it's there
+	toBoi->incoming.push_back(&fromBoi->edges.back());
 
 }
 
@@ -460,28 +1036,38 @@ void Digraph<VertexInfo, EdgeInfo>::removeVertex(int vertex)
 {
 	// check if vertex exists
 	// if == then not found // else if != then not found
-	if (ImTheMap.find(vertex) == ImTheMap.end())
+	if (findVertex(vertex) == nullptr)
 	{
 		throw DigraphException("Vertex does not exist");
 	}
-	else
+	DigraphVertex<VertexInfo, EdgeInfo>& doomed = *findVertex(vertex);
+	// the reverse index says exactly whose lists point at this vertex
+	for (DigraphEdge<EdgeInfo>* inBoi : doomed.incoming)
 	{
-		// iterate through map
-		for (typename std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
+		// self loops go away along with the vertex's own list
+		if (inBoi->fromIndex == doomed.index)
 		{
-			// iterate through std::list edges within the map
-			// FoL is element in list
-			for (typename std::list<DigraphEdge<EdgeInfo>>::iterator FoL = itr->second.edges.begin(); FoL != itr->second.edges.end(); ++FoL)
-			{
-				// if FoL == vertex given
-				if (FoL->toVertex == vertex)
-				{
-					// delete from edge
-					itr->second.edges.erase(FoL);
-				}
-			}
+			continue;
+		}
+		// FoL is element in list, found without looking through the list
+		typename std::pmr::unordered_map<std::uint64_t, typename std::pmr::list<DigraphEdge<EdgeInfo>>::iterator>::iterator FoL =
+			edgeLookup.find(edgeKey(inBoi->fromVertex, inBoi->toVertex));
+		slots[inBoi->fromIndex]->second.edges.erase(FoL->second);
+		edgeLookup.erase(FoL);
+	}
+	// outgoing edges have to come out of their to vertex's reverse index
+	for (DigraphEdge<EdgeInfo>& outBoi : doomed.edges)
+	{
+		if (outBoi.toIndex != doomed.index)
+		{
+			unlinkIncoming(&outBoi);
 		}
+		edgeLookup.erase(edgeKey(outBoi.fromVertex, outBoi.toVertex));
 	}
+	// give up the vertex's index so a later vertex can have it
+	slots[doomed.index] = nullptr;
+	freeSlots.push_back(doomed.index);
+	indexLookup.erase(vertex);
 	// finally erase the vertex from map
 	ImTheMap.erase(vertex);
 }
@@ -492,35 +1078,63 @@ void Digraph<VertexInfo, EdgeInfo>::removeEdge(int fromVertex, int toVertex)
 {
 	// check if vertices exist
 	// if == then not found // else if != then not found
-	if (ImTheMap.find(fromVertex) == ImTheMap.end() || ImTheMap.find(toVertex) == ImTheMap.end())
+	DigraphVertex<VertexInfo, EdgeInfo>* fromBoi = findVertex(fromVertex);
+	if (fromBoi == nullptr || findVertex(toVertex) == nullptr)
 	{
 		throw DigraphException("Either one vertex or both vertcies do not exist");
 	}
-	// checking if toVertex && fromVertex exists together
-	else
+	// FoL is element in list, if the edge lookup has one
+	typename std::pmr::unordered_map<std::uint64_t, typename std::pmr::list<DigraphEdge<EdgeInfo>>::iterator>::iterator FoL =
+		edgeLookup.find(edgeKey(fromVertex, toVertex));
+	if (FoL == edgeLookup.end())
 	{
-		// use std::find to find pair in vector of pairs
-		std::vector<std::pair<int, int>> EdgeLords = edges();
-		// if find becomes end, not found
-		if (std::find(EdgeLords.begin(), EdgeLords.end(), std::pair<int, int>(fromVertex, toVertex)) == EdgeLords.end())
+		throw DigraphException("Edge does not exist");
+	}
+	// out of the reverse index, then out of the list, then out of the lookup
+	unlinkIncoming(&*FoL->second);
+	fromBoi->edges.erase(FoL->second);
+	edgeLookup.erase(FoL);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::updateEdgeInfo(int fromVertex, int toVertex, const EdgeInfo& einfo)
+{
+	if (findVertex(fromVertex) == nullptr || findVertex(toVertex) == nullptr)
+	{
+		throw DigraphException("Either one vertex or both vertcies do not exist");
+	}
+	typename std::pmr::unordered_map<std::uint64_t, typename std::pmr::list<DigraphEdge<EdgeInfo>>::iterator>::iterator FoL =
+		edgeLookup.find(edgeKey(fromVertex, toVertex));
+	if (FoL == edgeLookup.end())
+	{
+		throw DigraphException("Edge does not exist");
+	}
+	// same edge, same place in every list and index, just new info
+	FoL->second->einfo = einfo;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::updateEdgeInfos(const std::vector<DigraphEdgeListEntry<EdgeInfo>>& updates)
+{
+	// look before leaping, so that a bad update leaves everything alone
+	std::pmr::vector<DigraphEdge<EdgeInfo>*> Targets;
+	Targets.reserve(updates.size());
+	for (const DigraphEdgeListEntry<EdgeInfo>& update : updates)
+	{
+		typename std::pmr::unordered_map<std::uint64_t, typename std::pmr::list<DigraphEdge<EdgeInfo>>::iterator>::iterator FoL =
+			edgeLookup.find(edgeKey(update.fromVertex, update.toVertex));
+		if (FoL == edgeLookup.end())
 		{
-			throw DigraphException("Edge does not exist");
+			throw DigraphException(
+				"Edge " + std::to_string(update.fromVertex) + " -> " + std::to_string(update.toVertex) + " does not exist");
 		}
+		Targets.push_back(&*FoL->second);
 	}
-	// iterate through map
-	for (typename std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
+	for (int i = 0; i < static_cast<int>(updates.size()); ++i)
 	{
-		// iterate through std::list edges within the map
-		// FoL is element in list
-		for (typename std::list<DigraphEdge<EdgeInfo>>::iterator FoL = itr->second.edges.begin(); FoL != itr->second.edges.end(); ++FoL)
-			{
-				// if equal to toVertex && fromVertex
-				if (FoL->toVertex == toVertex && FoL->fromVertex == fromVertex)
-				{
-					// delete FoL
-					itr->second.edges.erase(FoL);
-				}
-			}
+		Targets[i]->einfo = updates[i].einfo;
 	}
 }
 
@@ -536,13 +1150,8 @@ int Digraph<VertexInfo, EdgeInfo>::vertexCount() const noexcept
 template <typename VertexInfo, typename EdgeInfo>
 int Digraph<VertexInfo, EdgeInfo>::edgeCount() const noexcept
 {
-    int EdgeLordCouncil = 0;
-    for (typename std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
-    {
-    	// size of list of edges is how many edges that vertex has
-    	EdgeLordCouncil += itr->second.edges.size();
-    }
-    return EdgeLordCouncil;
+	// every edge has exactly one entry in the edge lookup
+    return edgeLookup.size();
 }
 
 
@@ -551,14 +1160,15 @@ int Digraph<VertexInfo, EdgeInfo>::edgeCount(int vertex) const
 {
 	// check if vertex exists
 	// if == then not found // else if != then not found
-	if (ImTheMap.find(vertex) == ImTheMap.end())
+	const DigraphVertex<VertexInfo, EdgeInfo>* vertexBoi = findVertex(vertex);
+	if (vertexBoi == nullptr)
 	{
 		throw DigraphException("Vertex does not exist");
 	}
 	// else return the size of edge list that vertex has
 	else
 	{
-		return ImTheMap.at(vertex).edges.size();
+		return vertexBoi->edges.size();
 	}
 }
 
@@ -567,79 +1177,426 @@ int Digraph<VertexInfo, EdgeInfo>::edgeCount(int vertex) const
 template <typename VertexInfo, typename EdgeInfo>
 bool Digraph<VertexInfo, EdgeInfo>::isStronglyConnected() const
 {
-	for (typename std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
-	{
-		// strongly connected vertex should have the same number of edges as there are as many vertices
-		if (edgeCount(itr->first) != vertexCount())
+	// strongly connected means everybody's in the one component (and an
+	// empty Digraph has nobody to be disconnected from)
+	return stronglyConnectedComponents().count <= 1;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+StronglyConnectedComponents Digraph<VertexInfo, EdgeInfo>::stronglyConnectedComponents() const
+{
+	StronglyConnectedComponents IslandHopper;
+	findStronglyConnectedComponents(
+		IslandHopper, slots.size(),
+		[this](int v)
 		{
-			return false;
-		}
-	}
-	return true;
-}	
+			// removed vertices leave holes in the slots
+			return slots[v] != nullptr;
+		},
+		[this](int v, auto visit)
+		{
+			for (const DigraphEdge<EdgeInfo>& edge : slots[v]->second.edges)
+			{
+				visit(edge.toIndex);
+			}
+		});
+	return IslandHopper;
+}
+
 
 template <typename VertexInfo, typename EdgeInfo>
 std::map<int, int> Digraph<VertexInfo, EdgeInfo>::findShortestPaths(
     int startVertex,
     std::function<double(const EdgeInfo&)> edgeWeightFunc) const
 {
-	// kv = unvisited boolean flags
-	std::map<int, bool> lonelyBoi;
-	// dv = distance mapping
-	std::map<int, double> shortBoi;
-	// pv = predecessor
+	// dense distances + predecessors
+	ShortestPathTree treeBoi;
+	findShortestPaths(startVertex, edgeWeightFunc, treeBoi);
+
+	// pv = predecessor, by vertex number this time
 	std::map<int, int> pathBoi;
-	// queue with min as priority
-	std::priority_queue<int, std::vector<int>, std::greater<int>> qtBoi;
-	// for each vertex in the map
-	for (typename std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator iro = ImTheMap.begin(); iro != ImTheMap.end(); ++iro)
-	{
-		// queue each vertex
-		qtBoi.push(iro->first);
-		// set kv = false
-		lonelyBoi[iro->first] = false;
-		// set dv = "infinite"
-		shortBoi[iro->first] = INT_MAX;
-	}
-
-	// setting first vertex in dv to 0
-	shortBoi[startVertex] = 0;
-	// setting first predecessor to itself
-	pathBoi[startVertex] = startVertex;
-
-	//while queue isnt empty
-	while (!qtBoi.empty())
-	{
-		// v = take the most priority in the queue
-		int curry_Boi = qtBoi.top();
-		// set boolean flag to true
-		lonelyBoi[curry_Boi] = true;
-		// dequeue the top
-		qtBoi.pop();
-		// for each edge from vertex
-		for (typename std::list<DigraphEdge<EdgeInfo>>::const_iterator igor = ImTheMap.at(curry_Boi).edges.begin();
-		 igor != ImTheMap.at(curry_Boi).edges.end(); ++igor)
-		{
-			// set kw to true
-			lonelyBoi[igor->toVertex] = true;	
-			// calculate dv weight
-			double dv = shortBoi[curry_Boi] + edgeWeightFunc(igor->einfo);
-			// dw = neighbor vertex
-			double dw = igor->toVertex;
-
-			if (shortBoi[dw] > dv)
+	for (typename std::pmr::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::const_iterator iro = ImTheMap.begin(); iro != ImTheMap.end(); ++iro)
+	{
+		int pv = treeBoi.predecessor[iro->second.index];
+		// no predecessor (start or unreached) means it points at itself
+		pathBoi.emplace_hint(pathBoi.end(), iro->first, pv == -1 ? iro->first : vertexNumber(pv));
+	}
+
+	return pathBoi;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::findShortestPaths(
+    int startVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    ShortestPathTree& tree) const
+{
+	// same search, just with the weight function behind a std::function
+	findShortestPaths<std::function<double(const EdgeInfo&)>>(startVertex, edgeWeightFunc, tree);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn>
+void Digraph<VertexInfo, EdgeInfo>::findShortestPaths(
+    int startVertex, WeightFn edgeWeightFunc, ShortestPathTree& tree) const
+{
+	// dense index of the start vertex
+	int start = indexOf(startVertex);
+
+	searchShortestPaths(
+		tree, slots.size(), start,
+		[this, &edgeWeightFunc](int v, auto relax)
+		{
+			// for each edge from vertex, hand over dw + C(v, w)
+			for (const DigraphEdge<EdgeInfo>& edge : slots[v]->second.edges)
+			{
+				relax(edge.toIndex, edgeWeightFunc(edge.einfo));
+			}
+		});
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPath(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+	ShortestPathTree treeBoi;
+	return findShortestPath(startVertex, endVertex, edgeWeightFunc, treeBoi);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPath(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    ShortestPathTree& tree) const
+{
+	return findShortestPath<std::function<double(const EdgeInfo&)>>(startVertex, endVertex, edgeWeightFunc, tree);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPath(
+    int startVertex, int endVertex, WeightFn edgeWeightFunc, ShortestPathTree& tree) const
+{
+	// dense indices of both ends
+	int start = indexOf(startVertex);
+	int end = indexOf(endVertex);
+
+	// same search as findShortestPaths, but it stops once end is settled
+	searchShortestPaths(
+		tree, slots.size(), start,
+		[this, &edgeWeightFunc](int v, auto relax)
+		{
+			for (const DigraphEdge<EdgeInfo>& edge : slots[v]->second.edges)
+			{
+				relax(edge.toIndex, edgeWeightFunc(edge.einfo));
+			}
+		},
+		end);
+
+	return tracePath(
+		tree, end,
+		[this, &edgeWeightFunc](int v, int w)
+		{
+			// the edge v -> w is somewhere in v's list
+			for (const DigraphEdge<EdgeInfo>& edge : slots[v]->second.edges)
 			{
-				// dw = dv + C(v, w)
-				shortBoi[dw] = dv;
-				// pw = v
-				pathBoi[dw] = curry_Boi;
+				if (edge.toIndex == w)
+				{
+					return edgeWeightFunc(edge.einfo);
+				}
 			}
+			return std::numeric_limits<double>::infinity();
+		},
+		[this](int index)
+		{
+			return vertexNumber(index);
+		});
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPathBidirectional(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+	BidirectionalSearchSpace spaceBoi;
+	return findShortestPathBidirectional(startVertex, endVertex, edgeWeightFunc, spaceBoi);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPathBidirectional(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    BidirectionalSearchSpace& space) const
+{
+	return findShortestPathBidirectional<std::function<double(const EdgeInfo&)>>(
+		startVertex, endVertex, edgeWeightFunc, space);
+}
 
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPathBidirectional(
+    int startVertex, int endVertex, WeightFn edgeWeightFunc, BidirectionalSearchSpace& space) const
+{
+	// dense indices of both ends
+	int start = indexOf(startVertex);
+	int end = indexOf(endVertex);
+
+	int meetCute = searchShortestPathBidirectional(
+		space, slots.size(), start, end,
+		[this, &edgeWeightFunc](int v, auto relax)
+		{
+			// forward: outgoing edges
+			for (const DigraphEdge<EdgeInfo>& edge : slots[v]->second.edges)
+			{
+				relax(edge.toIndex, edgeWeightFunc(edge.einfo));
+			}
+		},
+		[this, &edgeWeightFunc](int w, auto relax)
+		{
+			// backward: incoming edges, straight from the reverse index
+			for (const DigraphEdge<EdgeInfo>* edge : slots[w]->second.incoming)
+			{
+				relax(edge->fromIndex, edgeWeightFunc(edge->einfo));
+			}
+		});
+
+	return traceBidirectionalPath(
+		space, meetCute,
+		[this, &edgeWeightFunc](int v, int w)
+		{
+			// the edge v -> w is somewhere in w's reverse index
+			for (const DigraphEdge<EdgeInfo>* edge : slots[w]->second.incoming)
+			{
+				if (edge->fromIndex == v)
+				{
+					return edgeWeightFunc(edge->einfo);
+				}
+			}
+			return std::numeric_limits<double>::infinity();
+		},
+		[this](int index)
+		{
+			return vertexNumber(index);
+		});
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPathAStar(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    std::function<double(int)> estimateFunc) const
+{
+	ShortestPathTree treeBoi;
+	return findShortestPathAStar(startVertex, endVertex, edgeWeightFunc, estimateFunc, treeBoi);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPathAStar(
+    int startVertex,
+    int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    std::function<double(int)> estimateFunc,
+    ShortestPathTree& tree) const
+{
+	return findShortestPathAStar<std::function<double(const EdgeInfo&)>, std::function<double(int)>>(
+		startVertex, endVertex, edgeWeightFunc, estimateFunc, tree);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn, typename EstimateFn>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPathAStar(
+    int startVertex, int endVertex, WeightFn edgeWeightFunc, EstimateFn estimateFunc,
+    ShortestPathTree& tree) const
+{
+	// dense indices of both ends
+	int start = indexOf(startVertex);
+	int end = indexOf(endVertex);
+
+	searchShortestPathAStar(
+		tree, slots.size(), start, end,
+		[this, &edgeWeightFunc](int v, auto relax)
+		{
+			for (const DigraphEdge<EdgeInfo>& edge : slots[v]->second.edges)
+			{
+				relax(edge.toIndex, edgeWeightFunc(edge.einfo));
+			}
+		},
+		estimateFunc);
+
+	return tracePath(
+		tree, end,
+		[this, &edgeWeightFunc](int v, int w)
+		{
+			// the edge v -> w is somewhere in v's list
+			for (const DigraphEdge<EdgeInfo>& edge : slots[v]->second.edges)
+			{
+				if (edge.toIndex == w)
+				{
+					return edgeWeightFunc(edge.einfo);
+				}
+			}
+			return std::numeric_limits<double>::infinity();
+		},
+		[this](int index)
+		{
+			return vertexNumber(index);
+		});
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::repairShortestPaths(
+    ShortestPathTree& tree,
+    const std::vector<std::pair<int, int>>& changedEdges,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+	repairShortestPaths<std::function<double(const EdgeInfo&)>>(tree, changedEdges, edgeWeightFunc);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename WeightFn>
+void Digraph<VertexInfo, EdgeInfo>::repairShortestPaths(
+    ShortestPathTree& tree,
+    const std::vector<std::pair<int, int>>& changedEdges,
+    WeightFn edgeWeightFunc) const
+{
+	// the repair works in dense indices, like the search did
+	std::vector<std::pair<int, int>> DentedFenders;
+	DentedFenders.reserve(changedEdges.size());
+	for (const std::pair<int, int>& edge : changedEdges)
+	{
+		if (edgeLookup.find(edgeKey(edge.first, edge.second)) == edgeLookup.end())
+		{
+			throw DigraphException("No such edge exists");
 		}
+		DentedFenders.emplace_back(indexOf(edge.first), indexOf(edge.second));
 	}
 
-	return pathBoi;
+	// the free function, which this member would otherwise hide
+	::repairShortestPaths(
+		tree, DentedFenders,
+		[this, &edgeWeightFunc](int v, auto relax)
+		{
+			for (const DigraphEdge<EdgeInfo>& edge : slots[v]->second.edges)
+			{
+				relax(edge.toIndex, edgeWeightFunc(edge.einfo));
+			}
+		},
+		[this, &edgeWeightFunc](int w, auto relax)
+		{
+			for (const DigraphEdge<EdgeInfo>* edge : slots[w]->second.incoming)
+			{
+				relax(edge->fromIndex, edgeWeightFunc(edge->einfo));
+			}
+		});
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int Digraph<VertexInfo, EdgeInfo>::indexBound() const noexcept
+{
+	return slots.size();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int Digraph<VertexInfo, EdgeInfo>::indexOf(int vertex) const
+{
+	std::pmr::unordered_map<int, int>::const_iterator itr = indexLookup.find(vertex);
+	// if == then not found
+	if (itr == indexLookup.end())
+	{
+		throw DigraphException("No vertex with that number exists");
+	}
+	return itr->second;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int Digraph<VertexInfo, EdgeInfo>::vertexNumber(int index) const noexcept
+{
+	return slots[index]->first;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+std::uint64_t Digraph<VertexInfo, EdgeInfo>::edgeKey(int fromVertex, int toVertex) noexcept
+{
+	// from in the high half, to in the low half
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(fromVertex)) << 32)
+		| static_cast<std::uint32_t>(toVertex);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+DigraphVertex<VertexInfo, EdgeInfo>* Digraph<VertexInfo, EdgeInfo>::findVertex(int vertex) noexcept
+{
+	std::pmr::unordered_map<int, int>::const_iterator itr = indexLookup.find(vertex);
+	return itr == indexLookup.end() ? nullptr : &slots[itr->second]->second;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+const DigraphVertex<VertexInfo, EdgeInfo>* Digraph<VertexInfo, EdgeInfo>::findVertex(int vertex) const noexcept
+{
+	std::pmr::unordered_map<int, int>::const_iterator itr = indexLookup.find(vertex);
+	return itr == indexLookup.end() ? nullptr : &slots[itr->second]->second;
+}
+
 
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::rebuildIndexes(int indexBound)
+{
+	// every index starts out free, then each vertex claims its own
+	slots.assign(indexBound, nullptr);
+	indexLookup.clear();
+	indexLookup.reserve(ImTheMap.size());
+	for (typename std::pmr::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
+	{
+		slots[itr->second.index] = &*itr;
+		indexLookup.emplace(itr->first, itr->second.index);
+		itr->second.incoming.clear();
+	}
+	// then every edge reports to its to vertex, and to the edge lookup
+	edgeLookup.clear();
+	for (typename std::pmr::map<int, DigraphVertex<VertexInfo, EdgeInfo>>::iterator itr = ImTheMap.begin(); itr != ImTheMap.end(); ++itr)
+	{
+		for (typename std::pmr::list<DigraphEdge<EdgeInfo>>::iterator edge = itr->second.edges.begin(); edge != itr->second.edges.end(); ++edge)
+		{
+			slots[edge->toIndex]->second.incoming.push_back(&*edge);
+			edgeLookup.emplace(edgeKey(edge->fromVertex, edge->toVertex), edge);
+		}
+	}
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::unlinkIncoming(const DigraphEdge<EdgeInfo>* edge)
+{
+	std::pmr::vector<DigraphEdge<EdgeInfo>*>& incoming = slots[edge->toIndex]->second.incoming;
+	// order doesn't matter, so swap it to the back and drop it
+	typename std::pmr::vector<DigraphEdge<EdgeInfo>*>::iterator itr = std::find(incoming.begin(), incoming.end(), edge);
+	*itr = incoming.back();
+	incoming.pop_back();
 }
 
 
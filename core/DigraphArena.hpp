@@ -0,0 +1,97 @@
+// DigraphArena.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called DigraphArena, a memory resource
+// meant for building Digraphs (see the constructors of Digraph that take a
+// std::pmr::memory_resource*).  A Digraph otherwise allocates every map
+// node, list node, and hash table node on its own, which is one call to
+// new (and, eventually, to delete) per vertex and per edge, scattered all
+// over the heap.  A DigraphArena instead carves them out of a few large
+// blocks, which it gets from new and grows geometrically, so that:
+//
+// * building a graph makes a few large allocations, not millions of small
+//   ones, and nodes that are used together end up next to each other;
+// * nodes given back while the graph is being changed (e.g., when a vertex
+//   or edge is removed) are kept in pools by size and handed out again,
+//   rather than leaving holes behind;
+// * destroying the arena gives all of its blocks back at once, no matter
+//   how many nodes were carved out of them.
+//
+// Memory is only ever returned to the system when the arena is destroyed,
+// so it must outlive every Digraph that allocates from it.  A DigraphArena
+// is not safe to allocate from on more than one thread at a time, though
+// the const member functions of a Digraph built in one never allocate, so
+// any number of threads can search it at once.
+
+#ifndef DIGRAPHARENA_HPP
+#define DIGRAPHARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+
+
+
+class DigraphArena : public std::pmr::memory_resource
+{
+public:
+    // This constructor initializes an arena whose first block is the
+    // given number of bytes; each later block is larger than the last.
+    explicit DigraphArena(std::size_t initialBytes = 1 << 20);
+
+    // An arena can't be copied, since Digraphs point into its blocks.
+    DigraphArena(const DigraphArena&) = delete;
+    DigraphArena& operator=(const DigraphArena&) = delete;
+
+    // release() gives every block back at once.  Anything that allocated
+    // from the arena must already have been destroyed.
+    void release();
+
+private:
+    // blocks come from new, in geometrically growing sizes
+    std::pmr::monotonic_buffer_resource blocks_;
+    // nodes are carved out of the blocks, and recycled by size
+    std::pmr::unsynchronized_pool_resource pools_;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+
+
+inline DigraphArena::DigraphArena(std::size_t initialBytes)
+    : blocks_{initialBytes, std::pmr::new_delete_resource()},
+      pools_{&blocks_}
+{
+}
+
+
+inline void DigraphArena::release()
+{
+    pools_.release();
+    blocks_.release();
+}
+
+
+inline void* DigraphArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    return pools_.allocate(bytes, alignment);
+}
+
+
+inline void DigraphArena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+{
+    pools_.deallocate(p, bytes, alignment);
+}
+
+
+inline bool DigraphArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+
+
+#endif // DIGRAPHARENA_HPP
@@ -0,0 +1,116 @@
+// EdgeWeightColumn.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called EdgeWeightColumn, which holds
+// the weight of every edge of a CompactDigraph, worked out ahead of time
+// by some weight function and stored in one contiguous array in the same
+// order as the graph's edge positions (see CompactDigraph::edgeBegin()).
+//
+// A search that's handed an EdgeWeightColumn in place of a weight function
+// reads each edge's weight straight out of the array, so however much work
+// the weight function does, it's done once per edge rather than once per
+// edge per search.  Building a column is a single pass over the edges with
+// no branches, which compilers can vectorize.
+//
+// A column belongs to the graph it was built from; since a CompactDigraph
+// never changes, the column only needs updating when the weight function
+// itself would give a different answer for some edge, which update() is
+// for.
+
+#ifndef EDGEWEIGHTCOLUMN_HPP
+#define EDGEWEIGHTCOLUMN_HPP
+
+#include <vector>
+
+
+
+// Columns are built from CompactDigraphs, which in turn know how to search
+// with them, so CompactDigraph is only declared here.
+
+template <typename VertexInfo, typename EdgeInfo>
+class CompactDigraph;
+
+
+
+class EdgeWeightColumn
+{
+public:
+    // The default constructor initializes a column with no edges.
+    EdgeWeightColumn();
+
+    // build() weighs every edge of the given graph using the given weight
+    // function, which takes an EdgeInfo and returns a double.
+    template <typename VertexInfo, typename EdgeInfo, typename WeightFn>
+    static EdgeWeightColumn build(
+        const CompactDigraph<VertexInfo, EdgeInfo>& graph, WeightFn edgeWeightFunc);
+
+    // edgeCount() returns the number of edges the column has weights for.
+    int edgeCount() const noexcept;
+
+    // operator[] returns the weight of the edge at the given position.
+    double operator[](int edge) const noexcept;
+
+    // update() changes the weight of the edge at the given position.
+    void update(int edge, double weight) noexcept;
+
+    // weights() returns the whole column, indexed by edge position.
+    const std::vector<double>& weights() const noexcept;
+
+private:
+    std::vector<double> column;
+};
+
+
+
+inline EdgeWeightColumn::EdgeWeightColumn()
+{
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename WeightFn>
+EdgeWeightColumn EdgeWeightColumn::build(
+    const CompactDigraph<VertexInfo, EdgeInfo>& graph, WeightFn edgeWeightFunc)
+{
+    EdgeWeightColumn result;
+    int n = graph.edgeCount();
+    result.column.resize(n);
+
+    double* weights = result.column.data();
+
+    for (int e = 0; e < n; ++e)
+    {
+        weights[e] = edgeWeightFunc(graph.edgeInfoAt(e));
+    }
+
+    return result;
+}
+
+
+inline int EdgeWeightColumn::edgeCount() const noexcept
+{
+    return column.size();
+}
+
+
+inline double EdgeWeightColumn::operator[](int edge) const noexcept
+{
+    return column[edge];
+}
+
+
+inline void EdgeWeightColumn::update(int edge, double weight) noexcept
+{
+    column[edge] = weight;
+}
+
+
+inline const std::vector<double>& EdgeWeightColumn::weights() const noexcept
+{
+    return column;
+}
+
+
+
+#endif // EDGEWEIGHTCOLUMN_HPP
@@ -0,0 +1,367 @@
+// IndexedDaryHeap.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares a class template called IndexedDaryHeap, which
+// implements a min-priority queue of integer ids in the range 0..capacity-1.
+// Because each id can appear at most once, the heap keeps track of where
+// each id lives, which allows an id's priority to be lowered in place
+// (a "decrease-key") instead of pushing a second, stale copy of it.
+//
+// The heap is d-ary rather than binary: each node has Arity children, which
+// makes the tree shallower and keeps the children of a node next to each
+// other in memory.  Arity = 4 is a good fit for Dijkstra's algorithm, where
+// decrease-key (which walks up the tree) is far more common than pop
+// (which walks down it).
+//
+// A heap can also count what's done to it into a SearchStats (see
+// SearchStats.hpp), so that a search can report on its queue without any
+// bookkeeping of its own.
+
+#ifndef INDEXEDDARYHEAP_HPP
+#define INDEXEDDARYHEAP_HPP
+
+#include <algorithm>
+#include <vector>
+#include "SearchStats.hpp"
+
+
+
+template <typename Priority, int Arity = 4>
+class IndexedDaryHeap
+{
+public:
+    // The default constructor initializes an empty heap with no capacity.
+    IndexedDaryHeap();
+
+    // This constructor initializes an empty heap that accepts the ids
+    // 0..capacity-1.
+    explicit IndexedDaryHeap(int capacity);
+
+    // reset() empties the heap and changes the range of ids it accepts
+    // to 0..capacity-1.  Memory is kept, so resetting to the same (or a
+    // smaller) capacity doesn't allocate.
+    void reset(int capacity);
+
+    // clear() empties the heap without changing its capacity.  It takes
+    // time proportional to the number of ids in the heap, not to its
+    // capacity.
+    void clear() noexcept;
+
+    // capacity() returns one more than the largest id the heap accepts.
+    int capacity() const noexcept;
+
+    // size() returns the number of ids in the heap, and empty() returns
+    // true if there are none.
+    int size() const noexcept;
+    bool empty() const noexcept;
+
+    // contains() returns true if the given id is in the heap.
+    bool contains(int id) const noexcept;
+
+    // top() returns the id with the smallest priority and topPriority()
+    // returns that priority.  The heap must not be empty.
+    int top() const noexcept;
+    const Priority& topPriority() const noexcept;
+
+    // priority() returns the priority of an id that is in the heap.
+    const Priority& priority(int id) const noexcept;
+
+    // push() adds an id that is not in the heap with the given priority.
+    void push(int id, const Priority& priority);
+
+    // decreaseKey() lowers the priority of an id that is in the heap.
+    // The new priority must be no greater than the old one.
+    void decreaseKey(int id, const Priority& priority) noexcept;
+
+    // pushOrDecrease() pushes the id if it isn't in the heap, or lowers
+    // its priority if the new one is smaller.  It returns true if the
+    // heap changed.
+    bool pushOrDecrease(int id, const Priority& priority);
+
+    // pop() removes the id with the smallest priority and returns it.
+    // The heap must not be empty.
+    int pop() noexcept;
+
+    // collectStats() makes the heap count its pushes, pops, and decrease-
+    // keys, along with the most ids it ever holds at once, into the given
+    // SearchStats, or stops it counting if given nullptr.  stats() returns
+    // the SearchStats being counted into, so that the search using the
+    // heap can count into it too.  Without DIGRAPH_SEARCH_STATS, neither
+    // does anything, and stats() always returns nullptr.
+    void collectStats(SearchStats* stats) noexcept;
+    SearchStats* stats() const noexcept;
+
+private:
+    struct Entry
+    {
+        Priority priority;
+        int id;
+    };
+
+    // the heap itself, with the root at position 0
+    std::vector<Entry> entries;
+
+    // positions[id] is the position of id in entries, or -1
+    std::vector<int> positions;
+
+#ifdef DIGRAPH_SEARCH_STATS
+    SearchStats* stats_ = nullptr;
+#endif
+
+    void place(int position, const Entry& entry) noexcept;
+    void siftUp(int position, Entry entry) noexcept;
+    void siftDown(int position, Entry entry) noexcept;
+};
+
+
+
+template <typename Priority, int Arity>
+IndexedDaryHeap<Priority, Arity>::IndexedDaryHeap()
+{
+}
+
+
+template <typename Priority, int Arity>
+IndexedDaryHeap<Priority, Arity>::IndexedDaryHeap(int capacity)
+    : positions(capacity, -1)
+{
+}
+
+
+template <typename Priority, int Arity>
+void IndexedDaryHeap<Priority, Arity>::reset(int capacity)
+{
+    clear();
+    positions.resize(capacity, -1);
+}
+
+
+template <typename Priority, int Arity>
+void IndexedDaryHeap<Priority, Arity>::clear() noexcept
+{
+    for (const Entry& entry : entries)
+    {
+        positions[entry.id] = -1;
+    }
+
+    entries.clear();
+}
+
+
+template <typename Priority, int Arity>
+int IndexedDaryHeap<Priority, Arity>::capacity() const noexcept
+{
+    return positions.size();
+}
+
+
+template <typename Priority, int Arity>
+int IndexedDaryHeap<Priority, Arity>::size() const noexcept
+{
+    return entries.size();
+}
+
+
+template <typename Priority, int Arity>
+bool IndexedDaryHeap<Priority, Arity>::empty() const noexcept
+{
+    return entries.empty();
+}
+
+
+template <typename Priority, int Arity>
+bool IndexedDaryHeap<Priority, Arity>::contains(int id) const noexcept
+{
+    return positions[id] != -1;
+}
+
+
+template <typename Priority, int Arity>
+int IndexedDaryHeap<Priority, Arity>::top() const noexcept
+{
+    return entries.front().id;
+}
+
+
+template <typename Priority, int Arity>
+const Priority& IndexedDaryHeap<Priority, Arity>::topPriority() const noexcept
+{
+    return entries.front().priority;
+}
+
+
+template <typename Priority, int Arity>
+const Priority& IndexedDaryHeap<Priority, Arity>::priority(int id) const noexcept
+{
+    return entries[positions[id]].priority;
+}
+
+
+template <typename Priority, int Arity>
+void IndexedDaryHeap<Priority, Arity>::push(int id, const Priority& priority)
+{
+    entries.push_back(Entry{priority, id});
+    siftUp(entries.size() - 1, entries.back());
+
+#ifdef DIGRAPH_SEARCH_STATS
+    if (stats_ != nullptr)
+    {
+        ++stats_->pushes;
+        stats_->peakQueueSize = std::max<long long>(stats_->peakQueueSize, entries.size());
+    }
+#endif
+}
+
+
+template <typename Priority, int Arity>
+void IndexedDaryHeap<Priority, Arity>::decreaseKey(int id, const Priority& priority) noexcept
+{
+    siftUp(positions[id], Entry{priority, id});
+
+#ifdef DIGRAPH_SEARCH_STATS
+    if (stats_ != nullptr)
+    {
+        ++stats_->decreaseKeys;
+    }
+#endif
+}
+
+
+template <typename Priority, int Arity>
+bool IndexedDaryHeap<Priority, Arity>::pushOrDecrease(int id, const Priority& priority)
+{
+    if (positions[id] == -1)
+    {
+        push(id, priority);
+        return true;
+    }
+    else if (priority < entries[positions[id]].priority)
+    {
+        decreaseKey(id, priority);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+template <typename Priority, int Arity>
+int IndexedDaryHeap<Priority, Arity>::pop() noexcept
+{
+    int id = entries.front().id;
+    positions[id] = -1;
+
+    Entry last = entries.back();
+    entries.pop_back();
+
+    if (!entries.empty())
+    {
+        siftDown(0, last);
+    }
+
+#ifdef DIGRAPH_SEARCH_STATS
+    if (stats_ != nullptr)
+    {
+        ++stats_->pops;
+    }
+#endif
+
+    return id;
+}
+
+
+template <typename Priority, int Arity>
+void IndexedDaryHeap<Priority, Arity>::collectStats(SearchStats* stats) noexcept
+{
+#ifdef DIGRAPH_SEARCH_STATS
+    stats_ = stats;
+#else
+    (void)stats;
+#endif
+}
+
+
+template <typename Priority, int Arity>
+SearchStats* IndexedDaryHeap<Priority, Arity>::stats() const noexcept
+{
+#ifdef DIGRAPH_SEARCH_STATS
+    return stats_;
+#else
+    return nullptr;
+#endif
+}
+
+
+template <typename Priority, int Arity>
+void IndexedDaryHeap<Priority, Arity>::place(int position, const Entry& entry) noexcept
+{
+    entries[position] = entry;
+    positions[entry.id] = position;
+}
+
+
+template <typename Priority, int Arity>
+void IndexedDaryHeap<Priority, Arity>::siftUp(int position, Entry entry) noexcept
+{
+    // move parents down until entry's spot is found, then write it once
+    while (position > 0)
+    {
+        int parent = (position - 1) / Arity;
+
+        if (!(entry.priority < entries[parent].priority))
+        {
+            break;
+        }
+
+        place(position, entries[parent]);
+        position = parent;
+    }
+
+    place(position, entry);
+}
+
+
+template <typename Priority, int Arity>
+void IndexedDaryHeap<Priority, Arity>::siftDown(int position, Entry entry) noexcept
+{
+    int count = entries.size();
+
+    while (true)
+    {
+        int first = position * Arity + 1;
+
+        if (first >= count)
+        {
+            break;
+        }
+
+        int last = first + Arity < count ? first + Arity : count;
+        int smallest = first;
+
+        for (int child = first + 1; child < last; ++child)
+        {
+            if (entries[child].priority < entries[smallest].priority)
+            {
+                smallest = child;
+            }
+        }
+
+        if (!(entries[smallest].priority < entry.priority))
+        {
+            break;
+        }
+
+        place(position, entries[smallest]);
+        position = smallest;
+    }
+
+    place(position, entry);
+}
+
+
+
+#endif // INDEXEDDARYHEAP_HPP
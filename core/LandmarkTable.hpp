@@ -0,0 +1,337 @@
+// LandmarkTable.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called LandmarkTable, which holds the
+// preprocessed data for the ALT (A*, Landmarks, Triangle inequality)
+// shortest path technique.
+//
+// A handful of vertices are chosen as "landmarks", and the distances from
+// every landmark to every vertex and from every vertex to every landmark
+// are computed ahead of time.  Because shortest path distances obey the
+// triangle inequality, for any landmark L and any vertices v and t,
+//
+//     dist(v, t) >= dist(v, L) - dist(t, L)
+//     dist(v, t) >= dist(L, t) - dist(L, v)
+//
+// so the largest of these over all landmarks is a lower bound that A* can
+// use as its estimate.  Unlike an estimate based on geometry, this works
+// for any non-negative edge weights at all.
+//
+// The distances depend on the edge weights, so a LandmarkTable is built
+// for one particular weight function.  Building one takes two full
+// shortest path searches per landmark, so tables can be written to and
+// read back from a stream, so that building can happen offline.
+
+#ifndef LANDMARKTABLE_HPP
+#define LANDMARKTABLE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "ShortestPathTree.hpp"
+
+
+
+class LandmarkTable
+{
+public:
+    // The default constructor initializes an empty table with no
+    // landmarks, whose lower bounds are always zero.
+    LandmarkTable();
+
+    // build() chooses up to landmarkCount landmarks in the given graph and
+    // computes their distance tables using the given edge weights.
+    // Landmarks are chosen one at a time, each as far as possible from
+    // the ones chosen before it ("farthest" selection), which spreads them
+    // out around the edges of the graph, where they give the best bounds.
+    template <typename VertexInfo, typename EdgeInfo>
+    static LandmarkTable build(
+        const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc,
+        int landmarkCount);
+
+    // vertexCount() returns the number of vertices in the graph the table
+    // was built for, and landmarkCount() returns the number of landmarks.
+    int vertexCount() const noexcept;
+    int landmarkCount() const noexcept;
+
+    // landmarks() returns the dense indices of the landmarks.
+    const std::vector<int>& landmarks() const noexcept;
+
+    // lowerBound() returns a lower bound on the length of the shortest
+    // path from one dense index to another.  It's infinite when the
+    // landmarks prove that there is no such path at all.
+    double lowerBound(int fromIndex, int toIndex) const noexcept;
+
+    // estimateTo() returns a function suitable for use as the estimate in
+    // an A* search toward the given dense index.  The table must outlive
+    // the function.
+    std::function<double(int)> estimateTo(int toIndex) const;
+
+    // write() writes the table to the given stream in a binary format,
+    // and read() reads a table written that way back in.  If the stream
+    // doesn't contain a table, read() throws a DigraphException.
+    void write(std::ostream& out) const;
+    static LandmarkTable read(std::istream& in);
+
+private:
+    int vertexCount_;
+    std::vector<int> landmarks_;
+
+    // fromLandmark_[v * landmarkCount() + i] is the distance from the
+    // i-th landmark to v, and toLandmark_ is the distance from v to it,
+    // so all of a vertex's distances sit next to each other
+    std::vector<double> fromLandmark_;
+    std::vector<double> toLandmark_;
+};
+
+
+
+inline LandmarkTable::LandmarkTable()
+    : vertexCount_{0}
+{
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+LandmarkTable LandmarkTable::build(
+    const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    int landmarkCount)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+    int n = graph.vertexCount();
+
+    LandmarkTable table;
+    table.vertexCount_ = n;
+
+    if (n == 0 || landmarkCount <= 0)
+    {
+        return table;
+    }
+
+    auto forward =
+        [&graph, &edgeWeightFunc](int v, auto relax)
+        {
+            for (int e = graph.edgeBegin(v); e < graph.edgeEnd(v); ++e)
+            {
+                relax(graph.edgeTarget(e), edgeWeightFunc(graph.edgeInfoAt(e)));
+            }
+        };
+
+    auto backward =
+        [&graph, &edgeWeightFunc](int w, auto relax)
+        {
+            for (int slot = graph.inEdgeBegin(w); slot < graph.inEdgeEnd(w); ++slot)
+            {
+                int e = graph.inEdgePosition(slot);
+                relax(graph.inEdgeSource(slot), edgeWeightFunc(graph.edgeInfoAt(e)));
+            }
+        };
+
+    std::vector<std::vector<double>> fromColumns;
+    std::vector<std::vector<double>> toColumns;
+    ShortestPathTree tree;
+
+    // separation[v] is how far v is from the nearest landmark so far,
+    // counting whichever of the two directions are possible at all; the
+    // next landmark is the vertex where it's largest.  The first landmark
+    // is chosen relative to index 0.
+    searchShortestPaths(tree, n, 0, forward);
+    std::vector<double> separation = tree.distance;
+    std::vector<bool> chosen(n, false);
+
+    while (static_cast<int>(table.landmarks_.size()) < landmarkCount
+           && static_cast<int>(table.landmarks_.size()) < n)
+    {
+        // unreachable vertices (infinite separation) are picked first,
+        // which puts a landmark in each part of a disconnected graph
+        int next = -1;
+
+        for (int v = 0; v < n; ++v)
+        {
+            if (!chosen[v] && (next == -1 || separation[v] > separation[next]))
+            {
+                next = v;
+            }
+        }
+
+        chosen[next] = true;
+        table.landmarks_.push_back(next);
+
+        searchShortestPaths(tree, n, next, forward);
+        fromColumns.push_back(tree.distance);
+
+        searchShortestPaths(tree, n, next, backward);
+        toColumns.push_back(tree.distance);
+
+        for (int v = 0; v < n; ++v)
+        {
+            double from = fromColumns.back()[v];
+            double to = toColumns.back()[v];
+            double around = from == infinity ? to : (to == infinity ? from : from + to);
+
+            if (separation[v] == infinity || around < separation[v])
+            {
+                separation[v] = around;
+            }
+        }
+    }
+
+    // transpose the per-landmark columns into per-vertex rows
+    int k = table.landmarks_.size();
+    table.fromLandmark_.resize(n * k);
+    table.toLandmark_.resize(n * k);
+
+    for (int v = 0; v < n; ++v)
+    {
+        for (int i = 0; i < k; ++i)
+        {
+            table.fromLandmark_[v * k + i] = fromColumns[i][v];
+            table.toLandmark_[v * k + i] = toColumns[i][v];
+        }
+    }
+
+    return table;
+}
+
+
+inline int LandmarkTable::vertexCount() const noexcept
+{
+    return vertexCount_;
+}
+
+
+inline int LandmarkTable::landmarkCount() const noexcept
+{
+    return landmarks_.size();
+}
+
+
+inline const std::vector<int>& LandmarkTable::landmarks() const noexcept
+{
+    return landmarks_;
+}
+
+
+inline double LandmarkTable::lowerBound(int fromIndex, int toIndex) const noexcept
+{
+    int k = landmarks_.size();
+    const double* fromV = fromLandmark_.data() + fromIndex * k;
+    const double* fromT = fromLandmark_.data() + toIndex * k;
+    const double* toV = toLandmark_.data() + fromIndex * k;
+    const double* toT = toLandmark_.data() + toIndex * k;
+
+    double best = 0.0;
+
+    for (int i = 0; i < k; ++i)
+    {
+        // when both sides are infinite the difference is NaN, which
+        // never compares greater and so is ignored
+        double viaTo = toV[i] - toT[i];
+        double viaFrom = fromT[i] - fromV[i];
+
+        if (viaTo > best)
+        {
+            best = viaTo;
+        }
+
+        if (viaFrom > best)
+        {
+            best = viaFrom;
+        }
+    }
+
+    return best;
+}
+
+
+inline std::function<double(int)> LandmarkTable::estimateTo(int toIndex) const
+{
+    if (landmarks_.empty())
+    {
+        return [](int)
+        {
+            return 0.0;
+        };
+    }
+
+    return [this, toIndex](int fromIndex)
+    {
+        return lowerBound(fromIndex, toIndex);
+    };
+}
+
+
+namespace LandmarkTableFormat
+{
+    // every table starts with these bytes, followed by a version number
+    const char magic[4] = {'A', 'L', 'T', 'T'};
+    const std::int32_t version = 1;
+}
+
+
+inline void LandmarkTable::write(std::ostream& out) const
+{
+    std::int32_t header[3] = {
+        LandmarkTableFormat::version,
+        static_cast<std::int32_t>(vertexCount_),
+        static_cast<std::int32_t>(landmarks_.size())};
+
+    std::vector<std::int32_t> landmarks(landmarks_.begin(), landmarks_.end());
+
+    out.write(LandmarkTableFormat::magic, sizeof(LandmarkTableFormat::magic));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(landmarks.data()), landmarks.size() * sizeof(std::int32_t));
+    out.write(reinterpret_cast<const char*>(fromLandmark_.data()), fromLandmark_.size() * sizeof(double));
+    out.write(reinterpret_cast<const char*>(toLandmark_.data()), toLandmark_.size() * sizeof(double));
+}
+
+
+inline LandmarkTable LandmarkTable::read(std::istream& in)
+{
+    char magic[sizeof(LandmarkTableFormat::magic)];
+    std::int32_t header[3];
+
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+
+    if (!in
+        || !std::equal(magic, magic + sizeof(magic), LandmarkTableFormat::magic)
+        || header[0] != LandmarkTableFormat::version
+        || header[1] < 0 || header[2] < 0)
+    {
+        throw DigraphException("Not a landmark table");
+    }
+
+    LandmarkTable table;
+    table.vertexCount_ = header[1];
+
+    std::vector<std::int32_t> landmarks(header[2]);
+    std::size_t cells = static_cast<std::size_t>(header[1]) * header[2];
+    table.fromLandmark_.resize(cells);
+    table.toLandmark_.resize(cells);
+
+    in.read(reinterpret_cast<char*>(landmarks.data()), landmarks.size() * sizeof(std::int32_t));
+    in.read(reinterpret_cast<char*>(table.fromLandmark_.data()), cells * sizeof(double));
+    in.read(reinterpret_cast<char*>(table.toLandmark_.data()), cells * sizeof(double));
+
+    if (!in)
+    {
+        throw DigraphException("Landmark table is truncated");
+    }
+
+    table.landmarks_.assign(landmarks.begin(), landmarks.end());
+    return table;
+}
+
+
+
+#endif // LANDMARKTABLE_HPP
@@ -0,0 +1,174 @@
+// MappedFile.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called MappedFile, which maps a whole
+// file into memory, read-only, for as long as the MappedFile exists.  The
+// file's bytes can then be used where they are, without being read into
+// memory first: the operating system brings each page in the first time
+// it's touched, and pages that are never touched are never read at all.
+//
+// This relies on the POSIX mmap() call.
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+
+// A MappedFileException is thrown when a file can't be opened or mapped;
+// its what() explains why.
+
+class MappedFileException : public std::runtime_error
+{
+public:
+    MappedFileException(const std::string& reason);
+};
+
+
+inline MappedFileException::MappedFileException(const std::string& reason)
+    : std::runtime_error{reason}
+{
+}
+
+
+
+class MappedFile
+{
+public:
+    // The default constructor initializes a MappedFile with nothing mapped.
+    MappedFile() noexcept;
+
+    // This constructor maps the file with the given path.  If it can't be
+    // opened or mapped, a MappedFileException is thrown.
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // The destructor unmaps the file.
+    ~MappedFile() noexcept;
+
+    // data() returns the address of the file's first byte, and size() the
+    // number of bytes in it.  The address is aligned to a page boundary.
+    const char* data() const noexcept;
+    std::size_t size() const noexcept;
+
+private:
+    const char* bytes;
+    std::size_t length;
+
+    void unmap() noexcept;
+};
+
+
+
+inline MappedFile::MappedFile() noexcept
+    : bytes{nullptr}, length{0}
+{
+}
+
+
+inline MappedFile::MappedFile(const std::string& path)
+    : bytes{nullptr}, length{0}
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd == -1)
+    {
+        throw MappedFileException{"Could not open " + path};
+    }
+
+    struct stat status;
+
+    if (::fstat(fd, &status) == -1)
+    {
+        ::close(fd);
+        throw MappedFileException{"Could not read " + path};
+    }
+
+    length = status.st_size;
+
+    // an empty file has nothing to map, and mmap() won't map nothing
+    if (length > 0)
+    {
+        void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (address == MAP_FAILED)
+        {
+            ::close(fd);
+            throw MappedFileException{"Could not map " + path};
+        }
+
+        bytes = static_cast<const char*>(address);
+    }
+
+    // the mapping keeps the file alive on its own
+    ::close(fd);
+}
+
+
+inline MappedFile::MappedFile(MappedFile&& other) noexcept
+    : bytes{other.bytes}, length{other.length}
+{
+    other.bytes = nullptr;
+    other.length = 0;
+}
+
+
+inline MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        bytes = std::exchange(other.bytes, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+
+    return *this;
+}
+
+
+inline MappedFile::~MappedFile() noexcept
+{
+    unmap();
+}
+
+
+inline const char* MappedFile::data() const noexcept
+{
+    return bytes;
+}
+
+
+inline std::size_t MappedFile::size() const noexcept
+{
+    return length;
+}
+
+
+inline void MappedFile::unmap() noexcept
+{
+    if (bytes != nullptr)
+    {
+        ::munmap(const_cast<char*>(bytes), length);
+        bytes = nullptr;
+        length = 0;
+    }
+}
+
+
+
+#endif // MAPPEDFILE_HPP
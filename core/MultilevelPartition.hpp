@@ -0,0 +1,197 @@
+// MultilevelPartition.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called MultilevelPartition, which
+// divides the vertices of a CompactDigraph into "cells" at several levels
+// of detail.  Level 0 has the smallest cells; each cell at level i+1 is
+// made up of whole cells from level i, so the cells nest like the counties
+// within a state.
+//
+// A partition depends only on which vertices are connected to which, never
+// on the edges' weights, so it only ever needs to be built once for a
+// graph, no matter how many ways its edges are weighed.  (See
+// PartitionOverlay, which is what it's for.)
+//
+// Cells are grown outward from a seed vertex in breadth-first order,
+// ignoring the direction of edges, until they reach the size limit for
+// their level.  This keeps cells compact, which keeps the number of
+// vertices on their boundaries small.
+
+#ifndef MULTILEVELPARTITION_HPP
+#define MULTILEVELPARTITION_HPP
+
+#include <queue>
+#include <utility>
+#include <vector>
+#include "CompactDigraph.hpp"
+
+
+
+class MultilevelPartition
+{
+public:
+    // The default constructor initializes a partition with no levels.
+    MultilevelPartition();
+
+    // build() partitions the given graph.  There is one level for each
+    // element of maxCellSizes, which gives the most vertices a cell can
+    // have on that level; the sizes must be in increasing order.
+    template <typename VertexInfo, typename EdgeInfo>
+    static MultilevelPartition build(
+        const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+        const std::vector<int>& maxCellSizes);
+
+    // levelCount() returns the number of levels, and vertexCount() the
+    // number of vertices in the partitioned graph.
+    int levelCount() const noexcept;
+    int vertexCount() const noexcept;
+
+    // cellCount() returns the number of cells on the given level.
+    int cellCount(int level) const noexcept;
+
+    // cell() returns the cell, on the given level, that contains the
+    // vertex with the given dense index.
+    int cell(int level, int index) const noexcept;
+
+private:
+    // cells[level][index] is the cell containing the vertex at index
+    std::vector<std::vector<int>> cells;
+    std::vector<int> cellCounts;
+};
+
+
+
+inline MultilevelPartition::MultilevelPartition()
+{
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+MultilevelPartition MultilevelPartition::build(
+    const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+    const std::vector<int>& maxCellSizes)
+{
+    int n = graph.vertexCount();
+
+    MultilevelPartition partition;
+
+    // the units being grouped into cells start out as single vertices
+    // and become the previous level's cells from then on
+    std::vector<int> unitOf(n);
+    std::vector<int> unitSize(n, 1);
+    std::vector<std::vector<int>> unitMembers(n);
+
+    for (int v = 0; v < n; ++v)
+    {
+        unitOf[v] = v;
+        unitMembers[v].push_back(v);
+    }
+
+    for (int maxCellSize : maxCellSizes)
+    {
+        int unitCount = unitSize.size();
+
+        // neighboring units, in either direction
+        std::vector<std::vector<int>> neighbors(unitCount);
+
+        for (int v = 0; v < n; ++v)
+        {
+            for (int e = graph.edgeBegin(v); e < graph.edgeEnd(v); ++e)
+            {
+                int a = unitOf[v];
+                int b = unitOf[graph.edgeTarget(e)];
+
+                if (a != b)
+                {
+                    neighbors[a].push_back(b);
+                    neighbors[b].push_back(a);
+                }
+            }
+        }
+
+        std::vector<int> cellOfUnit(unitCount, -1);
+        std::vector<int> cellSize;
+
+        for (int seed = 0; seed < unitCount; ++seed)
+        {
+            if (cellOfUnit[seed] != -1)
+            {
+                continue;
+            }
+
+            int cell = cellSize.size();
+            cellSize.push_back(0);
+
+            std::queue<int> frontier;
+            frontier.push(seed);
+            cellOfUnit[seed] = cell;
+            cellSize[cell] = unitSize[seed];
+
+            while (!frontier.empty())
+            {
+                int unit = frontier.front();
+                frontier.pop();
+
+                for (int next : neighbors[unit])
+                {
+                    if (cellOfUnit[next] == -1 && cellSize[cell] + unitSize[next] <= maxCellSize)
+                    {
+                        cellOfUnit[next] = cell;
+                        cellSize[cell] += unitSize[next];
+                        frontier.push(next);
+                    }
+                }
+            }
+        }
+
+        // the new cells become the units for the next level up
+        std::vector<std::vector<int>> cellMembers(cellSize.size());
+
+        for (int unit = 0; unit < unitCount; ++unit)
+        {
+            for (int v : unitMembers[unit])
+            {
+                cellMembers[cellOfUnit[unit]].push_back(v);
+                unitOf[v] = cellOfUnit[unit];
+            }
+        }
+
+        partition.cells.push_back(unitOf);
+        partition.cellCounts.push_back(cellSize.size());
+
+        unitSize = cellSize;
+        unitMembers = std::move(cellMembers);
+    }
+
+    return partition;
+}
+
+
+inline int MultilevelPartition::levelCount() const noexcept
+{
+    return cells.size();
+}
+
+
+inline int MultilevelPartition::vertexCount() const noexcept
+{
+    return cells.empty() ? 0 : cells.front().size();
+}
+
+
+inline int MultilevelPartition::cellCount(int level) const noexcept
+{
+    return cellCounts[level];
+}
+
+
+inline int MultilevelPartition::cell(int level, int index) const noexcept
+{
+    return cells[level][index];
+}
+
+
+
+#endif // MULTILEVELPARTITION_HPP
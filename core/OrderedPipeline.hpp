@@ -0,0 +1,227 @@
+// OrderedPipeline.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares runOrderedPipeline(), which runs a stream of
+// jobs through three stages at once:
+//
+// * produce, which makes jobs one at a time, in order, on its own thread,
+//   and can take as long as it likes to do it (e.g., waiting for input);
+// * process, which turns each job into a result, on a WorkerPool's
+//   workers, many jobs at a time;
+// * consume, which is handed the results one at a time, in the same order
+//   the jobs were produced, as soon as each one and all of the ones before
+//   it are ready.
+//
+// At most `window` jobs are ever in flight between being produced and
+// being consumed; once that many are, producing waits for consuming to
+// catch up.  So however many jobs go through the pipeline, the memory it
+// uses stays the same.
+
+#ifndef ORDEREDPIPELINE_HPP
+#define ORDEREDPIPELINE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "WorkerPool.hpp"
+
+
+
+// runOrderedPipeline() runs the pipeline until produce(job) returns false,
+// which means there are no more jobs, and every job produced before then
+// has been consumed.  process(job, workerNumber) returns a Result, and
+// consume(result) is called with it.  Both Job and Result must be default
+// constructible and movable.
+//
+// If any stage throws an exception, the pipeline stops and the first such
+// exception is rethrown here, once produce() has returned.
+
+template <typename Job, typename Result, typename Produce, typename Process, typename Consume>
+void runOrderedPipeline(
+    WorkerPool& pool, std::size_t window,
+    Produce produce, Process process, Consume consume);
+
+
+
+template <typename Job, typename Result, typename Produce, typename Process, typename Consume>
+void runOrderedPipeline(
+    WorkerPool& pool, std::size_t window,
+    Produce produce, Process process, Consume consume)
+{
+    // job number n lives in slot n % window from when it's produced until
+    // its result has been consumed
+    struct Slot
+    {
+        Job job;
+        Result result;
+        bool done = false;
+    };
+
+    std::vector<Slot> slots(window);
+
+    std::mutex mutex;
+    std::condition_variable roomFreed;
+    std::condition_variable jobReady;
+
+    std::size_t produced = 0;
+    std::size_t taken = 0;
+    std::size_t consumed = 0;
+    bool finished = false;
+    bool consuming = false;
+    std::exception_ptr failure;
+
+    // stops everything; the mutex must be held
+    auto fail =
+        [&](std::exception_ptr exception)
+        {
+            if (!failure)
+            {
+                failure = exception;
+            }
+
+            roomFreed.notify_all();
+            jobReady.notify_all();
+        };
+
+    std::thread producer{
+        [&]()
+        {
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock{mutex};
+                    roomFreed.wait(
+                        lock,
+                        [&]()
+                        {
+                            return failure || produced - consumed < window;
+                        });
+
+                    if (failure)
+                    {
+                        break;
+                    }
+                }
+
+                // nothing else touches the slot until it's been produced
+                Job job;
+                bool more;
+
+                try
+                {
+                    more = produce(job);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    fail(std::current_exception());
+                    break;
+                }
+
+                std::lock_guard<std::mutex> lock{mutex};
+
+                if (!more)
+                {
+                    finished = true;
+                    jobReady.notify_all();
+                    break;
+                }
+
+                slots[produced % window].job = std::move(job);
+                ++produced;
+                jobReady.notify_one();
+            }
+        }};
+
+    pool.run(
+        pool.workerCount(),
+        [&](int, int worker)
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+
+            while (true)
+            {
+                jobReady.wait(
+                    lock,
+                    [&]()
+                    {
+                        return failure || finished || taken < produced;
+                    });
+
+                if (failure || taken == produced)
+                {
+                    return;
+                }
+
+                Slot& slot = slots[taken % window];
+                ++taken;
+                lock.unlock();
+
+                try
+                {
+                    slot.result = process(slot.job, worker);
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    fail(std::current_exception());
+                    return;
+                }
+
+                lock.lock();
+                slot.done = true;
+
+                // one worker at a time hands every result that's ready, in
+                // order, to consume()
+                if (consuming)
+                {
+                    continue;
+                }
+
+                consuming = true;
+
+                while (!failure && slots[consumed % window].done)
+                {
+                    Slot& next = slots[consumed % window];
+                    lock.unlock();
+
+                    try
+                    {
+                        consume(next.result);
+                    }
+                    catch (...)
+                    {
+                        lock.lock();
+                        fail(std::current_exception());
+                        break;
+                    }
+
+                    next.job = Job{};
+                    next.result = Result{};
+                    lock.lock();
+
+                    next.done = false;
+                    ++consumed;
+                    roomFreed.notify_one();
+                }
+
+                consuming = false;
+            }
+        });
+
+    producer.join();
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+
+
+#endif // ORDEREDPIPELINE_HPP
@@ -0,0 +1,542 @@
+// PartitionOverlay.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called PartitionOverlay, which speeds
+// up shortest path queries in a way that, unlike a LandmarkTable or a
+// ContractionHierarchy, splits its preprocessing into two phases:
+//
+// * The overlay itself is built once from a MultilevelPartition of the
+//   graph.  It records which vertices lie on the boundary of each cell,
+//   which depends only on how the graph is connected.
+//
+// * "Customizing" the overlay for a particular weight function produces an
+//   OverlayMetric, which holds, for every cell, the length of the shortest
+//   path within the cell from each of its boundary vertices to each of the
+//   others (its "clique").  This is quick, because each level's cliques are
+//   built from the level below it, so changing the weights (say, because
+//   speed limits changed) only requires customizing again.
+//
+// A query then runs Dijkstra's algorithm on a much smaller graph: near the
+// start and end of the trip it uses the original edges, but everywhere
+// else it crosses whole cells in one step using their cliques, choosing
+// the largest cells that contain neither end.  The path found is unpacked
+// back into edges of the original graph afterward.
+//
+// This technique is known as Customizable Route Planning.
+
+#ifndef PARTITIONOVERLAY_HPP
+#define PARTITIONOVERLAY_HPP
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "IndexedDaryHeap.hpp"
+#include "MultilevelPartition.hpp"
+#include "ShortestPathTree.hpp"
+
+
+
+// An OverlayMetric is the result of customizing a PartitionOverlay for one
+// weight function.  edgeWeights[e] is the weight of the edge at position e
+// in the graph, and cliques[level][cell] is a square matrix, in row-major
+// order, of distances between the boundary vertices of that cell, in the
+// order that the overlay lists them.  Unreachable pairs are infinite.
+
+struct OverlayMetric
+{
+    std::vector<double> edgeWeights;
+    std::vector<std::vector<std::vector<double>>> cliques;
+};
+
+
+
+// A LocalSearchSpace is scratch space for a Dijkstra search that's only
+// expected to explore a small part of a large graph.  Unlike a
+// ShortestPathTree, it cleans up only the entries that the previous search
+// touched, so each search costs nothing for the parts of the graph it
+// never reaches.
+
+struct LocalSearchSpace
+{
+    std::vector<double> distance;
+    std::vector<int> predecessor;
+    std::vector<int> touched;
+    IndexedDaryHeap<double> queue;
+
+    // search() runs Dijkstra's algorithm over indices 0..indexBound-1 from
+    // the source index, exactly like searchShortestPaths().
+    template <typename ForEachEdge>
+    void search(int indexBound, int sourceIndex, ForEachEdge forEachEdge, int targetIndex = -1);
+
+    // reached() returns true if the last search found a path to the index.
+    bool reached(int index) const noexcept;
+};
+
+
+
+// An OverlaySearch holds everything a query needs, so that it can be
+// reused from one query to the next.
+
+struct OverlaySearch
+{
+    LocalSearchSpace query;
+    LocalSearchSpace unpack;
+};
+
+
+
+class PartitionOverlay
+{
+public:
+    // The default constructor initializes an overlay for an empty graph.
+    PartitionOverlay();
+
+    // build() builds the overlay for the given graph and partition of it.
+    template <typename VertexInfo, typename EdgeInfo>
+    static PartitionOverlay build(
+        const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+        MultilevelPartition partition);
+
+    // partition() returns the partition the overlay was built from.
+    const MultilevelPartition& partition() const noexcept;
+
+    // boundaryVertexCount() returns the number of vertices that lie on the
+    // boundary of some cell on the given level.
+    int boundaryVertexCount(int level) const noexcept;
+
+    // customize() computes the cliques of every cell, level by level,
+    // using the given edge weights, which must not be negative.
+    template <typename VertexInfo, typename EdgeInfo>
+    OverlayMetric customize(
+        const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // findShortestPath() finds a shortest path from the start vertex to
+    // the end vertex, using the given customization.  The path consists
+    // only of edges of the graph, weighed as they were when customizing.
+    // If either vertex doesn't exist, a DigraphException is thrown.
+    template <typename VertexInfo, typename EdgeInfo>
+    ShortestPath findShortestPath(
+        const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+        const OverlayMetric& metric, int startVertex, int endVertex,
+        OverlaySearch& search) const;
+
+private:
+    MultilevelPartition cells;
+
+    // boundaries[level][cell] lists the cell's boundary vertices, and
+    // boundaryPositions[level][index] is where the vertex at that index
+    // appears in its cell's list, or -1 if it's not on the boundary
+    std::vector<std::vector<std::vector<int>>> boundaries;
+    std::vector<std::vector<int>> boundaryPositions;
+
+    // queryLevel() returns the highest level on which the vertex at the
+    // given index is in a different cell than both the source and the
+    // target, or -1 if there isn't one.
+    int queryLevel(int index, int sourceIndex, int targetIndex) const noexcept;
+};
+
+
+
+template <typename ForEachEdge>
+void LocalSearchSpace::search(
+    int indexBound, int sourceIndex, ForEachEdge forEachEdge, int targetIndex)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    SearchStats* stats = queue.stats();
+    SearchPhaseTimer timer{stats};
+
+    if (static_cast<int>(distance.size()) != indexBound)
+    {
+        distance.assign(indexBound, infinity);
+        predecessor.assign(indexBound, -1);
+        touched.clear();
+        queue.reset(indexBound);
+    }
+
+    for (int v : touched)
+    {
+        distance[v] = infinity;
+        predecessor[v] = -1;
+    }
+
+    touched.clear();
+    queue.clear();
+
+    distance[sourceIndex] = 0.0;
+    touched.push_back(sourceIndex);
+    queue.push(sourceIndex, 0.0);
+    timer.lap(&SearchStats::initSeconds);
+
+    while (!queue.empty())
+    {
+        int v = queue.pop();
+        double dv = distance[v];
+
+        if (v == targetIndex)
+        {
+            break;
+        }
+
+        countSettled(stats);
+
+        forEachEdge(
+            v,
+            [this, stats, v, dv](int w, double weight)
+            {
+                countRelaxed(stats);
+                double dw = dv + weight;
+
+                if (dw < distance[w])
+                {
+                    if (distance[w] == std::numeric_limits<double>::infinity())
+                    {
+                        touched.push_back(w);
+                    }
+
+                    distance[w] = dw;
+                    predecessor[w] = v;
+                    queue.pushOrDecrease(w, dw);
+                }
+            });
+    }
+
+    timer.lap(&SearchStats::searchSeconds);
+}
+
+
+inline bool LocalSearchSpace::reached(int index) const noexcept
+{
+    return distance[index] != std::numeric_limits<double>::infinity();
+}
+
+
+inline PartitionOverlay::PartitionOverlay()
+{
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+PartitionOverlay PartitionOverlay::build(
+    const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+    MultilevelPartition partition)
+{
+    int n = graph.vertexCount();
+
+    PartitionOverlay overlay;
+    overlay.cells = std::move(partition);
+
+    const MultilevelPartition& cells = overlay.cells;
+
+    for (int level = 0; level < cells.levelCount(); ++level)
+    {
+        // a vertex is on the boundary of its cell if an edge in either
+        // direction connects it to another cell
+        std::vector<bool> onBoundary(n, false);
+
+        for (int v = 0; v < n; ++v)
+        {
+            for (int e = graph.edgeBegin(v); e < graph.edgeEnd(v); ++e)
+            {
+                int w = graph.edgeTarget(e);
+
+                if (cells.cell(level, v) != cells.cell(level, w))
+                {
+                    onBoundary[v] = true;
+                    onBoundary[w] = true;
+                }
+            }
+        }
+
+        std::vector<std::vector<int>> boundaries(cells.cellCount(level));
+        std::vector<int> positions(n, -1);
+
+        for (int v = 0; v < n; ++v)
+        {
+            if (onBoundary[v])
+            {
+                std::vector<int>& boundary = boundaries[cells.cell(level, v)];
+                positions[v] = boundary.size();
+                boundary.push_back(v);
+            }
+        }
+
+        overlay.boundaries.push_back(std::move(boundaries));
+        overlay.boundaryPositions.push_back(std::move(positions));
+    }
+
+    return overlay;
+}
+
+
+inline const MultilevelPartition& PartitionOverlay::partition() const noexcept
+{
+    return cells;
+}
+
+
+inline int PartitionOverlay::boundaryVertexCount(int level) const noexcept
+{
+    int count = 0;
+
+    for (const std::vector<int>& boundary : boundaries[level])
+    {
+        count += boundary.size();
+    }
+
+    return count;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+OverlayMetric PartitionOverlay::customize(
+    const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+    int n = graph.vertexCount();
+
+    OverlayMetric metric;
+    metric.edgeWeights.resize(graph.edgeCount());
+
+    for (int e = 0; e < graph.edgeCount(); ++e)
+    {
+        metric.edgeWeights[e] = edgeWeightFunc(graph.edgeInfoAt(e));
+    }
+
+    LocalSearchSpace space;
+
+    for (int level = 0; level < cells.levelCount(); ++level)
+    {
+        // on level 0, searches stay inside the cell on the original
+        // edges; higher up, they cross the cells of the level below using
+        // its cliques, and only need original edges to get between them
+        auto forEachEdge =
+            [this, &graph, &metric, level](int v, auto relax)
+            {
+                int below = level - 1;
+
+                if (level > 0)
+                {
+                    int subcell = cells.cell(below, v);
+                    const std::vector<int>& boundary = boundaries[below][subcell];
+                    const std::vector<double>& clique = metric.cliques[below][subcell];
+                    int k = boundary.size();
+                    int row = boundaryPositions[below][v] * k;
+
+                    for (int j = 0; j < k; ++j)
+                    {
+                        if (boundary[j] != v && clique[row + j] != std::numeric_limits<double>::infinity())
+                        {
+                            relax(boundary[j], clique[row + j]);
+                        }
+                    }
+                }
+
+                for (int e = graph.edgeBegin(v); e < graph.edgeEnd(v); ++e)
+                {
+                    int w = graph.edgeTarget(e);
+
+                    if (cells.cell(level, w) == cells.cell(level, v)
+                        && (level == 0 || cells.cell(below, w) != cells.cell(below, v)))
+                    {
+                        relax(w, metric.edgeWeights[e]);
+                    }
+                }
+            };
+
+        metric.cliques.emplace_back(cells.cellCount(level));
+
+        for (int cell = 0; cell < cells.cellCount(level); ++cell)
+        {
+            const std::vector<int>& boundary = boundaries[level][cell];
+            int k = boundary.size();
+            std::vector<double>& clique = metric.cliques[level][cell];
+            clique.assign(k * k, infinity);
+
+            for (int i = 0; i < k; ++i)
+            {
+                space.search(n, boundary[i], forEachEdge);
+
+                for (int j = 0; j < k; ++j)
+                {
+                    clique[i * k + j] = space.distance[boundary[j]];
+                }
+            }
+        }
+    }
+
+    return metric;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+ShortestPath PartitionOverlay::findShortestPath(
+    const CompactDigraph<VertexInfo, EdgeInfo>& graph,
+    const OverlayMetric& metric, int startVertex, int endVertex,
+    OverlaySearch& search) const
+{
+    if (graph.vertexCount() != cells.vertexCount() && cells.levelCount() > 0)
+    {
+        throw DigraphException("Partition overlay does not match the graph");
+    }
+
+    int n = graph.vertexCount();
+    int s = graph.indexOf(startVertex);
+    int t = graph.indexOf(endVertex);
+
+    // original edges near either end, cliques and the edges between cells
+    // everywhere else
+    auto forEachEdge =
+        [this, &graph, &metric, s, t](int v, auto relax)
+        {
+            int level = queryLevel(v, s, t);
+
+            if (level >= 0)
+            {
+                int cell = cells.cell(level, v);
+                const std::vector<int>& boundary = boundaries[level][cell];
+                const std::vector<double>& clique = metric.cliques[level][cell];
+                int k = boundary.size();
+                int row = boundaryPositions[level][v] * k;
+
+                for (int j = 0; j < k; ++j)
+                {
+                    if (boundary[j] != v && clique[row + j] != std::numeric_limits<double>::infinity())
+                    {
+                        relax(boundary[j], clique[row + j]);
+                    }
+                }
+            }
+
+            for (int e = graph.edgeBegin(v); e < graph.edgeEnd(v); ++e)
+            {
+                int w = graph.edgeTarget(e);
+
+                if (level == -1 || cells.cell(level, w) != cells.cell(level, v))
+                {
+                    relax(w, metric.edgeWeights[e]);
+                }
+            }
+        };
+
+    search.query.search(n, s, forEachEdge, t);
+
+    ShortestPath path;
+
+    if (!search.query.reached(t))
+    {
+        return path;
+    }
+
+    // putting the path together includes searching cells again, which is
+    // timed as part of it rather than counted as more searching
+    SearchPhaseTimer timer{search.query.queue.stats()};
+
+    // the overlay path, which may cross whole cells in one step
+    std::vector<int> overlayPath;
+
+    for (int v = t; v != -1; v = search.query.predecessor[v])
+    {
+        overlayPath.push_back(v);
+    }
+
+    std::reverse(overlayPath.begin(), overlayPath.end());
+
+    // appends the original edge from -> to, the lightest if several
+    auto appendEdge =
+        [&graph, &metric, &path](int from, int to)
+        {
+            int best = -1;
+
+            for (int e = graph.edgeBegin(from); e < graph.edgeEnd(from); ++e)
+            {
+                if (graph.edgeTarget(e) == to
+                    && (best == -1 || metric.edgeWeights[e] < metric.edgeWeights[best]))
+                {
+                    best = e;
+                }
+            }
+
+            path.vertices.push_back(graph.vertexNumber(to));
+            path.weights.push_back(metric.edgeWeights[best]);
+            path.totalCost += metric.edgeWeights[best];
+        };
+
+    path.totalCost = 0.0;
+    path.vertices.push_back(startVertex);
+
+    for (std::size_t i = 1; i < overlayPath.size(); ++i)
+    {
+        int u = overlayPath[i - 1];
+        int v = overlayPath[i];
+        int level = queryLevel(u, s, t);
+
+        if (level == -1 || cells.cell(level, u) != cells.cell(level, v))
+        {
+            appendEdge(u, v);
+            continue;
+        }
+
+        // a clique step is a shortest path within the cell, which is found
+        // again on the original edges
+        int cell = cells.cell(level, u);
+
+        search.unpack.search(
+            n, u,
+            [this, &graph, &metric, level, cell](int x, auto relax)
+            {
+                for (int e = graph.edgeBegin(x); e < graph.edgeEnd(x); ++e)
+                {
+                    if (cells.cell(level, graph.edgeTarget(e)) == cell)
+                    {
+                        relax(graph.edgeTarget(e), metric.edgeWeights[e]);
+                    }
+                }
+            },
+            v);
+
+        std::vector<int> within;
+
+        for (int x = v; x != u; x = search.unpack.predecessor[x])
+        {
+            within.push_back(x);
+        }
+
+        for (int from = u; !within.empty(); within.pop_back())
+        {
+            appendEdge(from, within.back());
+            from = within.back();
+        }
+    }
+
+    timer.lap(&SearchStats::pathSeconds);
+
+    return path;
+}
+
+
+inline int PartitionOverlay::queryLevel(int index, int sourceIndex, int targetIndex) const noexcept
+{
+    for (int level = cells.levelCount() - 1; level >= 0; --level)
+    {
+        int cell = cells.cell(level, index);
+
+        if (cell != cells.cell(level, sourceIndex) && cell != cells.cell(level, targetIndex))
+        {
+            return level;
+        }
+    }
+
+    return -1;
+}
+
+
+
+#endif // PARTITIONOVERLAY_HPP
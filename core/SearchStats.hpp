@@ -0,0 +1,178 @@
+// SearchStats.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares SearchStats, which describes how much work a
+// shortest path query did, and SearchPhaseTimer, which times the phases of
+// one.  Statistics are only collected when the program is built with
+// DIGRAPH_SEARCH_STATS defined (e.g., with -DDIGRAPH_SEARCH_STATS on the
+// compiler's command line), and only for searches whose queues have been
+// handed a SearchStats to collect into (see IndexedDaryHeap::collectStats()).
+//
+// Without DIGRAPH_SEARCH_STATS, everything that collects statistics
+// compiles to nothing, so searches don't pay for them at all, and every
+// SearchStats stays zero.  The whole program has to be built the same way,
+// since IndexedDaryHeap is laid out differently with and without it.
+
+#ifndef SEARCHSTATS_HPP
+#define SEARCHSTATS_HPP
+
+#include <algorithm>
+#include <chrono>
+
+
+
+struct SearchStats
+{
+    // true if this build collects statistics at all
+#ifdef DIGRAPH_SEARCH_STATS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    // vertices whose edges were followed, and edges followed from them
+    long long settled = 0;
+    long long relaxed = 0;
+
+    // operations on the search's priority queues, and the most vertices
+    // that any one of them held at once
+    long long pushes = 0;
+    long long pops = 0;
+    long long decreaseKeys = 0;
+    long long peakQueueSize = 0;
+
+    // wall time, in seconds, spent preparing the search's scratch space,
+    // searching, and putting the path together afterward
+    double initSeconds = 0.0;
+    double searchSeconds = 0.0;
+    double pathSeconds = 0.0;
+
+    // totalSeconds() returns the time spent in all three phases.
+    double totalSeconds() const noexcept;
+
+    // operator+= adds another query's statistics to these ones, keeping
+    // the larger of the two peak queue sizes.
+    SearchStats& operator+=(const SearchStats& other) noexcept;
+};
+
+
+
+// countSettled() and countRelaxed() count one settled vertex or one
+// relaxed edge into the given SearchStats, if there is one.
+
+void countSettled(SearchStats* stats) noexcept;
+void countRelaxed(SearchStats* stats) noexcept;
+
+
+
+// A SearchPhaseTimer measures the phases of a search one after another.
+// Each lap() adds the time since the timer was constructed, or since the
+// previous lap(), to one of the given SearchStats' phases.  Without a
+// SearchStats (or without DIGRAPH_SEARCH_STATS), it never reads the clock.
+
+class SearchPhaseTimer
+{
+public:
+    explicit SearchPhaseTimer(SearchStats* stats) noexcept;
+
+    void lap(double SearchStats::* phase) noexcept;
+
+#ifdef DIGRAPH_SEARCH_STATS
+private:
+    SearchStats* stats_;
+    std::chrono::steady_clock::time_point last_;
+#endif
+};
+
+
+
+inline double SearchStats::totalSeconds() const noexcept
+{
+    return initSeconds + searchSeconds + pathSeconds;
+}
+
+
+inline SearchStats& SearchStats::operator+=(const SearchStats& other) noexcept
+{
+    settled += other.settled;
+    relaxed += other.relaxed;
+    pushes += other.pushes;
+    pops += other.pops;
+    decreaseKeys += other.decreaseKeys;
+    peakQueueSize = std::max(peakQueueSize, other.peakQueueSize);
+    initSeconds += other.initSeconds;
+    searchSeconds += other.searchSeconds;
+    pathSeconds += other.pathSeconds;
+
+    return *this;
+}
+
+
+#ifdef DIGRAPH_SEARCH_STATS
+
+inline void countSettled(SearchStats* stats) noexcept
+{
+    if (stats != nullptr)
+    {
+        ++stats->settled;
+    }
+}
+
+
+inline void countRelaxed(SearchStats* stats) noexcept
+{
+    if (stats != nullptr)
+    {
+        ++stats->relaxed;
+    }
+}
+
+
+inline SearchPhaseTimer::SearchPhaseTimer(SearchStats* stats) noexcept
+    : stats_{stats}
+{
+    if (stats_ != nullptr)
+    {
+        last_ = std::chrono::steady_clock::now();
+    }
+}
+
+
+inline void SearchPhaseTimer::lap(double SearchStats::* phase) noexcept
+{
+    if (stats_ != nullptr)
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        stats_->*phase += std::chrono::duration<double>(now - last_).count();
+        last_ = now;
+    }
+}
+
+#else
+
+inline void countSettled(SearchStats*) noexcept
+{
+}
+
+
+inline void countRelaxed(SearchStats*) noexcept
+{
+}
+
+
+inline SearchPhaseTimer::SearchPhaseTimer(SearchStats*) noexcept
+{
+}
+
+
+inline void SearchPhaseTimer::lap(double SearchStats::*) noexcept
+{
+}
+
+#endif
+
+
+
+#endif // SEARCHSTATS_HPP
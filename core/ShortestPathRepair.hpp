@@ -0,0 +1,189 @@
+// ShortestPathRepair.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares the repairShortestPaths() function template,
+// which brings a ShortestPathTree up to date after the weights of some of
+// the graph's edges have changed, without searching the whole graph again.
+// It follows the approach of Ramalingam and Reps:
+//
+// * When an edge on the tree gets more expensive, only the vertices below
+//   it in the tree can be affected.  Their distances are thrown away, each
+//   is given the best distance it can get straight from an unaffected
+//   vertex, and then they're settled among themselves as in Dijkstra's
+//   algorithm.
+//
+// * When an edge gets cheaper, it can only help the vertex it points to,
+//   and whatever that vertex then helps in turn, so Dijkstra's algorithm
+//   picks up from there.
+//
+// Both kinds of changes share one priority queue, so any mix of them costs
+// roughly as much as the part of the tree that actually changes.
+//
+// Like searchShortestPaths(), everything here is in terms of dense vertex
+// indices, and the graph is described by callbacks that report its
+// current (already changed) edge weights.
+
+#ifndef SHORTESTPATHREPAIR_HPP
+#define SHORTESTPATHREPAIR_HPP
+
+#include <limits>
+#include <utility>
+#include <vector>
+#include "ShortestPathTree.hpp"
+
+
+
+// repairShortestPaths() updates the given tree, which must hold a complete
+// result of searchShortestPaths() (one run without a target index), after
+// the weights of the edges listed in changedEdges have changed.  Each
+// changed edge is given as a pair of dense indices (from, to).
+//
+// forEachEdge(v, relax) must call relax(w, weight) for every edge from
+// index v to index w, and forEachInEdge(w, relax) must call relax(v,
+// weight) for every edge from index v to index w, both using the new
+// weights.  Edge weights must not be negative.
+//
+// Afterward, every distance in the tree is the same as a new search would
+// find.  Where several paths tie, the predecessors may pick a different
+// one than a new search would.
+
+template <typename ForEachEdge, typename ForEachInEdge>
+void repairShortestPaths(
+    ShortestPathTree& tree,
+    const std::vector<std::pair<int, int>>& changedEdges,
+    ForEachEdge forEachEdge, ForEachInEdge forEachInEdge);
+
+
+
+template <typename ForEachEdge, typename ForEachInEdge>
+void repairShortestPaths(
+    ShortestPathTree& tree,
+    const std::vector<std::pair<int, int>>& changedEdges,
+    ForEachEdge forEachEdge, ForEachInEdge forEachInEdge)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    int indexBound = tree.distance.size();
+    tree.queue.clear();
+
+    // every vertex below a changed tree edge is affected, since the path
+    // it was relying on may now cost more
+    std::vector<bool> affected(indexBound, false);
+    std::vector<int> affectedList;
+    std::vector<int> stack;
+
+    for (const std::pair<int, int>& edge : changedEdges)
+    {
+        int v = edge.first;
+        int w = edge.second;
+
+        if (tree.predecessor[w] != v || affected[w])
+        {
+            continue;
+        }
+
+        stack.push_back(w);
+        affected[w] = true;
+
+        while (!stack.empty())
+        {
+            int x = stack.back();
+            stack.pop_back();
+            affectedList.push_back(x);
+
+            // x's children in the tree are the vertices its edges lead to
+            // that have x as their predecessor
+            forEachEdge(
+                x,
+                [&tree, &affected, &stack, x](int y, double)
+                {
+                    if (tree.predecessor[y] == x && !affected[y])
+                    {
+                        affected[y] = true;
+                        stack.push_back(y);
+                    }
+                });
+        }
+    }
+
+    for (int a : affectedList)
+    {
+        tree.distance[a] = infinity;
+        tree.predecessor[a] = -1;
+    }
+
+    // an affected vertex starts from its best edge from outside the
+    // affected part, whose distances are all still right
+    for (int a : affectedList)
+    {
+        forEachInEdge(
+            a,
+            [&tree, &affected, a](int u, double weight)
+            {
+                if (!affected[u] && tree.distance[u] + weight < tree.distance[a])
+                {
+                    tree.distance[a] = tree.distance[u] + weight;
+                    tree.predecessor[a] = u;
+                }
+            });
+
+        if (tree.reached(a))
+        {
+            tree.queue.pushOrDecrease(a, tree.distance[a]);
+        }
+    }
+
+    // a changed edge from an unaffected vertex may now be a shortcut;
+    // affected vertices' edges get their turn when they're settled below
+    for (const std::pair<int, int>& edge : changedEdges)
+    {
+        int v = edge.first;
+        int w = edge.second;
+
+        if (affected[v] || !tree.reached(v))
+        {
+            continue;
+        }
+
+        double dv = tree.distance[v];
+
+        forEachEdge(
+            v,
+            [&tree, v, w, dv](int y, double weight)
+            {
+                if (y == w && dv + weight < tree.distance[w])
+                {
+                    tree.distance[w] = dv + weight;
+                    tree.predecessor[w] = v;
+                    tree.queue.pushOrDecrease(w, dv + weight);
+                }
+            });
+    }
+
+    // then Dijkstra's algorithm carries every improvement as far as it goes
+    while (!tree.queue.empty())
+    {
+        int v = tree.queue.pop();
+        double dv = tree.distance[v];
+
+        forEachEdge(
+            v,
+            [&tree, v, dv](int w, double weight)
+            {
+                double dw = dv + weight;
+
+                if (dw < tree.distance[w])
+                {
+                    tree.distance[w] = dw;
+                    tree.predecessor[w] = v;
+                    tree.queue.pushOrDecrease(w, dw);
+                }
+            });
+    }
+}
+
+
+
+#endif // SHORTESTPATHREPAIR_HPP
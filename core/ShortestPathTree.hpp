@@ -0,0 +1,210 @@
+// ShortestPathTree.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares ShortestPathTree, which holds the result of a
+// single-source shortest path search in dense form, along with the
+// searchShortestPaths() function template that fills one in using
+// Dijkstra's algorithm.  It also declares ShortestPath, which describes a
+// single path between two vertices, and tracePath(), which pulls one out
+// of a ShortestPathTree.
+//
+// Everything here works in terms of dense vertex indices (0..N-1) rather
+// than vertex numbers, so that distances and predecessors can be kept in
+// plain vectors.  Both Digraph and CompactDigraph hand out dense indices
+// and know how to translate them back into vertex numbers.
+
+#ifndef SHORTESTPATHTREE_HPP
+#define SHORTESTPATHTREE_HPP
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "IndexedDaryHeap.hpp"
+#include "SearchStats.hpp"
+
+
+
+// A ShortestPathTree stores, for the vertex at each dense index i, the
+// length of the shortest path to it from the source (distance[i]) and the
+// index of the vertex before it on that path (predecessor[i]).  Vertices
+// that were never reached have an infinite distance; they and the source
+// itself have a predecessor of -1.
+//
+// A ShortestPathTree is meant to be reused: searching again with the same
+// tree overwrites the previous result without reallocating anything, as
+// long as the graph hasn't grown in the meantime.
+
+struct ShortestPathTree
+{
+    int source = -1;
+    std::vector<double> distance;
+    std::vector<int> predecessor;
+
+    // scratch space used during the search, kept here so that it's
+    // reused along with the result arrays
+    IndexedDaryHeap<double> queue;
+
+    // reset() prepares the tree for a search over indices 0..indexBound-1
+    // starting from the given source index.
+    void reset(int indexBound, int sourceIndex);
+
+    // reached() returns true if a path to the given index was found.
+    bool reached(int index) const noexcept;
+};
+
+
+
+// A ShortestPath describes one path through a graph using vertex numbers.
+// vertices lists the vertices along the path in order, from the start
+// vertex to the end vertex, and weights[i] is the weight of the edge from
+// vertices[i] to vertices[i + 1].  totalCost is the sum of the weights.
+// When there is no path at all, vertices and weights are empty and
+// totalCost is infinite.
+
+struct ShortestPath
+{
+    std::vector<int> vertices;
+    std::vector<double> weights;
+    double totalCost = std::numeric_limits<double>::infinity();
+
+    // exists() returns true if a path was found.
+    bool exists() const noexcept;
+};
+
+
+
+// searchShortestPaths() runs Dijkstra's algorithm from the source index,
+// writing the result into the given tree.  The graph is described by
+// forEachEdge, which is called as forEachEdge(v, relax) and must call
+// relax(w, weight) once for every edge from index v to index w.  Edge
+// weights must not be negative.
+//
+// If a target index is given, the search stops as soon as the target is
+// settled.  The tree then holds a shortest path to the target, but the
+// distances of vertices further away than the target are not final.
+
+template <typename ForEachEdge>
+void searchShortestPaths(
+    ShortestPathTree& tree, int indexBound, int sourceIndex,
+    ForEachEdge forEachEdge, int targetIndex = -1);
+
+
+// tracePath() follows the predecessors in the tree back from the target
+// index and returns the path to it in terms of vertex numbers.  The
+// weight of each edge on the path is found by calling edgeWeight(v, w)
+// with the dense indices of its endpoints, and vertexNumber(i) is called
+// to turn a dense index into a vertex number.
+
+template <typename EdgeWeight, typename VertexNumber>
+ShortestPath tracePath(
+    const ShortestPathTree& tree, int targetIndex,
+    EdgeWeight edgeWeight, VertexNumber vertexNumber);
+
+
+
+inline void ShortestPathTree::reset(int indexBound, int sourceIndex)
+{
+    source = sourceIndex;
+    distance.assign(indexBound, std::numeric_limits<double>::infinity());
+    predecessor.assign(indexBound, -1);
+    queue.reset(indexBound);
+}
+
+
+inline bool ShortestPathTree::reached(int index) const noexcept
+{
+    return distance[index] != std::numeric_limits<double>::infinity();
+}
+
+
+inline bool ShortestPath::exists() const noexcept
+{
+    return !vertices.empty();
+}
+
+
+template <typename ForEachEdge>
+void searchShortestPaths(
+    ShortestPathTree& tree, int indexBound, int sourceIndex,
+    ForEachEdge forEachEdge, int targetIndex)
+{
+    SearchStats* stats = tree.queue.stats();
+    SearchPhaseTimer timer{stats};
+
+    tree.reset(indexBound, sourceIndex);
+
+    tree.distance[sourceIndex] = 0.0;
+    tree.queue.push(sourceIndex, 0.0);
+    timer.lap(&SearchStats::initSeconds);
+
+    while (!tree.queue.empty())
+    {
+        // the closest unsettled vertex is settled for good once popped
+        int v = tree.queue.pop();
+        double dv = tree.distance[v];
+
+        if (v == targetIndex)
+        {
+            break;
+        }
+
+        countSettled(stats);
+
+        forEachEdge(
+            v,
+            [&tree, stats, v, dv](int w, double weight)
+            {
+                countRelaxed(stats);
+                double dw = dv + weight;
+
+                if (dw < tree.distance[w])
+                {
+                    tree.distance[w] = dw;
+                    tree.predecessor[w] = v;
+                    tree.queue.pushOrDecrease(w, dw);
+                }
+            });
+    }
+
+    timer.lap(&SearchStats::searchSeconds);
+}
+
+
+template <typename EdgeWeight, typename VertexNumber>
+ShortestPath tracePath(
+    const ShortestPathTree& tree, int targetIndex,
+    EdgeWeight edgeWeight, VertexNumber vertexNumber)
+{
+    ShortestPath path;
+
+    if (!tree.reached(targetIndex))
+    {
+        return path;
+    }
+
+    SearchPhaseTimer timer{tree.queue.stats()};
+    path.totalCost = tree.distance[targetIndex];
+
+    // walk backward from the target, then flip everything around
+    for (int w = targetIndex; w != -1; w = tree.predecessor[w])
+    {
+        path.vertices.push_back(vertexNumber(w));
+
+        if (tree.predecessor[w] != -1)
+        {
+            path.weights.push_back(edgeWeight(tree.predecessor[w], w));
+        }
+    }
+
+    std::reverse(path.vertices.begin(), path.vertices.end());
+    std::reverse(path.weights.begin(), path.weights.end());
+    timer.lap(&SearchStats::pathSeconds);
+
+    return path;
+}
+
+
+
+#endif // SHORTESTPATHTREE_HPP
@@ -0,0 +1,185 @@
+// StronglyConnectedComponents.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares StronglyConnectedComponents, which records
+// which strongly connected component each vertex of a graph belongs to,
+// along with the findStronglyConnectedComponents() function template that
+// fills one in using Tarjan's algorithm.  Two vertices are in the same
+// component when each can be reached from the other.
+//
+// Like the searches in ShortestPathTree.hpp, everything here works in terms
+// of dense vertex indices, and the graph is described by callbacks, so the
+// same code works for both Digraph and CompactDigraph.
+//
+// Tarjan's algorithm is a depth-first search, which is usually written
+// recursively; this one keeps its own stack instead, so that a path of
+// millions of vertices can't overflow the call stack.
+
+#ifndef STRONGLYCONNECTEDCOMPONENTS_HPP
+#define STRONGLYCONNECTEDCOMPONENTS_HPP
+
+#include <algorithm>
+#include <vector>
+
+
+
+// A StronglyConnectedComponents stores, for the vertex at each dense index
+// i, the number of its component (component[i]), from 0 to count - 1.
+// Indices that aren't in use have a component of -1.
+//
+// Components are numbered in reverse topological order: whenever an edge
+// leads from one component into a different one, the component it leads
+// into has the smaller number.  So a path from a vertex in component a to
+// a vertex in component b can only exist if a >= b.
+
+struct StronglyConnectedComponents
+{
+    int count = 0;
+    std::vector<int> component;
+
+    // sameComponent() returns true if the vertices at the two indices can
+    // each reach the other.
+    bool sameComponent(int index1, int index2) const noexcept;
+
+    // mightReach() returns false if there's certainly no path from the
+    // vertex at fromIndex to the vertex at toIndex, using only the order
+    // of the components.  (A true result isn't a promise that a path
+    // exists, unless the two are in the same component.)
+    bool mightReach(int fromIndex, int toIndex) const noexcept;
+};
+
+
+
+// findStronglyConnectedComponents() fills in the given components for a
+// graph with indices 0..indexBound-1.  inUse(v) must return true for each
+// index v that belongs to a vertex, and forEachEdge(v, visit) must call
+// visit(w) once for every edge from index v to index w.
+template <typename InUse, typename ForEachEdge>
+void findStronglyConnectedComponents(
+    StronglyConnectedComponents& components,
+    int indexBound, InUse inUse, ForEachEdge forEachEdge);
+
+
+
+inline bool StronglyConnectedComponents::sameComponent(int index1, int index2) const noexcept
+{
+    return component[index1] == component[index2];
+}
+
+
+inline bool StronglyConnectedComponents::mightReach(int fromIndex, int toIndex) const noexcept
+{
+    return component[fromIndex] >= component[toIndex];
+}
+
+
+template <typename InUse, typename ForEachEdge>
+void findStronglyConnectedComponents(
+    StronglyConnectedComponents& components,
+    int indexBound, InUse inUse, ForEachEdge forEachEdge)
+{
+    components.count = 0;
+    components.component.assign(indexBound, -1);
+
+    // order[v] is when v was first visited (-1 if it hasn't been yet), and
+    // low[v] the earliest-visited vertex still on the stack that v's part
+    // of the search has found an edge to
+    std::vector<int> order(indexBound, -1);
+    std::vector<int> low(indexBound);
+    std::vector<bool> onStack(indexBound, false);
+    std::vector<int> stack;
+    int visited = 0;
+
+    // one frame per vertex on the current depth-first path; a frame's
+    // neighbors are neighbors[begin .. end - 1], of which the ones from
+    // next onward haven't been explored yet
+    struct Frame
+    {
+        int vertex;
+        int begin;
+        int next;
+        int end;
+    };
+
+    std::vector<Frame> path;
+    std::vector<int> neighbors;
+
+    auto enter = [&](int v)
+    {
+        order[v] = low[v] = visited++;
+        stack.push_back(v);
+        onStack[v] = true;
+
+        int begin = neighbors.size();
+        forEachEdge(v, [&neighbors](int w) { neighbors.push_back(w); });
+        path.push_back(Frame{v, begin, begin, static_cast<int>(neighbors.size())});
+    };
+
+    for (int root = 0; root < indexBound; ++root)
+    {
+        if (!inUse(root) || order[root] != -1)
+        {
+            continue;
+        }
+
+        enter(root);
+
+        while (!path.empty())
+        {
+            Frame& frame = path.back();
+
+            if (frame.next < frame.end)
+            {
+                int v = frame.vertex;
+                int w = neighbors[frame.next++];
+
+                if (order[w] == -1)
+                {
+                    // frame can't be used after this, since path may grow
+                    enter(w);
+                }
+                else if (onStack[w])
+                {
+                    low[v] = std::min(low[v], order[w]);
+                }
+
+                continue;
+            }
+
+            // every edge out of v has been followed
+            int v = frame.vertex;
+            neighbors.resize(frame.begin);
+            path.pop_back();
+
+            if (low[v] == order[v])
+            {
+                // v is the first vertex visited in its component, and
+                // everything above it on the stack is in there with it
+                int w;
+
+                do
+                {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = false;
+                    components.component[w] = components.count;
+                }
+                while (w != v);
+
+                ++components.count;
+            }
+
+            if (!path.empty())
+            {
+                int parent = path.back().vertex;
+                low[parent] = std::min(low[parent], low[v]);
+            }
+        }
+    }
+}
+
+
+
+#endif // STRONGLYCONNECTEDCOMPONENTS_HPP
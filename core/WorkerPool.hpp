@@ -0,0 +1,194 @@
+// WorkerPool.hpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called WorkerPool, which keeps a fixed
+// number of threads around and uses them to run batches of independent
+// tasks.  Each task is identified by a number (0..taskCount-1), and tasks
+// are handed out to whichever worker is free next, so a batch of tasks
+// that take very different amounts of time still keeps every worker busy.
+//
+// Every task is also told which worker (0..workerCount()-1) is running it,
+// so that each worker can have its own scratch space, such as its own
+// ShortestPathTree, without any locking.
+//
+// The thread that calls run() works on the batch too, so a pool with one
+// worker starts no threads at all and simply runs every task in order.
+
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+class WorkerPool
+{
+public:
+    // Initializes a pool with the given number of workers (at least one),
+    // starting workerCount - 1 threads.
+    explicit WorkerPool(int workerCount);
+
+    // The destructor waits for the threads to finish and stops them.
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // workerCount() returns the number of workers, including the thread
+    // that calls run().
+    int workerCount() const noexcept;
+
+    // run() calls task(taskNumber, workerNumber) once for each task number
+    // from 0 to taskCount - 1, spread across the workers, and returns once
+    // every call has returned.  If any call throws an exception, the rest
+    // of the tasks are skipped and the first exception is rethrown here.
+    void run(int taskCount, std::function<void(int, int)> task);
+
+private:
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable batchReady;
+    std::condition_variable batchDone;
+
+    // the batch being run; generation counts batches so that a thread
+    // knows when a new one has started
+    std::function<void(int, int)> currentTask;
+    int taskCount;
+    std::atomic<int> nextTask;
+    int busyThreads;
+    unsigned long generation;
+    bool stopping;
+    std::exception_ptr failure;
+
+    void work(int workerNumber);
+    void runTasks(int workerNumber);
+};
+
+
+
+inline WorkerPool::WorkerPool(int workerCount)
+    : taskCount{0}, nextTask{0}, busyThreads{0}, generation{0}, stopping{false}
+{
+    for (int worker = 1; worker < workerCount; ++worker)
+    {
+        threads.emplace_back(&WorkerPool::work, this, worker);
+    }
+}
+
+
+inline WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+
+    batchReady.notify_all();
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+
+inline int WorkerPool::workerCount() const noexcept
+{
+    return threads.size() + 1;
+}
+
+
+inline void WorkerPool::run(int taskCount, std::function<void(int, int)> task)
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        currentTask = std::move(task);
+        this->taskCount = taskCount;
+        nextTask = 0;
+        busyThreads = threads.size();
+        failure = nullptr;
+        ++generation;
+    }
+
+    batchReady.notify_all();
+
+    runTasks(0);
+
+    std::unique_lock<std::mutex> lock{mutex};
+    batchDone.wait(lock, [this] { return busyThreads == 0; });
+
+    currentTask = nullptr;
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+
+inline void WorkerPool::work(int workerNumber)
+{
+    unsigned long seen = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            batchReady.wait(lock, [this, seen] { return stopping || generation != seen; });
+
+            if (stopping)
+            {
+                return;
+            }
+
+            seen = generation;
+        }
+
+        runTasks(workerNumber);
+
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            --busyThreads;
+        }
+
+        batchDone.notify_one();
+    }
+}
+
+
+inline void WorkerPool::runTasks(int workerNumber)
+{
+    // tasks are claimed one at a time; claiming past the end (or after a
+    // failure, which pushes nextTask past the end) means the batch is done
+    for (int task = nextTask++; task < taskCount; task = nextTask++)
+    {
+        try
+        {
+            currentTask(task, workerNumber);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+
+            if (!failure)
+            {
+                failure = std::current_exception();
+            }
+
+            nextTask = taskCount;
+        }
+    }
+}
+
+
+
+#endif // WORKERPOOL_HPP
@@ -0,0 +1,272 @@
+// CompactDigraph_Tests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for CompactDigraph, mostly checking that a snapshot answers
+// the same questions the same way as the Digraph it was taken from.
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+
+
+namespace
+{
+    Digraph<std::string, double> makeDiamond()
+    {
+        Digraph<std::string, double> d;
+        d.addVertex(10, "A");
+        d.addVertex(20, "B");
+        d.addVertex(30, "C");
+        d.addVertex(40, "D");
+
+        d.addEdge(10, 20, 1.0);
+        d.addEdge(10, 30, 4.0);
+        d.addEdge(20, 30, 1.0);
+        d.addEdge(30, 40, 1.0);
+        d.addEdge(20, 40, 5.0);
+
+        return d;
+    }
+
+
+    double identity(double edgeInfo)
+    {
+        return edgeInfo;
+    }
+}
+
+
+TEST(CompactDigraph_Tests, snapshotHasSameVerticesAndEdges)
+{
+    Digraph<std::string, double> d = makeDiamond();
+    CompactDigraph<std::string, double> c{d};
+
+    ASSERT_EQ(d.vertexCount(), c.vertexCount());
+    ASSERT_EQ(d.edgeCount(), c.edgeCount());
+    ASSERT_EQ(d.vertices(), c.vertices());
+
+    std::vector<std::pair<int, int>> expected = d.edges();
+    std::vector<std::pair<int, int>> actual = c.edges();
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    ASSERT_EQ(expected, actual);
+
+    ASSERT_EQ(2, c.edgeCount(20));
+    ASSERT_EQ("C", c.vertexInfo(30));
+    ASSERT_EQ(4.0, c.edgeInfo(10, 30));
+}
+
+
+TEST(CompactDigraph_Tests, snapshotOfExpiringDigraphMovesItsInfosIn)
+{
+    Digraph<std::string, double> d = makeDiamond();
+    d.removeVertex(10);
+
+    // long enough that moving it can't be told apart from copying it
+    d.addVertex(50, std::string(100, 'E'));
+    d.addEdge(40, 50, 2.0);
+    const char* longName = d.vertexInfo(50).c_str();
+
+    CompactDigraph<std::string, double> c{std::move(d)};
+
+    ASSERT_EQ((std::vector<int>{20, 30, 40, 50}), c.vertices());
+    ASSERT_EQ("C", c.vertexInfo(30));
+    ASSERT_EQ(longName, c.vertexInfo(50).c_str());
+    ASSERT_EQ(2.0, c.edgeInfo(40, 50));
+    ASSERT_EQ(5.0, c.edgeInfo(20, 40));
+}
+
+
+TEST(CompactDigraph_Tests, snapshotIsUnaffectedByLaterChanges)
+{
+    Digraph<std::string, double> d = makeDiamond();
+    CompactDigraph<std::string, double> c{d};
+
+    d.removeEdge(10, 20);
+    d.addVertex(50, "E");
+
+    ASSERT_EQ(4, c.vertexCount());
+    ASSERT_EQ(1.0, c.edgeInfo(10, 20));
+}
+
+
+TEST(CompactDigraph_Tests, missingVerticesAndEdgesThrow)
+{
+    CompactDigraph<std::string, double> c{makeDiamond()};
+
+    ASSERT_THROW({ c.vertexInfo(15); }, DigraphException);
+    ASSERT_THROW({ c.edges(15); }, DigraphException);
+    ASSERT_THROW({ c.edgeInfo(40, 10); }, DigraphException);
+    ASSERT_THROW({ c.edgeInfo(10, 99); }, DigraphException);
+}
+
+
+TEST(CompactDigraph_Tests, findsShortestPathsThroughCheaperDetours)
+{
+    CompactDigraph<std::string, double> c{makeDiamond()};
+
+    std::map<int, int> paths = c.findShortestPaths(10, identity);
+
+    ASSERT_EQ(4, paths.size());
+    ASSERT_EQ(10, paths[10]);
+    ASSERT_EQ(10, paths[20]);
+    ASSERT_EQ(20, paths[30]);
+    ASSERT_EQ(30, paths[40]);
+}
+
+
+TEST(CompactDigraph_Tests, unreachableVerticesAreTheirOwnPredecessors)
+{
+    CompactDigraph<std::string, double> c{makeDiamond()};
+
+    std::map<int, int> paths = c.findShortestPaths(30, identity);
+
+    ASSERT_EQ(10, paths[10]);
+    ASSERT_EQ(20, paths[20]);
+    ASSERT_EQ(30, paths[40]);
+}
+
+
+TEST(CompactDigraph_Tests, oneTreeAnswersEveryTripFromTheSameStart)
+{
+    CompactDigraph<std::string, double> c{makeDiamond()};
+
+    ShortestPathTree tree;
+    c.findShortestPaths(10, identity, tree);
+
+    for (int end : {10, 20, 30, 40})
+    {
+        ShortestPath expected = c.findShortestPath(10, end, identity);
+        ShortestPath actual = c.pathTo(tree, end, identity);
+
+        ASSERT_EQ(expected.vertices, actual.vertices);
+        ASSERT_EQ(expected.weights, actual.weights);
+        ASSERT_EQ(expected.totalCost, actual.totalCost);
+    }
+
+    c.findShortestPaths(30, identity, tree);
+    ASSERT_FALSE(c.pathTo(tree, 10, identity).exists());
+    ASSERT_THROW({ c.pathTo(tree, 50, identity); }, DigraphException);
+}
+
+
+TEST(CompactDigraph_Tests, anyCallableWeighsEdgesLikeAStdFunction)
+{
+    CompactDigraph<std::string, double> c{makeDiamond()};
+
+    std::function<double(const double&)> wrapped = identity;
+    auto doubled = [](const double& edgeInfo) { return 2.0 * edgeInfo; };
+    auto noEstimate = [](int) { return 0.0; };
+
+    ShortestPathTree tree;
+    BidirectionalSearchSpace space;
+
+    ShortestPath expected = c.findShortestPath(10, 40, wrapped, tree);
+
+    ASSERT_EQ(expected.vertices, c.findShortestPath(10, 40, doubled, tree).vertices);
+    ASSERT_EQ(2.0 * expected.totalCost, c.findShortestPath(10, 40, doubled, tree).totalCost);
+    ASSERT_EQ(expected.vertices, c.findShortestPathBidirectional(10, 40, doubled, space).vertices);
+    ASSERT_EQ(expected.vertices, c.findShortestPathAStar(10, 40, doubled, noEstimate, tree).vertices);
+
+    c.findShortestPaths(10, doubled, tree);
+    ASSERT_EQ(2.0 * expected.totalCost, c.pathTo(tree, 40, doubled).totalCost);
+}
+
+
+TEST(CompactDigraph_Tests, weightColumnsStandInForWeightFunctions)
+{
+    CompactDigraph<std::string, double> c{makeDiamond()};
+    EdgeWeightColumn column = EdgeWeightColumn::build(c, identity);
+
+    ASSERT_EQ(c.edgeCount(), column.edgeCount());
+
+    ShortestPathTree tree;
+    BidirectionalSearchSpace space;
+
+    ShortestPath expected = c.findShortestPath(10, 40, identity, tree);
+    ShortestPath actual = c.findShortestPathBidirectional(10, 40, column, space);
+
+    ASSERT_EQ(expected.vertices, actual.vertices);
+    ASSERT_EQ(expected.weights, actual.weights);
+    ASSERT_EQ(expected.totalCost, actual.totalCost);
+
+    // making 10 -> 30 cheap changes the route without touching the graph
+    column.update(c.edgeBegin(c.indexOf(10)) + 1, 0.5);
+    ShortestPath cheaper = c.findShortestPath(10, 40, column, tree);
+
+    ASSERT_EQ((std::vector<int>{10, 30, 40}), cheaper.vertices);
+    ASSERT_EQ(1.5, cheaper.totalCost);
+}
+
+
+TEST(CompactDigraph_Tests, stronglyConnectedOnlyWhenEveryVertexReachesEveryOther)
+{
+    Digraph<std::string, double> d = makeDiamond();
+    CompactDigraph<std::string, double> before{d};
+    ASSERT_FALSE(before.isStronglyConnected());
+
+    d.addEdge(40, 10, 1.0);
+    CompactDigraph<std::string, double> after{d};
+    ASSERT_TRUE(after.isStronglyConnected());
+}
+
+
+TEST(CompactDigraph_Tests, fromArraysRebuildsTheSameSnapshot)
+{
+    using Compact = CompactDigraph<std::string, double>;
+    Compact c{makeDiamond()};
+
+    std::vector<int> offsets;
+    std::vector<int> targets;
+    std::vector<double> edgeInfos;
+    std::vector<std::string> vertexInfos;
+
+    for (int i = 0; i < c.vertexCount(); ++i)
+    {
+        offsets.push_back(c.edgeBegin(i));
+        vertexInfos.push_back(c.vertexInfoAt(i));
+    }
+
+    offsets.push_back(c.edgeCount());
+
+    for (int e = 0; e < c.edgeCount(); ++e)
+    {
+        targets.push_back(c.edgeTarget(e));
+        edgeInfos.push_back(c.edgeInfoAt(e));
+    }
+
+    Compact rebuilt = Compact::fromArrays(c.vertices(), vertexInfos, offsets, targets, edgeInfos);
+
+    ASSERT_EQ(c.edges(), rebuilt.edges());
+    ASSERT_EQ("C", rebuilt.vertexInfo(30));
+
+    for (int i = 0; i < c.vertexCount(); ++i)
+    {
+        ASSERT_EQ(c.inEdgeBegin(i), rebuilt.inEdgeBegin(i));
+    }
+
+    BidirectionalSearchSpace space;
+    ShortestPath path = rebuilt.findShortestPathBidirectional(10, 40, identity, space);
+    ASSERT_EQ((std::vector<int>{10, 20, 30, 40}), path.vertices);
+
+    // out of order targets, or numbers that aren't ascending, don't fit
+    std::vector<int> swapped = targets;
+    std::swap(swapped[0], swapped[1]);
+
+    ASSERT_THROW(
+        (Compact::fromArrays(c.vertices(), vertexInfos, offsets, swapped, edgeInfos)),
+        DigraphException);
+    ASSERT_THROW(
+        (Compact::fromArrays({10, 30, 20, 40}, vertexInfos, offsets, targets, edgeInfos)),
+        DigraphException);
+    ASSERT_THROW(
+        (Compact::fromArrays(c.vertices(), vertexInfos, {0}, targets, edgeInfos)),
+        DigraphException);
+}
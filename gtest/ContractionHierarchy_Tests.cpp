@@ -0,0 +1,170 @@
+// ContractionHierarchy_Tests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for ContractionHierarchy.
+
+#include <random>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "ContractionHierarchy.hpp"
+#include "Digraph.hpp"
+
+
+namespace
+{
+    double identity(double edgeInfo)
+    {
+        return edgeInfo;
+    }
+
+
+    CompactDigraph<int, double> makeRandom(int vertexCount, int edgeCount, unsigned int seed)
+    {
+        std::mt19937 random{seed};
+        std::uniform_int_distribution<int> vertices{0, vertexCount - 1};
+        std::uniform_real_distribution<double> weights{0.0, 10.0};
+
+        Digraph<int, double> d;
+
+        for (int i = 0; i < vertexCount; ++i)
+        {
+            d.addVertex(i * 3, i);
+        }
+
+        for (int i = 0; i < edgeCount; ++i)
+        {
+            int from = vertices(random) * 3;
+            int to = vertices(random) * 3;
+
+            try
+            {
+                d.addEdge(from, to, weights(random));
+            }
+            catch (DigraphException&)
+            {
+                // duplicate edge; just skip it
+            }
+        }
+
+        return CompactDigraph<int, double>{d};
+    }
+
+
+    ContractionHierarchy contract(const CompactDigraph<int, double>& g)
+    {
+        return ContractionHierarchy::build(g, std::function<double(const double&)>{identity});
+    }
+}
+
+
+TEST(ContractionHierarchy_Tests, everyVertexGetsItsOwnRank)
+{
+    CompactDigraph<int, double> g = makeRandom(40, 120, 2);
+    ContractionHierarchy ch = contract(g);
+
+    ASSERT_EQ(40, ch.vertexCount());
+
+    std::vector<bool> seen(40, false);
+
+    for (int i = 0; i < 40; ++i)
+    {
+        ASSERT_GE(ch.rank(i), 0);
+        ASSERT_LT(ch.rank(i), 40);
+        ASSERT_FALSE(seen[ch.rank(i)]);
+        seen[ch.rank(i)] = true;
+    }
+}
+
+
+TEST(ContractionHierarchy_Tests, shortcutsAreNeededToSkipContractedVertices)
+{
+    // 1 -> 2 -> 3 has no other way around 2, so whichever of them is
+    // contracted first, a path from 1 to 3 must survive
+    Digraph<int, double> d;
+    d.addVertex(1, 1);
+    d.addVertex(2, 2);
+    d.addVertex(3, 3);
+    d.addEdge(1, 2, 1.5);
+    d.addEdge(2, 3, 2.5);
+
+    CompactDigraph<int, double> g{d};
+    ContractionHierarchy ch = contract(g);
+    ContractionHierarchySearch search;
+
+    ShortestPath path = ch.findShortestPath(g, 1, 3, search);
+
+    std::vector<int> expectedVertices{1, 2, 3};
+    std::vector<double> expectedWeights{1.5, 2.5};
+    ASSERT_EQ(expectedVertices, path.vertices);
+    ASSERT_EQ(expectedWeights, path.weights);
+    ASSERT_EQ(4.0, path.totalCost);
+}
+
+
+TEST(ContractionHierarchy_Tests, agreesWithDijkstraOnRandomGraphs)
+{
+    for (unsigned int seed = 1; seed <= 5; ++seed)
+    {
+        CompactDigraph<int, double> g = makeRandom(120, 420, seed);
+        ContractionHierarchy ch = contract(g);
+        ContractionHierarchySearch search;
+
+        for (int s = 0; s < g.vertexCount(); s += 11)
+        {
+            for (int t = 0; t < g.vertexCount(); t += 7)
+            {
+                int start = g.vertexNumber(s);
+                int end = g.vertexNumber(t);
+
+                ShortestPath expected = g.findShortestPath(start, end, identity);
+                ShortestPath actual = ch.findShortestPath(g, start, end, search);
+
+                ASSERT_EQ(expected.exists(), actual.exists());
+
+                if (!expected.exists())
+                {
+                    continue;
+                }
+
+                ASSERT_NEAR(expected.totalCost, actual.totalCost, 1e-9);
+
+                // the unpacked path is made of real edges, start to end
+                ASSERT_EQ(start, actual.vertices.front());
+                ASSERT_EQ(end, actual.vertices.back());
+                ASSERT_EQ(actual.vertices.size(), actual.weights.size() + 1);
+
+                for (std::size_t i = 0; i < actual.weights.size(); ++i)
+                {
+                    ASSERT_EQ(g.edgeInfo(actual.vertices[i], actual.vertices[i + 1]), actual.weights[i]);
+                }
+            }
+        }
+    }
+}
+
+
+TEST(ContractionHierarchy_Tests, pathFromVertexToItselfHasNoEdges)
+{
+    CompactDigraph<int, double> g = makeRandom(10, 30, 4);
+    ContractionHierarchy ch = contract(g);
+    ContractionHierarchySearch search;
+
+    ShortestPath path = ch.findShortestPath(g, 9, 9, search);
+
+    ASSERT_EQ(std::vector<int>{9}, path.vertices);
+    ASSERT_TRUE(path.weights.empty());
+    ASSERT_EQ(0.0, path.totalCost);
+}
+
+
+TEST(ContractionHierarchy_Tests, cannotSearchBetweenNonExistentVertices)
+{
+    CompactDigraph<int, double> g = makeRandom(10, 30, 4);
+    ContractionHierarchy ch = contract(g);
+    ContractionHierarchySearch search;
+
+    ASSERT_THROW({ ch.findShortestPath(g, 1, 3, search); }, DigraphException);
+    ASSERT_THROW({ ch.findShortestPath(g, 0, 4, search); }, DigraphException);
+}
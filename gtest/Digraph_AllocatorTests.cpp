@@ -0,0 +1,181 @@
+// Digraph_AllocatorTests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests checking that a Digraph allocates from the memory resource
+// it's given, and that copying and moving between Digraphs that use
+// different resources leaves both of them intact.
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+#include "DigraphArena.hpp"
+
+
+namespace
+{
+    // passes everything on to new and delete, counting as it goes
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        int allocations = 0;
+        int outstanding = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++allocations;
+            ++outstanding;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            --outstanding;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+
+    void addTriangle(Digraph<std::string, std::string>& d)
+    {
+        d.addVertex(1, "Example1");
+        d.addVertex(2, "Example2");
+        d.addVertex(3, "Example3");
+
+        d.addEdge(1, 2, "Edge1");
+        d.addEdge(1, 3, "Edge2");
+        d.addEdge(2, 3, "Edge3");
+        d.addEdge(3, 1, "Edge4");
+    }
+
+
+    std::vector<std::pair<int, int>> sorted(std::vector<std::pair<int, int>> edges)
+    {
+        std::sort(edges.begin(), edges.end());
+        return edges;
+    }
+}
+
+
+TEST(Digraph_AllocatorTests, verticesAndEdgesAreAllocatedFromTheGivenResource)
+{
+    CountingResource counter;
+
+    {
+        Digraph<std::string, std::string> d{&counter};
+        addTriangle(d);
+
+        ASSERT_EQ(&counter, d.resource());
+        ASSERT_GT(counter.allocations, 0);
+
+        d.removeVertex(3);
+        ASSERT_EQ(1, d.edgeCount());
+    }
+
+    ASSERT_EQ(0, counter.outstanding);
+}
+
+
+TEST(Digraph_AllocatorTests, graphsBuiltInAnArenaWorkTheSame)
+{
+    DigraphArena arena{256};
+    Digraph<std::string, std::string> d{&arena};
+    addTriangle(d);
+
+    ASSERT_EQ(3, d.vertexCount());
+    ASSERT_EQ("Edge3", d.edgeInfo(2, 3));
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{1, 3}, {2, 3}}), sorted(d.incomingEdges(3)));
+
+    d.removeEdge(1, 3);
+    d.removeVertex(2);
+    d.addVertex(4, "Example4");
+    d.addEdge(3, 4, "Edge5");
+
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{3, 1}, {3, 4}}), sorted(d.edges()));
+    ASSERT_TRUE(d.incomingEdges(3).empty());
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{3, 4}}), d.incomingEdges(4));
+}
+
+
+TEST(Digraph_AllocatorTests, fromEdgeListBuildsInTheGivenResource)
+{
+    CountingResource counter;
+
+    Digraph<std::string, int> d = Digraph<std::string, int>::fromEdgeList(
+        {{1, "one"}, {2, "two"}},
+        {{1, 2, 12}, {2, 1, 21}},
+        &counter);
+
+    ASSERT_EQ(&counter, d.resource());
+    ASSERT_GT(counter.allocations, 0);
+    ASSERT_EQ(21, d.edgeInfo(2, 1));
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{2, 1}}), d.incomingEdges(1));
+}
+
+
+TEST(Digraph_AllocatorTests, copiesOfArenaGraphsUseTheirOwnResource)
+{
+    DigraphArena arena;
+    Digraph<std::string, std::string> d{&arena};
+    addTriangle(d);
+
+    Digraph<std::string, std::string> copy{d};
+    ASSERT_EQ(std::pmr::get_default_resource(), copy.resource());
+
+    CountingResource counter;
+    Digraph<std::string, std::string> counted{d, &counter};
+    ASSERT_EQ(&counter, counted.resource());
+    ASSERT_GT(counter.allocations, 0);
+
+    d.removeVertex(1);
+
+    ASSERT_EQ(4, copy.edgeCount());
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{1, 3}, {2, 3}}), sorted(counted.incomingEdges(3)));
+}
+
+
+TEST(Digraph_AllocatorTests, movingBetweenResourcesKeepsEverythingFindable)
+{
+    DigraphArena arena;
+    Digraph<std::string, std::string> d{&arena};
+    addTriangle(d);
+
+    Digraph<std::string, std::string> target;
+    target.addVertex(9, "Gone");
+    target = std::move(d);
+
+    ASSERT_EQ(std::pmr::get_default_resource(), target.resource());
+    ASSERT_EQ(3, target.vertexCount());
+    ASSERT_EQ("Edge4", target.edgeInfo(3, 1));
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{1, 3}, {2, 3}}), sorted(target.incomingEdges(3)));
+
+    // removing still finds every edge through the rebuilt lookups
+    target.removeVertex(3);
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{1, 2}}), target.edges());
+    ASSERT_TRUE(target.incomingEdges(1).empty());
+}
+
+
+TEST(Digraph_AllocatorTests, movingConstructsInTheSameResource)
+{
+    DigraphArena arena;
+    Digraph<std::string, std::string> d{&arena};
+    addTriangle(d);
+
+    Digraph<std::string, std::string> moved{std::move(d)};
+
+    ASSERT_EQ(&arena, moved.resource());
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{3, 1}}), moved.incomingEdges(1));
+}
@@ -0,0 +1,271 @@
+// Digraph_ConcurrencyTests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for WorkerPool and runOrderedPipeline(), and for the promise
+// that the const member functions of Digraph and CompactDigraph can be
+// called from several threads at once, as long as nothing modifies the
+// graph meanwhile and each thread searches in its own ShortestPathTree.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "OrderedPipeline.hpp"
+#include "WorkerPool.hpp"
+
+
+namespace
+{
+    double identity(double edgeInfo)
+    {
+        return edgeInfo;
+    }
+
+
+    Digraph<int, double> makeRandom(int vertexCount, int edgeCount, unsigned int seed)
+    {
+        std::mt19937 random{seed};
+        std::uniform_int_distribution<int> vertices{0, vertexCount - 1};
+        std::uniform_real_distribution<double> weights{0.0, 10.0};
+
+        Digraph<int, double> d;
+
+        for (int i = 0; i < vertexCount; ++i)
+        {
+            d.addVertex(i * 3, i);
+        }
+
+        for (int i = 0; i < edgeCount; ++i)
+        {
+            int from = vertices(random) * 3;
+            int to = vertices(random) * 3;
+
+            try
+            {
+                d.addEdge(from, to, weights(random));
+            }
+            catch (DigraphException&)
+            {
+                // duplicate edge; just skip it
+            }
+        }
+
+        return d;
+    }
+
+
+    // runs every query once on one thread and then again on several, and
+    // checks that every answer came out the same both times
+    template <typename Graph>
+    void expectSameAnswersConcurrently(const Graph& g, int vertexCount)
+    {
+        std::vector<double> expected(vertexCount * vertexCount);
+
+        for (int s = 0; s < vertexCount; ++s)
+        {
+            for (int t = 0; t < vertexCount; ++t)
+            {
+                expected[s * vertexCount + t] = g.findShortestPath(s * 3, t * 3, identity).totalCost;
+            }
+        }
+
+        WorkerPool pool{4};
+        std::vector<ShortestPathTree> trees(pool.workerCount());
+        std::vector<double> actual(vertexCount * vertexCount);
+
+        pool.run(
+            vertexCount * vertexCount,
+            [&](int task, int worker)
+            {
+                int s = task / vertexCount;
+                int t = task % vertexCount;
+
+                actual[task] = g.findShortestPath(s * 3, t * 3, identity, trees[worker]).totalCost;
+
+                // other const queries, mixed in with the searches
+                g.vertexInfo(t * 3);
+                g.edges(s * 3);
+                g.edgeCount(s * 3);
+            });
+
+        ASSERT_EQ(expected, actual);
+    }
+}
+
+
+TEST(Digraph_ConcurrencyTests, workerPoolRunsEveryTaskExactlyOnce)
+{
+    WorkerPool pool{3};
+    ASSERT_EQ(3, pool.workerCount());
+
+    for (int batch = 0; batch < 5; ++batch)
+    {
+        std::vector<std::atomic<int>> runs(1000);
+
+        pool.run(
+            1000,
+            [&runs](int task, int worker)
+            {
+                ASSERT_GE(worker, 0);
+                ASSERT_LT(worker, 3);
+                ++runs[task];
+            });
+
+        for (const std::atomic<int>& count : runs)
+        {
+            ASSERT_EQ(1, count.load());
+        }
+    }
+}
+
+
+TEST(Digraph_ConcurrencyTests, workerPoolWithOneWorkerRunsTasksInOrder)
+{
+    WorkerPool pool{1};
+    std::vector<int> order;
+
+    pool.run(
+        10,
+        [&order](int task, int worker)
+        {
+            order.push_back(task);
+        });
+
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), order);
+}
+
+
+TEST(Digraph_ConcurrencyTests, workerPoolPassesOnTheFirstException)
+{
+    WorkerPool pool{2};
+
+    ASSERT_THROW(
+        {
+            pool.run(
+                100,
+                [](int task, int worker)
+                {
+                    if (task == 42)
+                    {
+                        throw std::runtime_error{"task failed"};
+                    }
+                });
+        },
+        std::runtime_error);
+
+    // and it still works afterward
+    std::atomic<int> count{0};
+    pool.run(10, [&count](int task, int worker) { ++count; });
+    ASSERT_EQ(10, count.load());
+}
+
+
+TEST(Digraph_ConcurrencyTests, orderedPipelineConsumesResultsInOrder)
+{
+    WorkerPool pool{4};
+    std::atomic<int> inFlight{0};
+    int mostInFlight = 0;
+    int next = 0;
+    std::vector<int> consumed;
+
+    runOrderedPipeline<int, int>(
+        pool, 8,
+        [&](int& job)
+        {
+            if (next == 500)
+            {
+                return false;
+            }
+
+            job = next++;
+            mostInFlight = std::max(mostInFlight, ++inFlight);
+            return true;
+        },
+        [](int job, int)
+        {
+            // later jobs often finish first
+            std::this_thread::sleep_for(std::chrono::microseconds((job * 7919) % 50));
+            return job * 2;
+        },
+        [&](int result)
+        {
+            consumed.push_back(result);
+            --inFlight;
+        });
+
+    ASSERT_EQ(500, consumed.size());
+
+    for (int i = 0; i < 500; ++i)
+    {
+        ASSERT_EQ(i * 2, consumed[i]);
+    }
+
+    ASSERT_LE(mostInFlight, 8);
+}
+
+
+TEST(Digraph_ConcurrencyTests, orderedPipelinePassesOnExceptions)
+{
+    WorkerPool pool{3};
+    int next = 0;
+
+    ASSERT_THROW(
+        (runOrderedPipeline<int, int>(
+            pool, 4,
+            [&](int& job)
+            {
+                job = next++;
+                return true;
+            },
+            [](int job, int)
+            {
+                if (job == 37)
+                {
+                    throw std::runtime_error{"37"};
+                }
+
+                return job;
+            },
+            [](int)
+            {
+            })),
+        std::runtime_error);
+
+    ASSERT_THROW(
+        (runOrderedPipeline<int, int>(
+            pool, 4,
+            [](int&) -> bool
+            {
+                throw std::runtime_error{"no input"};
+            },
+            [](int job, int)
+            {
+                return job;
+            },
+            [](int)
+            {
+            })),
+        std::runtime_error);
+}
+
+
+TEST(Digraph_ConcurrencyTests, digraphAnswersConcurrentReadersCorrectly)
+{
+    Digraph<int, double> d = makeRandom(40, 200, 12);
+    expectSameAnswersConcurrently(d, 40);
+}
+
+
+TEST(Digraph_ConcurrencyTests, compactDigraphAnswersConcurrentReadersCorrectly)
+{
+    CompactDigraph<int, double> c{makeRandom(40, 200, 13)};
+    expectSameAnswersConcurrently(c, 40);
+}
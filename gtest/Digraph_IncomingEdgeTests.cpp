@@ -0,0 +1,105 @@
+// Digraph_IncomingEdgeTests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests checking that Digraph's reverse index of incoming edges stays
+// in sync as edges and vertices come and go.
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+
+
+namespace
+{
+    Digraph<std::string, std::string> makeTriangle()
+    {
+        Digraph<std::string, std::string> d;
+        d.addVertex(1, "Example1");
+        d.addVertex(2, "Example2");
+        d.addVertex(3, "Example3");
+
+        d.addEdge(1, 2, "Edge1");
+        d.addEdge(1, 3, "Edge2");
+        d.addEdge(2, 3, "Edge3");
+        d.addEdge(3, 3, "Loop");
+
+        return d;
+    }
+
+
+    std::vector<std::pair<int, int>> sorted(std::vector<std::pair<int, int>> edges)
+    {
+        std::sort(edges.begin(), edges.end());
+        return edges;
+    }
+}
+
+
+TEST(Digraph_IncomingEdgeTests, canGetIncomingEdgesForOneVertex)
+{
+    Digraph<std::string, std::string> d = makeTriangle();
+
+    ASSERT_TRUE(d.incomingEdges(1).empty());
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{1, 2}}), d.incomingEdges(2));
+    ASSERT_EQ(
+        (std::vector<std::pair<int, int>>{{1, 3}, {2, 3}, {3, 3}}),
+        sorted(d.incomingEdges(3)));
+}
+
+
+TEST(Digraph_IncomingEdgeTests, cannotGetIncomingEdgesForNonExistentVertex)
+{
+    Digraph<std::string, std::string> d = makeTriangle();
+
+    ASSERT_THROW({ d.incomingEdges(4); }, DigraphException);
+}
+
+
+TEST(Digraph_IncomingEdgeTests, removingEdgeRemovesItFromIncomingEdges)
+{
+    Digraph<std::string, std::string> d = makeTriangle();
+
+    d.removeEdge(1, 3);
+
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{2, 3}, {3, 3}}), sorted(d.incomingEdges(3)));
+    ASSERT_THROW({ d.removeEdge(1, 3); }, DigraphException);
+}
+
+
+TEST(Digraph_IncomingEdgeTests, removingVertexRemovesAllOfItsEdges)
+{
+    Digraph<std::string, std::string> d = makeTriangle();
+
+    d.removeVertex(3);
+
+    ASSERT_EQ(1, d.edgeCount());
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{1, 2}}), d.edges());
+    ASSERT_THROW({ d.edgeInfo(2, 3); }, DigraphException);
+
+    d.removeVertex(1);
+
+    ASSERT_EQ(0, d.edgeCount());
+    ASSERT_TRUE(d.incomingEdges(2).empty());
+}
+
+
+TEST(Digraph_IncomingEdgeTests, copiesHaveTheirOwnIncomingEdges)
+{
+    Digraph<std::string, std::string> d = makeTriangle();
+    Digraph<std::string, std::string> copy;
+    copy = d;
+
+    d.removeVertex(1);
+    d.removeVertex(2);
+
+    ASSERT_EQ(3, sorted(copy.incomingEdges(3)).size());
+    ASSERT_EQ("Edge2", copy.edgeInfo(1, 3));
+
+    copy.removeEdge(2, 3);
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{1, 3}, {3, 3}}), sorted(copy.incomingEdges(3)));
+}
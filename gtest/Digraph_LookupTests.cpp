@@ -0,0 +1,211 @@
+// Digraph_LookupTests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests checking that Digraph's vertex and edge lookups stay in sync
+// as vertices and edges come and go, as Digraphs are copied and moved, and
+// when Digraphs are built all at once from edge lists.
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+
+
+namespace
+{
+    Digraph<std::string, std::string> makeSquare()
+    {
+        Digraph<std::string, std::string> d;
+        d.addVertex(10, "A");
+        d.addVertex(-20, "B");
+        d.addVertex(30, "C");
+        d.addVertex(40, "D");
+
+        d.addEdge(10, -20, "AB");
+        d.addEdge(-20, 30, "BC");
+        d.addEdge(30, 40, "CD");
+        d.addEdge(40, 10, "DA");
+        d.addEdge(10, 30, "AC");
+        d.addEdge(30, 30, "CC");
+
+        return d;
+    }
+}
+
+
+TEST(Digraph_LookupTests, edgeInfoTellsReversedEdgesApart)
+{
+    Digraph<std::string, std::string> d = makeSquare();
+    d.addEdge(-20, 10, "BA");
+
+    ASSERT_EQ("AB", d.edgeInfo(10, -20));
+    ASSERT_EQ("BA", d.edgeInfo(-20, 10));
+    ASSERT_THROW({ d.edgeInfo(30, 10); }, DigraphException);
+}
+
+
+TEST(Digraph_LookupTests, removedEdgesCanBeAddedAgain)
+{
+    Digraph<std::string, std::string> d = makeSquare();
+
+    d.removeEdge(10, 30);
+    ASSERT_THROW({ d.edgeInfo(10, 30); }, DigraphException);
+    ASSERT_THROW({ d.removeEdge(10, 30); }, DigraphException);
+    ASSERT_EQ(5, d.edgeCount());
+
+    d.addEdge(10, 30, "AC again");
+    ASSERT_EQ("AC again", d.edgeInfo(10, 30));
+    ASSERT_EQ(6, d.edgeCount());
+    ASSERT_THROW({ d.addEdge(10, 30, "AC thrice"); }, DigraphException);
+}
+
+
+TEST(Digraph_LookupTests, removingVertexForgetsItsEdgesBothWays)
+{
+    Digraph<std::string, std::string> d = makeSquare();
+
+    d.removeVertex(30);
+    ASSERT_EQ(2, d.edgeCount());
+    ASSERT_EQ(1, d.edgeCount(10));
+    ASSERT_EQ(0, d.edgeCount(-20));
+
+    // a new vertex with the same number starts out with no edges
+    d.addVertex(30, "C again");
+    ASSERT_EQ("C again", d.vertexInfo(30));
+    ASSERT_THROW({ d.edgeInfo(10, 30); }, DigraphException);
+    ASSERT_THROW({ d.edgeInfo(30, 30); }, DigraphException);
+
+    d.addEdge(-20, 30, "BC again");
+    ASSERT_EQ("BC again", d.edgeInfo(-20, 30));
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{-20, 30}}), d.edges(-20));
+}
+
+
+TEST(Digraph_LookupTests, copiesHaveTheirOwnLookups)
+{
+    Digraph<std::string, std::string> d = makeSquare();
+    Digraph<std::string, std::string> copy{d};
+
+    d.removeEdge(10, -20);
+    d.removeVertex(40);
+
+    ASSERT_EQ("AB", copy.edgeInfo(10, -20));
+    ASSERT_EQ("D", copy.vertexInfo(40));
+    ASSERT_EQ(6, copy.edgeCount());
+
+    copy.removeEdge(30, 40);
+    ASSERT_EQ(5, copy.edgeCount());
+    ASSERT_EQ(3, d.edgeCount());
+}
+
+
+TEST(Digraph_LookupTests, movedDigraphsKeepTheirLookups)
+{
+    Digraph<std::string, std::string> d = makeSquare();
+    Digraph<std::string, std::string> moved{std::move(d)};
+
+    ASSERT_EQ("CD", moved.edgeInfo(30, 40));
+
+    moved.removeEdge(30, 40);
+    ASSERT_THROW({ moved.edgeInfo(30, 40); }, DigraphException);
+    ASSERT_EQ(1, moved.edgeCount(30));
+    ASSERT_EQ(5, moved.edgeCount());
+}
+
+
+TEST(Digraph_LookupTests, edgeListBuildsTheSameDigraphAsAddingOneAtATime)
+{
+    Digraph<std::string, std::string> d = Digraph<std::string, std::string>::fromEdgeList(
+        {{40, "D"}, {10, "A"}, {30, "C"}, {-20, "B"}},
+        {{10, -20, "AB"}, {-20, 30, "BC"}, {30, 40, "CD"}, {40, 10, "DA"}, {10, 30, "AC"}, {30, 30, "CC"}});
+
+    Digraph<std::string, std::string> expected = makeSquare();
+
+    ASSERT_EQ(expected.vertices(), d.vertices());
+    ASSERT_EQ(expected.edges(), d.edges());
+    ASSERT_EQ(expected.incomingEdges(30).size(), d.incomingEdges(30).size());
+    ASSERT_EQ("AC", d.edgeInfo(10, 30));
+    ASSERT_EQ("D", d.vertexInfo(40));
+
+    // indices follow vertex numbers
+    ASSERT_EQ(0, d.indexOf(-20));
+    ASSERT_EQ(3, d.indexOf(40));
+
+    // and it's an ordinary Digraph from then on
+    d.removeVertex(30);
+    d.addEdge(-20, 40, "BD");
+    ASSERT_EQ(3, d.edgeCount());
+}
+
+
+TEST(Digraph_LookupTests, edgeListReportsEveryProblemAtOnce)
+{
+    try
+    {
+        Digraph<std::string, std::string>::fromEdgeList(
+            {{1, "A"}, {2, "B"}, {2, "B again"}},
+            {{1, 2, "AB"}, {2, 1, "BA"}, {1, 2, "AB again"}, {1, 3, "AC"}});
+
+        FAIL() << "expected a DigraphException";
+    }
+    catch (DigraphException& e)
+    {
+        std::string reason = e.what();
+        ASSERT_NE(std::string::npos, reason.find("vertex 2 is listed more than once"));
+        ASSERT_NE(std::string::npos, reason.find("edge 1 -> 2 is listed more than once"));
+        ASSERT_NE(std::string::npos, reason.find("edge 1 -> 3 has a vertex that isn't listed"));
+    }
+}
+
+
+TEST(Digraph_LookupTests, tryVertexInfoAndFindEdgeReturnNullInsteadOfThrowing)
+{
+    Digraph<std::string, std::string> d = makeSquare();
+
+    ASSERT_EQ(&d.vertexInfo(-20), d.tryVertexInfo(-20));
+    ASSERT_EQ(nullptr, d.tryVertexInfo(20));
+
+    ASSERT_EQ(&d.edgeInfo(30, 30), d.findEdge(30, 30));
+    ASSERT_EQ(nullptr, d.findEdge(30, 10));
+    ASSERT_EQ(nullptr, d.findEdge(10, 99));
+
+    d.removeEdge(10, 30);
+    ASSERT_EQ(nullptr, d.findEdge(10, 30));
+}
+
+
+TEST(Digraph_LookupTests, emplacingConstructsInfosFromArguments)
+{
+    Digraph<std::string, std::string> d;
+    d.emplaceVertex(1, 3, 'x');
+    d.emplaceVertex(2, "B");
+    d.emplaceEdge(1, 2, "ABCD", 2);
+
+    ASSERT_EQ("xxx", d.vertexInfo(1));
+    ASSERT_EQ("AB", d.edgeInfo(1, 2));
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{1, 2}}), d.incomingEdges(2));
+
+    ASSERT_THROW({ d.emplaceVertex(2, "B again"); }, DigraphException);
+    ASSERT_THROW({ d.emplaceEdge(1, 2, "AB again"); }, DigraphException);
+    ASSERT_THROW({ d.emplaceEdge(1, 3, "AC"); }, DigraphException);
+    ASSERT_EQ("B", d.vertexInfo(2));
+}
+
+
+TEST(Digraph_LookupTests, rvaluesAreMovedIn)
+{
+    Digraph<std::unique_ptr<int>, std::unique_ptr<int>> d;
+    d.addVertex(1, std::make_unique<int>(1));
+    d.addVertex(2, std::make_unique<int>(2));
+
+    std::unique_ptr<int> weight = std::make_unique<int>(12);
+    int* raw = weight.get();
+    d.addEdge(1, 2, std::move(weight));
+
+    ASSERT_EQ(2, *d.vertexInfo(2));
+    ASSERT_EQ(raw, d.edgeInfo(1, 2).get());
+}
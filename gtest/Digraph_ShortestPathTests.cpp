@@ -0,0 +1,332 @@
+// Digraph_ShortestPathTests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for the shortest path searches that Digraph provides, beyond
+// the single case in the sanity checks.
+
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+#include "CompactDigraph.hpp"
+
+
+namespace
+{
+    Digraph<std::string, double> makeDiamond()
+    {
+        Digraph<std::string, double> d;
+        d.addVertex(10, "A");
+        d.addVertex(20, "B");
+        d.addVertex(30, "C");
+        d.addVertex(40, "D");
+
+        d.addEdge(10, 20, 1.0);
+        d.addEdge(10, 30, 4.0);
+        d.addEdge(20, 30, 1.0);
+        d.addEdge(30, 40, 1.0);
+        d.addEdge(20, 40, 5.0);
+
+        return d;
+    }
+
+
+    double identity(double edgeInfo)
+    {
+        return edgeInfo;
+    }
+
+
+    Digraph<int, double> makeRandom(int vertexCount, int edgeCount, unsigned int seed)
+    {
+        std::mt19937 random{seed};
+        std::uniform_int_distribution<int> vertices{0, vertexCount - 1};
+        std::uniform_real_distribution<double> weights{0.0, 10.0};
+
+        Digraph<int, double> d;
+
+        for (int i = 0; i < vertexCount; ++i)
+        {
+            d.addVertex(i * 3, i);
+        }
+
+        for (int i = 0; i < edgeCount; ++i)
+        {
+            int from = vertices(random) * 3;
+            int to = vertices(random) * 3;
+
+            try
+            {
+                d.addEdge(from, to, weights(random));
+            }
+            catch (DigraphException&)
+            {
+                // duplicate edge; just skip it
+            }
+        }
+
+        return d;
+    }
+}
+
+
+TEST(Digraph_ShortestPathTests, prefersCheaperDetoursOverDirectEdges)
+{
+    Digraph<std::string, double> d = makeDiamond();
+
+    std::map<int, int> paths = d.findShortestPaths(10, identity);
+
+    ASSERT_EQ(4, paths.size());
+    ASSERT_EQ(10, paths[10]);
+    ASSERT_EQ(10, paths[20]);
+    ASSERT_EQ(20, paths[30]);
+    ASSERT_EQ(30, paths[40]);
+}
+
+
+TEST(Digraph_ShortestPathTests, unreachableVerticesAreTheirOwnPredecessors)
+{
+    Digraph<std::string, double> d = makeDiamond();
+
+    std::map<int, int> paths = d.findShortestPaths(30, identity);
+
+    ASSERT_EQ(10, paths[10]);
+    ASSERT_EQ(20, paths[20]);
+    ASSERT_EQ(30, paths[40]);
+}
+
+
+TEST(Digraph_ShortestPathTests, denseTreeHoldsDistancesAndPredecessors)
+{
+    Digraph<std::string, double> d = makeDiamond();
+    ShortestPathTree tree;
+
+    d.findShortestPaths(10, identity, tree);
+
+    ASSERT_EQ(d.indexOf(10), tree.source);
+    ASSERT_EQ(0.0, tree.distance[d.indexOf(10)]);
+    ASSERT_EQ(2.0, tree.distance[d.indexOf(30)]);
+    ASSERT_EQ(3.0, tree.distance[d.indexOf(40)]);
+    ASSERT_EQ(-1, tree.predecessor[d.indexOf(10)]);
+    ASSERT_EQ(30, d.vertexNumber(tree.predecessor[d.indexOf(40)]));
+
+    // searching again with the same tree replaces the old result
+    d.findShortestPaths(30, identity, tree);
+
+    ASSERT_FALSE(tree.reached(d.indexOf(10)));
+    ASSERT_EQ(1.0, tree.distance[d.indexOf(40)]);
+}
+
+
+TEST(Digraph_ShortestPathTests, indicesSurviveCopiesAndAreReusedAfterRemoval)
+{
+    Digraph<std::string, double> d = makeDiamond();
+    int removedIndex = d.indexOf(20);
+
+    d.removeVertex(20);
+    d.addVertex(50, "E");
+    d.addEdge(10, 50, 0.5);
+    d.addEdge(50, 40, 0.5);
+
+    ASSERT_EQ(removedIndex, d.indexOf(50));
+    ASSERT_EQ(4, d.indexBound());
+
+    Digraph<std::string, double> copy{d};
+    d.removeEdge(50, 40);
+
+    std::map<int, int> paths = copy.findShortestPaths(10, identity);
+    ASSERT_EQ(50, paths[40]);
+    ASSERT_EQ(50, copy.vertexNumber(copy.indexOf(50)));
+}
+
+
+TEST(Digraph_ShortestPathTests, cannotSearchFromNonExistentVertex)
+{
+    Digraph<std::string, double> d = makeDiamond();
+
+    ASSERT_THROW({ d.findShortestPaths(99, identity); }, DigraphException);
+}
+
+
+TEST(Digraph_ShortestPathTests, canFindOnePathWithItsEdgeWeights)
+{
+    Digraph<std::string, double> d = makeDiamond();
+
+    ShortestPath path = d.findShortestPath(10, 40, identity);
+
+    ASSERT_TRUE(path.exists());
+    ASSERT_EQ((std::vector<int>{10, 20, 30, 40}), path.vertices);
+    ASSERT_EQ((std::vector<double>{1.0, 1.0, 1.0}), path.weights);
+    ASSERT_EQ(3.0, path.totalCost);
+}
+
+
+TEST(Digraph_ShortestPathTests, pathFromVertexToItselfHasNoEdges)
+{
+    Digraph<std::string, double> d = makeDiamond();
+
+    ShortestPath path = d.findShortestPath(30, 30, identity);
+
+    ASSERT_EQ(std::vector<int>{30}, path.vertices);
+    ASSERT_TRUE(path.weights.empty());
+    ASSERT_EQ(0.0, path.totalCost);
+}
+
+
+TEST(Digraph_ShortestPathTests, noPathExistsToUnreachableVertex)
+{
+    Digraph<std::string, double> d = makeDiamond();
+
+    ShortestPath path = d.findShortestPath(40, 10, identity);
+
+    ASSERT_FALSE(path.exists());
+    ASSERT_TRUE(path.weights.empty());
+}
+
+
+TEST(Digraph_ShortestPathTests, searchStopsOnceTargetIsSettled)
+{
+    Digraph<std::string, double> d;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        d.addVertex(i, "");
+
+        if (i > 0)
+        {
+            d.addEdge(i - 1, i, 1.0);
+        }
+    }
+
+    ShortestPathTree tree;
+    d.findShortestPath(0, 5, identity, tree);
+
+    // the target's own edges are never followed
+    ASSERT_TRUE(tree.reached(d.indexOf(5)));
+    ASSERT_FALSE(tree.reached(d.indexOf(6)));
+}
+
+
+TEST(Digraph_ShortestPathTests, bidirectionalSearchFindsTheSamePath)
+{
+    Digraph<std::string, double> d = makeDiamond();
+
+    ShortestPath path = d.findShortestPathBidirectional(10, 40, identity);
+
+    ASSERT_EQ((std::vector<int>{10, 20, 30, 40}), path.vertices);
+    ASSERT_EQ((std::vector<double>{1.0, 1.0, 1.0}), path.weights);
+    ASSERT_EQ(3.0, path.totalCost);
+
+    ASSERT_FALSE(d.findShortestPathBidirectional(40, 10, identity).exists());
+    ASSERT_EQ(std::vector<int>{20}, d.findShortestPathBidirectional(20, 20, identity).vertices);
+}
+
+
+TEST(Digraph_ShortestPathTests, bidirectionalSearchAgreesOnRandomGraphs)
+{
+    for (unsigned int seed = 1; seed <= 5; ++seed)
+    {
+        Digraph<int, double> d = makeRandom(60, 180, seed);
+        CompactDigraph<int, double> c{d};
+        BidirectionalSearchSpace space;
+
+        // removing a vertex exercises keeping the reverse index in sync
+        d.removeVertex(30);
+        CompactDigraph<int, double> after{d};
+
+        for (int start = 0; start < 60 * 3; start += 21)
+        {
+            for (int end = 0; end < 60 * 3; end += 12)
+            {
+                ShortestPath expected = c.findShortestPath(start, end, identity);
+                ShortestPath actual = c.findShortestPathBidirectional(start, end, identity, space);
+
+                ASSERT_EQ(expected.exists(), actual.exists());
+
+                if (expected.exists())
+                {
+                    ASSERT_NEAR(expected.totalCost, actual.totalCost, 1e-9);
+                }
+
+                if (start == 30 || end == 30)
+                {
+                    continue;
+                }
+
+                expected = after.findShortestPath(start, end, identity);
+                actual = d.findShortestPathBidirectional(start, end, identity, space);
+
+                ASSERT_EQ(expected.exists(), actual.exists());
+
+                if (expected.exists())
+                {
+                    ASSERT_NEAR(expected.totalCost, actual.totalCost, 1e-9);
+                }
+            }
+        }
+    }
+}
+
+
+TEST(Digraph_ShortestPathTests, aStarWithGridDistanceEstimateFindsShortestPath)
+{
+    // a 10x10 grid with edges in both directions; vertex number = 10y + x
+    Digraph<int, double> d;
+
+    for (int v = 0; v < 100; ++v)
+    {
+        d.addVertex(v, v);
+    }
+
+    for (int v = 0; v < 100; ++v)
+    {
+        if (v % 10 != 9)
+        {
+            d.addEdge(v, v + 1, 1.0 + (v % 3));
+            d.addEdge(v + 1, v, 1.0 + (v % 3));
+        }
+
+        if (v < 90)
+        {
+            d.addEdge(v, v + 10, 1.0 + (v % 4));
+            d.addEdge(v + 10, v, 1.0 + (v % 4));
+        }
+    }
+
+    // every edge weighs at least 1, so grid distance is a lower bound
+    auto estimate =
+        [&d](int index)
+        {
+            int v = d.vertexNumber(index);
+            return static_cast<double>(std::abs(v % 10 - 7) + std::abs(v / 10 - 8));
+        };
+
+    ShortestPathTree tree;
+    ShortestPath expected = d.findShortestPath(3, 87, identity);
+    ShortestPath actual = d.findShortestPathAStar(3, 87, identity, estimate, tree);
+
+    ASSERT_EQ(expected.totalCost, actual.totalCost);
+    ASSERT_EQ(expected.weights.size(), actual.weights.size());
+    ASSERT_EQ(3, actual.vertices.front());
+    ASSERT_EQ(87, actual.vertices.back());
+
+    // and with no estimate at all, A* is just Dijkstra
+    ASSERT_EQ(
+        expected.vertices,
+        d.findShortestPathAStar(3, 87, identity, [](int) { return 0.0; }).vertices);
+}
+
+
+TEST(Digraph_ShortestPathTests, aStarReportsWhenThereIsNoPath)
+{
+    Digraph<std::string, double> d = makeDiamond();
+
+    ShortestPath path = d.findShortestPathAStar(40, 10, identity, [](int) { return 0.0; });
+
+    ASSERT_FALSE(path.exists());
+}
@@ -0,0 +1,113 @@
+// IndexedDaryHeap_Tests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for IndexedDaryHeap.
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "IndexedDaryHeap.hpp"
+
+
+TEST(IndexedDaryHeap_Tests, popsIdsInPriorityOrder)
+{
+    IndexedDaryHeap<double> heap{5};
+    heap.push(0, 3.0);
+    heap.push(1, 1.0);
+    heap.push(2, 4.0);
+    heap.push(3, 0.5);
+    heap.push(4, 2.0);
+
+    ASSERT_EQ(5, heap.size());
+    ASSERT_EQ(3, heap.pop());
+    ASSERT_EQ(1, heap.pop());
+    ASSERT_EQ(4, heap.pop());
+    ASSERT_EQ(0, heap.pop());
+    ASSERT_EQ(2, heap.pop());
+    ASSERT_TRUE(heap.empty());
+}
+
+
+TEST(IndexedDaryHeap_Tests, decreaseKeyMovesIdForward)
+{
+    IndexedDaryHeap<double> heap{3};
+    heap.push(0, 1.0);
+    heap.push(1, 2.0);
+    heap.push(2, 3.0);
+
+    heap.decreaseKey(2, 0.0);
+
+    ASSERT_EQ(2, heap.top());
+    ASSERT_EQ(0.0, heap.topPriority());
+    ASSERT_EQ(2.0, heap.priority(1));
+}
+
+
+TEST(IndexedDaryHeap_Tests, pushOrDecreaseOnlyEverLowersPriority)
+{
+    IndexedDaryHeap<double> heap{2};
+
+    ASSERT_TRUE(heap.pushOrDecrease(0, 5.0));
+    ASSERT_FALSE(heap.pushOrDecrease(0, 6.0));
+    ASSERT_TRUE(heap.pushOrDecrease(0, 4.0));
+    ASSERT_EQ(1, heap.size());
+    ASSERT_EQ(4.0, heap.priority(0));
+}
+
+
+TEST(IndexedDaryHeap_Tests, clearAndResetForgetEveryId)
+{
+    IndexedDaryHeap<double> heap{4};
+    heap.push(1, 1.0);
+    heap.push(3, 1.0);
+
+    heap.clear();
+    ASSERT_TRUE(heap.empty());
+    ASSERT_FALSE(heap.contains(1));
+    ASSERT_FALSE(heap.contains(3));
+
+    heap.push(3, 2.0);
+    heap.reset(8);
+    ASSERT_EQ(8, heap.capacity());
+    ASSERT_FALSE(heap.contains(3));
+}
+
+
+TEST(IndexedDaryHeap_Tests, agreesWithSortingUnderRandomDecreases)
+{
+    std::mt19937 random{46};
+    std::uniform_real_distribution<double> priorities{0.0, 1000.0};
+
+    const int count = 500;
+    IndexedDaryHeap<double, 3> heap{count};
+    std::vector<double> expected(count);
+
+    for (int id = 0; id < count; ++id)
+    {
+        expected[id] = priorities(random);
+        heap.push(id, expected[id]);
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        int id = random() % count;
+        expected[id] /= 2.0;
+        heap.decreaseKey(id, expected[id]);
+    }
+
+    std::vector<double> popped;
+
+    while (!heap.empty())
+    {
+        popped.push_back(heap.topPriority());
+        ASSERT_EQ(expected[heap.top()], heap.topPriority());
+        heap.pop();
+    }
+
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, popped);
+}
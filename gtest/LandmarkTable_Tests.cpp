@@ -0,0 +1,161 @@
+// LandmarkTable_Tests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for LandmarkTable and the ALT searches it makes possible.
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "LandmarkTable.hpp"
+
+
+namespace
+{
+    double identity(double edgeInfo)
+    {
+        return edgeInfo;
+    }
+
+
+    CompactDigraph<int, double> makeRandom(int vertexCount, int edgeCount, unsigned int seed)
+    {
+        std::mt19937 random{seed};
+        std::uniform_int_distribution<int> vertices{0, vertexCount - 1};
+        std::uniform_real_distribution<double> weights{0.0, 10.0};
+
+        Digraph<int, double> d;
+
+        for (int i = 0; i < vertexCount; ++i)
+        {
+            d.addVertex(i * 3, i);
+        }
+
+        for (int i = 0; i < edgeCount; ++i)
+        {
+            int from = vertices(random) * 3;
+            int to = vertices(random) * 3;
+
+            try
+            {
+                d.addEdge(from, to, weights(random));
+            }
+            catch (DigraphException&)
+            {
+                // duplicate edge; just skip it
+            }
+        }
+
+        return CompactDigraph<int, double>{d};
+    }
+}
+
+
+TEST(LandmarkTable_Tests, emptyTableEstimatesZero)
+{
+    LandmarkTable table;
+    ASSERT_EQ(0, table.landmarkCount());
+    ASSERT_EQ(0.0, table.estimateTo(3)(5));
+}
+
+
+TEST(LandmarkTable_Tests, choosesDistinctLandmarksUpToVertexCount)
+{
+    CompactDigraph<int, double> g = makeRandom(5, 12, 3);
+    LandmarkTable table = LandmarkTable::build(g, std::function<double(const double&)>{identity}, 8);
+
+    ASSERT_EQ(5, table.landmarkCount());
+    ASSERT_EQ(5, table.vertexCount());
+
+    std::vector<int> landmarks = table.landmarks();
+    std::sort(landmarks.begin(), landmarks.end());
+    ASSERT_EQ(landmarks.end(), std::unique(landmarks.begin(), landmarks.end()));
+}
+
+
+TEST(LandmarkTable_Tests, lowerBoundsNeverExceedTrueDistances)
+{
+    CompactDigraph<int, double> g = makeRandom(60, 200, 11);
+    LandmarkTable table = LandmarkTable::build(g, std::function<double(const double&)>{identity}, 4);
+
+    for (int s = 0; s < g.vertexCount(); s += 7)
+    {
+        ShortestPathTree tree;
+        g.findShortestPaths(g.vertexNumber(s), identity, tree);
+
+        for (int t = 0; t < g.vertexCount(); ++t)
+        {
+            // an infinite bound is only allowed when t is truly unreachable
+            ASSERT_LE(table.lowerBound(s, t), tree.distance[t] + 1e-9);
+        }
+    }
+}
+
+
+TEST(LandmarkTable_Tests, aStarWithLandmarksAgreesWithDijkstra)
+{
+    CompactDigraph<int, double> g = makeRandom(80, 320, 5);
+    LandmarkTable table = LandmarkTable::build(g, std::function<double(const double&)>{identity}, 6);
+
+    ShortestPathTree tree;
+
+    for (int s = 0; s < g.vertexCount(); s += 9)
+    {
+        for (int t = 0; t < g.vertexCount(); t += 5)
+        {
+            int start = g.vertexNumber(s);
+            int end = g.vertexNumber(t);
+
+            ShortestPath expected = g.findShortestPath(start, end, identity);
+            ShortestPath actual = g.findShortestPathAStar(start, end, identity, table.estimateTo(t), tree);
+
+            ASSERT_EQ(expected.exists(), actual.exists());
+
+            if (expected.exists())
+            {
+                ASSERT_NEAR(expected.totalCost, actual.totalCost, 1e-9);
+            }
+        }
+    }
+}
+
+
+TEST(LandmarkTable_Tests, canWriteAndReadBackIn)
+{
+    CompactDigraph<int, double> g = makeRandom(30, 90, 17);
+    LandmarkTable table = LandmarkTable::build(g, std::function<double(const double&)>{identity}, 3);
+
+    std::stringstream stream;
+    table.write(stream);
+    LandmarkTable copy = LandmarkTable::read(stream);
+
+    ASSERT_EQ(table.vertexCount(), copy.vertexCount());
+    ASSERT_EQ(table.landmarks(), copy.landmarks());
+
+    for (int s = 0; s < g.vertexCount(); ++s)
+    {
+        for (int t = 0; t < g.vertexCount(); ++t)
+        {
+            ASSERT_EQ(table.lowerBound(s, t), copy.lowerBound(s, t));
+        }
+    }
+}
+
+
+TEST(LandmarkTable_Tests, cannotReadSomethingThatIsNotATable)
+{
+    std::stringstream garbage{"this is not a landmark table at all"};
+    ASSERT_THROW({ LandmarkTable::read(garbage); }, DigraphException);
+
+    CompactDigraph<int, double> g = makeRandom(10, 20, 1);
+    std::stringstream stream;
+    LandmarkTable::build(g, std::function<double(const double&)>{identity}, 2).write(stream);
+
+    std::string bytes = stream.str();
+    std::stringstream truncated{bytes.substr(0, bytes.size() - 4)};
+    ASSERT_THROW({ LandmarkTable::read(truncated); }, DigraphException);
+}
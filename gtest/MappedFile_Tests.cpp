@@ -0,0 +1,84 @@
+// MappedFile_Tests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for MappedFile.
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <gtest/gtest.h>
+#include "MappedFile.hpp"
+
+
+namespace
+{
+    // a file that's removed again at the end of the test
+    class ScratchFile
+    {
+    public:
+        explicit ScratchFile(const std::string& contents)
+            : path_{testing::TempDir() + "MappedFile_Tests.bin"}
+        {
+            std::ofstream out{path_, std::ios::binary};
+            out << contents;
+        }
+
+        ~ScratchFile()
+        {
+            std::remove(path_.c_str());
+        }
+
+        const std::string& path() const noexcept
+        {
+            return path_;
+        }
+
+    private:
+        std::string path_;
+    };
+}
+
+
+TEST(MappedFile_Tests, mappedBytesAreTheFilesBytes)
+{
+    ScratchFile file{"Rock and Roll"};
+    MappedFile mapped{file.path()};
+
+    ASSERT_EQ(13, mapped.size());
+    ASSERT_EQ("Rock and Roll", std::string(mapped.data(), mapped.size()));
+}
+
+
+TEST(MappedFile_Tests, movingHandsOverTheMapping)
+{
+    ScratchFile file{"Traffic"};
+    MappedFile first{file.path()};
+    const char* data = first.data();
+
+    MappedFile second{std::move(first)};
+    ASSERT_EQ(data, second.data());
+    ASSERT_EQ(nullptr, first.data());
+    ASSERT_EQ(0, first.size());
+
+    first = std::move(second);
+    ASSERT_EQ(data, first.data());
+    ASSERT_EQ('T', first.data()[0]);
+}
+
+
+TEST(MappedFile_Tests, emptyFilesMapToNothing)
+{
+    ScratchFile file{""};
+    MappedFile mapped{file.path()};
+
+    ASSERT_EQ(0, mapped.size());
+}
+
+
+TEST(MappedFile_Tests, missingFilesThrow)
+{
+    ASSERT_THROW({ MappedFile{testing::TempDir() + "no/such/file"}; }, MappedFileException);
+}
@@ -0,0 +1,177 @@
+// PartitionOverlay_Tests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for MultilevelPartition and PartitionOverlay.
+
+#include <random>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "MultilevelPartition.hpp"
+#include "PartitionOverlay.hpp"
+
+
+namespace
+{
+    // each edge carries two weights, so that one overlay can be
+    // customized two different ways
+    struct TwoWeights
+    {
+        double first;
+        double second;
+    };
+
+
+    double first(const TwoWeights& weights)
+    {
+        return weights.first;
+    }
+
+
+    double second(const TwoWeights& weights)
+    {
+        return weights.second;
+    }
+
+
+    CompactDigraph<int, TwoWeights> makeRandom(int vertexCount, int edgeCount, unsigned int seed)
+    {
+        std::mt19937 random{seed};
+        std::uniform_int_distribution<int> vertices{0, vertexCount - 1};
+        std::uniform_real_distribution<double> weights{0.0, 10.0};
+
+        Digraph<int, TwoWeights> d;
+
+        for (int i = 0; i < vertexCount; ++i)
+        {
+            d.addVertex(i * 3, i);
+        }
+
+        for (int i = 0; i < edgeCount; ++i)
+        {
+            int from = vertices(random) * 3;
+            int to = vertices(random) * 3;
+
+            try
+            {
+                d.addEdge(from, to, TwoWeights{weights(random), weights(random)});
+            }
+            catch (DigraphException&)
+            {
+                // duplicate edge; just skip it
+            }
+        }
+
+        return CompactDigraph<int, TwoWeights>{d};
+    }
+
+
+    void expectSameAsDijkstra(
+        const CompactDigraph<int, TwoWeights>& g, const PartitionOverlay& overlay,
+        std::function<double(const TwoWeights&)> weight)
+    {
+        OverlayMetric metric = overlay.customize(g, weight);
+        OverlaySearch search;
+
+        for (int s = 0; s < g.vertexCount(); s += 13)
+        {
+            for (int t = 0; t < g.vertexCount(); t += 7)
+            {
+                int start = g.vertexNumber(s);
+                int end = g.vertexNumber(t);
+
+                ShortestPath expected = g.findShortestPath(start, end, weight);
+                ShortestPath actual = overlay.findShortestPath(g, metric, start, end, search);
+
+                ASSERT_EQ(expected.exists(), actual.exists());
+
+                if (!expected.exists())
+                {
+                    continue;
+                }
+
+                ASSERT_NEAR(expected.totalCost, actual.totalCost, 1e-9);
+                ASSERT_EQ(start, actual.vertices.front());
+                ASSERT_EQ(end, actual.vertices.back());
+
+                for (std::size_t i = 0; i < actual.weights.size(); ++i)
+                {
+                    ASSERT_EQ(weight(g.edgeInfo(actual.vertices[i], actual.vertices[i + 1])), actual.weights[i]);
+                }
+            }
+        }
+    }
+}
+
+
+TEST(PartitionOverlay_Tests, cellsRespectSizeLimitsAndNest)
+{
+    CompactDigraph<int, TwoWeights> g = makeRandom(200, 600, 8);
+    MultilevelPartition partition = MultilevelPartition::build(g, {8, 40});
+
+    ASSERT_EQ(2, partition.levelCount());
+    ASSERT_EQ(200, partition.vertexCount());
+
+    for (int level = 0; level < 2; ++level)
+    {
+        std::vector<int> sizes(partition.cellCount(level), 0);
+
+        for (int v = 0; v < 200; ++v)
+        {
+            ++sizes[partition.cell(level, v)];
+        }
+
+        for (int size : sizes)
+        {
+            ASSERT_GT(size, 0);
+            ASSERT_LE(size, level == 0 ? 8 : 40);
+        }
+    }
+
+    // vertices sharing a small cell always share the big one too
+    for (int v = 0; v < 200; ++v)
+    {
+        for (int w = 0; w < 200; ++w)
+        {
+            if (partition.cell(0, v) == partition.cell(0, w))
+            {
+                ASSERT_EQ(partition.cell(1, v), partition.cell(1, w));
+            }
+        }
+    }
+}
+
+
+TEST(PartitionOverlay_Tests, oneOverlayServesSeveralWeightFunctions)
+{
+    for (unsigned int seed = 1; seed <= 3; ++seed)
+    {
+        CompactDigraph<int, TwoWeights> g = makeRandom(150, 500, seed);
+        PartitionOverlay overlay = PartitionOverlay::build(g, MultilevelPartition::build(g, {6, 24, 96}));
+
+        expectSameAsDijkstra(g, overlay, first);
+        expectSameAsDijkstra(g, overlay, second);
+    }
+}
+
+
+TEST(PartitionOverlay_Tests, worksWithoutAnyLevels)
+{
+    CompactDigraph<int, TwoWeights> g = makeRandom(40, 120, 6);
+    PartitionOverlay overlay = PartitionOverlay::build(g, MultilevelPartition::build(g, {}));
+
+    expectSameAsDijkstra(g, overlay, first);
+}
+
+
+TEST(PartitionOverlay_Tests, cannotSearchBetweenNonExistentVertices)
+{
+    CompactDigraph<int, TwoWeights> g = makeRandom(10, 30, 4);
+    PartitionOverlay overlay = PartitionOverlay::build(g, MultilevelPartition::build(g, {4}));
+    OverlayMetric metric = overlay.customize(g, std::function<double(const TwoWeights&)>{first});
+    OverlaySearch search;
+
+    ASSERT_THROW({ overlay.findShortestPath(g, metric, 1, 3, search); }, DigraphException);
+}
@@ -0,0 +1,116 @@
+// SearchStats_Tests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for collecting statistics about searches.  What's expected
+// depends on whether the tests are built with DIGRAPH_SEARCH_STATS.
+
+#include <string>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+
+
+namespace
+{
+    // 1 -> 2 -> 3 -> 4, plus a longer way around from 1 to 3
+    CompactDigraph<std::string, double> makeLine()
+    {
+        Digraph<std::string, double> d;
+
+        for (int v = 1; v <= 4; ++v)
+        {
+            d.addVertex(v, "V" + std::to_string(v));
+        }
+
+        d.addEdge(1, 2, 1.0);
+        d.addEdge(2, 3, 1.0);
+        d.addEdge(3, 4, 1.0);
+        d.addEdge(1, 3, 5.0);
+
+        return CompactDigraph<std::string, double>{d};
+    }
+
+
+    double identity(const double& edgeInfo)
+    {
+        return edgeInfo;
+    }
+}
+
+
+TEST(SearchStats_Tests, heapsCountOnlyWhileCollecting)
+{
+    IndexedDaryHeap<double> heap{10};
+    SearchStats stats;
+    heap.collectStats(&stats);
+
+    heap.push(3, 3.0);
+    heap.push(4, 4.0);
+    heap.decreaseKey(4, 1.0);
+    heap.pop();
+
+    heap.collectStats(nullptr);
+    heap.pop();
+
+    if (SearchStats::enabled)
+    {
+        ASSERT_EQ(2, stats.pushes);
+        ASSERT_EQ(1, stats.decreaseKeys);
+        ASSERT_EQ(1, stats.pops);
+        ASSERT_EQ(2, stats.peakQueueSize);
+    }
+    else
+    {
+        ASSERT_EQ(nullptr, heap.stats());
+        ASSERT_EQ(0, stats.pushes);
+        ASSERT_EQ(0, stats.pops);
+    }
+}
+
+
+TEST(SearchStats_Tests, searchesCountWhatTheyDo)
+{
+    CompactDigraph<std::string, double> c = makeLine();
+    SearchStats stats;
+    ShortestPathTree tree;
+    tree.queue.collectStats(&stats);
+
+    c.findShortestPaths(1, identity, tree);
+
+    if (SearchStats::enabled)
+    {
+        ASSERT_EQ(4, stats.settled);
+        ASSERT_EQ(4, stats.relaxed);
+        ASSERT_EQ(4, stats.pushes);
+        ASSERT_EQ(4, stats.pops);
+        ASSERT_EQ(1, stats.decreaseKeys);
+        ASSERT_EQ(2, stats.peakQueueSize);
+        ASSERT_GE(stats.searchSeconds, 0.0);
+    }
+    else
+    {
+        ASSERT_EQ(0, stats.settled);
+        ASSERT_EQ(0.0, stats.totalSeconds());
+    }
+}
+
+
+TEST(SearchStats_Tests, statsAddUpKeepingTheLargestPeak)
+{
+    SearchStats a;
+    a.settled = 3;
+    a.peakQueueSize = 7;
+    a.searchSeconds = 0.5;
+
+    SearchStats b;
+    b.settled = 4;
+    b.peakQueueSize = 2;
+    b.pathSeconds = 0.25;
+
+    a += b;
+
+    ASSERT_EQ(7, a.settled);
+    ASSERT_EQ(7, a.peakQueueSize);
+    ASSERT_EQ(0.75, a.totalSeconds());
+}
@@ -0,0 +1,190 @@
+// ShortestPathRepair_Tests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for updating edges in place, and for repairing shortest path
+// trees afterward instead of searching again.
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+
+
+namespace
+{
+    // edge weights are whole numbers, so that paths that tie really do
+    // tie, no matter which order their weights are added up in
+    Digraph<std::string, double> makeRandomGraph(std::mt19937& random, int vertexCount, int edgeCount)
+    {
+        Digraph<std::string, double> d;
+
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            d.addVertex(v, "V" + std::to_string(v));
+        }
+
+        std::uniform_int_distribution<int> vertex{0, vertexCount - 1};
+        std::uniform_int_distribution<int> weight{1, 20};
+
+        while (d.edgeCount() < edgeCount)
+        {
+            int from = vertex(random);
+            int to = vertex(random);
+
+            if (from != to && d.edges(from).size() < 8)
+            {
+                try
+                {
+                    d.addEdge(from, to, weight(random));
+                }
+                catch (DigraphException&)
+                {
+                    // already there
+                }
+            }
+        }
+
+        return d;
+    }
+
+
+    double identity(const double& edgeInfo)
+    {
+        return edgeInfo;
+    }
+}
+
+
+TEST(ShortestPathRepair_Tests, updatingEdgeInfoLeavesTheEdgeInPlace)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(1, "A");
+    d.addVertex(2, "B");
+    d.addEdge(1, 2, 5.0);
+
+    d.updateEdgeInfo(1, 2, 7.0);
+
+    ASSERT_EQ(7.0, d.edgeInfo(1, 2));
+    ASSERT_EQ(1, d.edgeCount());
+    ASSERT_EQ((std::vector<std::pair<int, int>>{{1, 2}}), d.incomingEdges(2));
+    ASSERT_THROW({ d.updateEdgeInfo(2, 1, 1.0); }, DigraphException);
+    ASSERT_THROW({ d.updateEdgeInfo(1, 3, 1.0); }, DigraphException);
+}
+
+
+TEST(ShortestPathRepair_Tests, batchUpdatesChangeNothingIfAnyEdgeIsMissing)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(1, "A");
+    d.addVertex(2, "B");
+    d.addEdge(1, 2, 5.0);
+    d.addEdge(2, 1, 6.0);
+
+    ASSERT_THROW({ d.updateEdgeInfos({{1, 2, 1.0}, {1, 1, 2.0}}); }, DigraphException);
+    ASSERT_EQ(5.0, d.edgeInfo(1, 2));
+
+    d.updateEdgeInfos({{1, 2, 1.0}, {2, 1, 2.0}});
+    ASSERT_EQ(1.0, d.edgeInfo(1, 2));
+    ASSERT_EQ(2.0, d.edgeInfo(2, 1));
+}
+
+
+TEST(ShortestPathRepair_Tests, repairedTreesMatchNewSearches)
+{
+    std::mt19937 random{46};
+    Digraph<std::string, double> d = makeRandomGraph(random, 300, 1500);
+    std::vector<std::pair<int, int>> edges = d.edges();
+
+    ShortestPathTree repaired;
+    d.findShortestPaths(0, identity, repaired);
+
+    std::uniform_int_distribution<int> pick{0, static_cast<int>(edges.size()) - 1};
+    std::uniform_int_distribution<int> weight{1, 40};
+
+    for (int round = 0; round < 30; ++round)
+    {
+        // some edges get cheaper, some more expensive, many of them on
+        // the tree, since those are the ones that matter most
+        std::vector<DigraphEdgeListEntry<double>> updates;
+        std::vector<std::pair<int, int>> changed;
+
+        for (int i = 0; i < 10; ++i)
+        {
+            std::pair<int, int> edge = edges[pick(random)];
+
+            if (i % 2 == 0)
+            {
+                int to = d.indexOf(edge.second);
+
+                if (repaired.predecessor[to] != -1)
+                {
+                    edge = {d.vertexNumber(repaired.predecessor[to]), edge.second};
+                }
+            }
+
+            updates.push_back({edge.first, edge.second, static_cast<double>(weight(random))});
+            changed.push_back(edge);
+        }
+
+        d.updateEdgeInfos(updates);
+        d.repairShortestPaths(repaired, changed, identity);
+
+        ShortestPathTree fresh;
+        d.findShortestPaths(0, identity, fresh);
+
+        ASSERT_EQ(fresh.distance, repaired.distance) << "after round " << round;
+
+        // and the predecessors still describe paths of those lengths
+        for (int v = 0; v < d.indexBound(); ++v)
+        {
+            int p = repaired.predecessor[v];
+
+            if (p != -1)
+            {
+                ASSERT_EQ(
+                    repaired.distance[v],
+                    repaired.distance[p] + d.edgeInfo(d.vertexNumber(p), d.vertexNumber(v)));
+            }
+        }
+    }
+}
+
+
+TEST(ShortestPathRepair_Tests, compactDigraphsRepairFromWeightColumns)
+{
+    std::mt19937 random{1978};
+    CompactDigraph<std::string, double> c{makeRandomGraph(random, 200, 1000)};
+    EdgeWeightColumn column = EdgeWeightColumn::build(c, identity);
+    std::vector<std::pair<int, int>> edges = c.edges();
+
+    ShortestPathTree repaired;
+    c.findShortestPaths(7, column, repaired);
+
+    std::uniform_int_distribution<int> pick{0, static_cast<int>(edges.size()) - 1};
+    std::uniform_int_distribution<int> weight{1, 40};
+
+    for (int round = 0; round < 20; ++round)
+    {
+        std::vector<std::pair<int, int>> changed;
+
+        for (int i = 0; i < 25; ++i)
+        {
+            std::pair<int, int> edge = edges[pick(random)];
+            column.update(c.edgePosition(edge.first, edge.second), weight(random));
+            changed.push_back(edge);
+        }
+
+        c.repairShortestPaths(repaired, changed, column);
+
+        ShortestPathTree fresh;
+        c.findShortestPaths(7, column, fresh);
+
+        ASSERT_EQ(fresh.distance, repaired.distance) << "after round " << round;
+    }
+
+    ASSERT_THROW({ c.repairShortestPaths(repaired, {{7, 7}}, column); }, DigraphException);
+}
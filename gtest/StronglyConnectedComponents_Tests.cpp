@@ -0,0 +1,133 @@
+// StronglyConnectedComponents_Tests.cpp
+//
+// ICS 46 Winter 2019
+// Project #4: Rock and Roll Stops the Traffic
+//
+// Unit tests for the strongly connected components of Digraphs and
+// CompactDigraphs, and for isStronglyConnected(), which is built on them.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+
+
+namespace
+{
+    // two cycles, 1 -> 2 -> 3 -> 1 and 4 <-> 5, joined by a one-way road
+    // from the first to the second, plus 6 on its own
+    Digraph<std::string, int> makeTwoCycles()
+    {
+        Digraph<std::string, int> d;
+
+        for (int v = 1; v <= 6; ++v)
+        {
+            d.addVertex(v, "V" + std::to_string(v));
+        }
+
+        d.addEdge(1, 2, 0);
+        d.addEdge(2, 3, 0);
+        d.addEdge(3, 1, 0);
+        d.addEdge(3, 4, 0);
+        d.addEdge(4, 5, 0);
+        d.addEdge(5, 4, 0);
+
+        return d;
+    }
+}
+
+
+TEST(StronglyConnectedComponents_Tests, cyclesAreComponents)
+{
+    Digraph<std::string, int> d = makeTwoCycles();
+    StronglyConnectedComponents components = d.stronglyConnectedComponents();
+
+    ASSERT_EQ(3, components.count);
+    ASSERT_TRUE(components.sameComponent(d.indexOf(1), d.indexOf(3)));
+    ASSERT_TRUE(components.sameComponent(d.indexOf(4), d.indexOf(5)));
+    ASSERT_FALSE(components.sameComponent(d.indexOf(3), d.indexOf(4)));
+    ASSERT_FALSE(components.sameComponent(d.indexOf(5), d.indexOf(6)));
+}
+
+
+TEST(StronglyConnectedComponents_Tests, componentsComeInReverseTopologicalOrder)
+{
+    Digraph<std::string, int> d = makeTwoCycles();
+    StronglyConnectedComponents components = d.stronglyConnectedComponents();
+
+    ASSERT_TRUE(components.mightReach(d.indexOf(1), d.indexOf(5)));
+    ASSERT_FALSE(components.mightReach(d.indexOf(5), d.indexOf(1)));
+    ASSERT_TRUE(components.mightReach(d.indexOf(2), d.indexOf(1)));
+}
+
+
+TEST(StronglyConnectedComponents_Tests, removedVerticesHaveNoComponent)
+{
+    Digraph<std::string, int> d = makeTwoCycles();
+    int index = d.indexOf(2);
+    d.removeVertex(2);
+
+    StronglyConnectedComponents components = d.stronglyConnectedComponents();
+
+    ASSERT_EQ(-1, components.component[index]);
+    ASSERT_EQ(4, components.count);
+}
+
+
+TEST(StronglyConnectedComponents_Tests, isStronglyConnectedOnlyWhenEverythingReachesEverything)
+{
+    Digraph<std::string, int> d = makeTwoCycles();
+    ASSERT_FALSE(d.isStronglyConnected());
+
+    d.removeVertex(6);
+    d.addEdge(4, 1, 0);
+    ASSERT_TRUE(d.isStronglyConnected());
+
+    // a cycle has far fewer edges than a complete graph, but still counts
+    ASSERT_TRUE((CompactDigraph<std::string, int>{d}.isStronglyConnected()));
+
+    ASSERT_TRUE((Digraph<std::string, int>{}.isStronglyConnected()));
+}
+
+
+TEST(StronglyConnectedComponents_Tests, compactDigraphsAgree)
+{
+    Digraph<std::string, int> d = makeTwoCycles();
+    CompactDigraph<std::string, int> c{d};
+
+    StronglyConnectedComponents fromDigraph = d.stronglyConnectedComponents();
+    StronglyConnectedComponents fromCompact = c.stronglyConnectedComponents();
+
+    ASSERT_EQ(fromDigraph.count, fromCompact.count);
+
+    for (int v : d.vertices())
+    {
+        for (int w : d.vertices())
+        {
+            ASSERT_EQ(
+                fromDigraph.sameComponent(d.indexOf(v), d.indexOf(w)),
+                fromCompact.sameComponent(c.indexOf(v), c.indexOf(w)));
+        }
+    }
+}
+
+
+TEST(StronglyConnectedComponents_Tests, longPathsDoNotOverflowTheStack)
+{
+    // one long cycle, far deeper than a recursive search could go
+    const int n = 1000000;
+    StronglyConnectedComponents components;
+
+    findStronglyConnectedComponents(
+        components, n,
+        [](int)
+        {
+            return true;
+        },
+        [n](int v, auto visit)
+        {
+            visit((v + 1) % n);
+        });
+
+    ASSERT_EQ(1, components.count);
+}